@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/services/AgentAssignmentService.hpp"
+
+namespace bench {
+
+// Assignments per second with a steady backlog (each new ticket assigned,
+// the oldest open one closed), and how evenly tickets spread over the agents
+// compared with the factory's fixed agents.
+inline void runAssignmentBenchmark(BenchContext& /*ctx*/) {
+    using namespace domain;
+
+    std::printf("assignment: least-loaded agent assignment\n");
+
+    const std::size_t agentCount = 200;
+    const std::size_t backlog = 5'000;
+    const std::size_t tickets = 1'000'000;
+
+    auto registerAgents = [&](AgentAssignmentService& service) {
+        std::mt19937 rng(7);
+        for (std::size_t a = 0; a < agentCount; ++a) {
+            AgentProfile p;
+            p.id = "Agent-" + std::to_string(a);
+            p.level = static_cast<AgentLevel>(a % 10 == 0 ? 2 : a % 3 == 0 ? 0 : 1);
+            for (std::size_t c = 0; c < TicketCategoryCount; ++c)
+                if (rng() % 2 || c == a % TicketCategoryCount) p.skills.push_back(static_cast<TicketCategory>(c));
+            p.capacity = 100;
+            service.registerAgent(std::move(p));
+        }
+    };
+
+    std::vector<std::string> ids(tickets);
+    std::vector<TicketCategory> categories(tickets);
+    std::vector<Priority> priorities(tickets);
+    {
+        std::mt19937 rng(11);
+        for (std::size_t i = 0; i < tickets; ++i) {
+            ids[i] = "TKT-A" + std::to_string(i);
+            categories[i] = static_cast<TicketCategory>(rng() % TicketCategoryCount);
+            const unsigned r = rng() % 100;   // 50% LOW, 30% MEDIUM, 15% HIGH, 5% CRITICAL
+            priorities[i] = r < 50 ? Priority::LOW : r < 80 ? Priority::MEDIUM : r < 95 ? Priority::HIGH : Priority::CRITICAL;
+        }
+    }
+
+    // Agents' loads must add up to the tickets assigned and not yet released
+    auto checkLoads = [&](const AgentAssignmentService& service) {
+        const auto stats = service.getStats();
+        const std::size_t open = stats.assigned - stats.released;
+        std::size_t total = 0;
+        unsigned most = 0, least = ~0u;
+        for (const auto& l : service.getLoads()) {
+            total += l.openTickets;
+            most = std::max(most, l.openTickets);
+            least = std::min(least, l.openTickets);
+        }
+        std::printf("    %zu open tickets, per agent %u..%u\n", total, least, most);
+        if (total != open) {
+            std::printf("  FAILED: agents hold %zu open tickets, expected %zu\n", total, open);
+            std::exit(1);
+        }
+    };
+
+    {
+        AgentAssignmentService service;
+        registerAgents(service);
+        measure("assign + close oldest, 1 thread", tickets, [&](std::size_t i) {
+            service.assign(ids[i], categories[i], priorities[i]);
+            if (i >= backlog) service.statusChanged(ids[i - backlog], TicketStatus::IN_PROGRESS, TicketStatus::CLOSED);
+        });
+        checkLoads(service);
+        const auto stats = service.getStats();
+        std::printf("    assigned %llu (%llu below level), unassigned %llu, released %llu\n",
+                    static_cast<unsigned long long>(stats.assigned),
+                    static_cast<unsigned long long>(stats.fallbacks),
+                    static_cast<unsigned long long>(stats.unassigned),
+                    static_cast<unsigned long long>(stats.released));
+    }
+
+    {
+        AgentAssignmentService service;
+        registerAgents(service);
+        const unsigned threads = 4;
+        const auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (std::size_t i = t; i < tickets; i += threads) {
+                    service.assign(ids[i], categories[i], priorities[i]);
+                    if (i >= backlog * threads)
+                        service.statusChanged(ids[i - backlog * threads], TicketStatus::OPEN, TicketStatus::RESOLVED);
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        report("assign + close oldest, 4 threads", static_cast<double>(tickets), secondsSince(start));
+        checkLoads(service);
+    }
+
+    {
+        // Who holds the open backlog: fixed agents from the factory versus the service
+        std::unordered_map<std::string, std::size_t> fixed;
+        std::size_t unassigned = 0;
+        for (std::size_t i = 0; i < backlog; ++i) {
+            const std::string agent = TicketFactory::getAutoAssignedAgent(priorities[i]);
+            if (agent.empty()) ++unassigned;
+            else ++fixed[agent];
+        }
+        std::printf("  fixed agents, %zu open tickets:\n", backlog);
+        for (const auto& [agent, n] : fixed) std::printf("    %-20s %zu\n", agent.c_str(), n);
+        std::printf("    %-20s %zu\n", "(unassigned)", unassigned);
+
+        AgentAssignmentService service;
+        registerAgents(service);
+        for (std::size_t i = 0; i < backlog; ++i) service.assign(ids[i], categories[i], priorities[i]);
+        std::printf("  assignment service, %zu open tickets over %zu agents:\n", backlog, agentCount);
+        checkLoads(service);
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#include "BenchSupport.hpp"
+#include "../client/CLI.hpp"
+#include "../domain/services/SupportFacade.hpp"
+
+namespace bench {
+
+// CLI batch mode: a generated script of register / create / status / ticket
+// commands, with a few queries, run without prompts; output is discarded
+inline void runBatchBenchmark(BenchContext& ctx) {
+    std::printf("batch: CLI script commands per second\n");
+
+    const std::size_t customers = 20'000;
+    std::ostringstream script;
+    script << "# generated\n";
+    for (std::size_t i = 0; i < customers; ++i) {
+        script << "c = register \"Batch Customer " << i << "\" batch" << i << "@example.com +40711" << 100000 + i
+               << (i % 10 == 0 ? " VIP" : "") << '\n'
+               << "t = create $c " << (i % 2 ? "Medium" : "Low") << " Technical \"Printer on floor "
+               << i % 9 << " is offline again\"\n"
+               << "status $t \"In Progress\"\n"
+               << "ticket $t\n";
+        if (i % 5'000 == 0) script << "query status=open category=Technical limit=5\n";
+    }
+
+    domain::SupportFacade facade(ctx.customerService, ctx.ticketService, ctx.notifier);
+    domain::behaviors::chain::TicketValidation validation(
+        *ctx.customerService,
+        domain::behaviors::chain::ContentScanner::loadFromFile("config/content_patterns.txt").scanner);
+    client::CommandLineInterface cli(ctx.customerService, ctx.ticketService, facade, ctx.notifier, validation);
+
+    std::FILE* sink = std::fopen("/dev/null", "w");
+    if (!sink) {
+        std::printf("  FAILED: cannot open /dev/null\n");
+        std::exit(1);
+    }
+    std::istringstream in(script.str());
+    const auto summary = cli.runBatch(in, sink, {});
+    std::fclose(sink);
+
+    report("runBatch, all commands", static_cast<double>(summary.commands), summary.seconds);
+    for (const auto& [verb, stats] : summary.verbs)
+        std::printf("    %-10s %8zu commands  %zu failed, %zu throttled\n", verb.c_str(), stats.commands, stats.failed,
+                    stats.throttled);
+
+    if (summary.commands != customers * 4 + (customers + 4'999) / 5'000 ||
+        summary.verbs.at("register").failed != 0) {
+        std::printf("  FAILED: %zu commands, %zu failed\n", summary.commands, summary.failed);
+        std::exit(1);
+    }
+}
+
+} // namespace bench
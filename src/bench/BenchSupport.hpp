@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "../domain/interfaces/ILogger.hpp"
+#include "../domain/services/CustomerService.hpp"
+#include "../domain/services/NotificationService.hpp"
+#include "../domain/services/TicketService.hpp"
+#include "../domain/factory/CustomerFactory.hpp"
+#include "../domain/factory/TicketFactory.hpp"
+#include "../infrastructure/repositories/InMemoryCustomerRepository.hpp"
+#include "../infrastructure/repositories/InMemoryTicketRepository.hpp"
+
+namespace bench {
+
+class NullLogger : public domain::ILogger {
+public:
+    void log(const std::string& /*message*/) override {}
+};
+
+// Services wired like main(), but with a silent logger and no notification
+// channels so that only the code under test is measured.
+struct BenchContext {
+    std::shared_ptr<domain::ILogger> logger = std::make_shared<NullLogger>();
+
+    infrastructure::InMemoryCustomerRepository& customerRepo =
+        infrastructure::InMemoryCustomerRepository::getInstance();
+    infrastructure::InMemoryTicketRepository& ticketRepo =
+        infrastructure::InMemoryTicketRepository::getInstance();
+    domain::NotificationService& notifier =
+        domain::NotificationService::getInstance(logger);
+
+    std::shared_ptr<domain::CustomerService> customerService =
+        std::make_shared<domain::CustomerService>(
+            customerRepo, logger, std::make_unique<domain::CustomerFactory>());
+
+    std::shared_ptr<domain::TicketService> ticketService =
+        std::make_shared<domain::TicketService>(
+            ticketRepo, customerRepo, notifier, logger,
+            std::make_unique<domain::TicketFactory>());
+
+    BenchContext() {
+        ticketService->setCustomerFilter(customerService->getIdFilter());
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+inline double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+inline void report(const std::string& name, double ops, double seconds) {
+    std::printf("  %-48s %14.0f ops/s  (%.3f s)\n", name.c_str(), ops / seconds, seconds);
+}
+
+template <typename Fn>
+void measure(const std::string& name, std::size_t iterations, Fn&& fn) {
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) fn(i);
+    report(name, static_cast<double>(iterations), secondsSince(start));
+}
+
+// Keeps the optimizer from discarding benchmark results.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace bench
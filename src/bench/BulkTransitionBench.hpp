@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+
+namespace bench {
+
+inline void runBulkTransitionBenchmark(BenchContext& ctx) {
+    using domain::Ticket;
+    using domain::TicketStatus;
+
+    std::printf("bulk-transition: tickets moved per second\n");
+
+    const std::size_t customers = 1000;
+    const std::size_t ticketsPerCustomer = 200;
+
+    std::vector<std::string> ids;
+    for (std::size_t c = 0; c < customers; ++c) {
+        const std::string customerId = ctx.customerService->registerCustomer(
+            "bulk" + std::to_string(c), "bulk@example.com", "000");
+        for (std::size_t t = 0; t < ticketsPerCustomer; ++t)
+            ids.push_back(ctx.ticketService->createTicket(customerId, "Bulk bench ticket",
+                                                          domain::Priority::LOW,
+                                                          domain::TicketCategory::FEATURE_REQUEST));
+    }
+
+    auto inStatus = [](TicketStatus s) {
+        return [s](const Ticket& t) {
+            return t.getCategory() == domain::TicketCategory::FEATURE_REQUEST && t.getStatus() == s;
+        };
+    };
+
+    measure("updateTicketStatus one at a time", ids.size(), [&](std::size_t i) {
+        doNotOptimize(ctx.ticketService->updateTicketStatus(ids[i], TicketStatus::IN_PROGRESS));
+    });
+
+    auto bulk = [&](const char* name, TicketStatus from, TicketStatus to, unsigned threads) {
+        domain::BulkTransitionOptions options;
+        options.threads = threads;
+        const auto r = ctx.ticketService->transitionTickets(inStatus(from), to, options);
+        report(name, static_cast<double>(r.updated), r.seconds);
+        std::printf("    scanned=%zu updated=%zu skipped=%zu conflicts=%zu notifications=%zu log lines=%zu\n",
+                    r.scanned, r.updated, r.skipped, r.conflicts, r.notifications, r.logLines);
+    };
+
+    bulk("transitionTickets, 1 thread", TicketStatus::IN_PROGRESS, TicketStatus::RESOLVED, 1);
+    bulk("transitionTickets, all threads", TicketStatus::RESOLVED, TicketStatus::CLOSED, 0);
+}
+
+} // namespace bench
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdio>
+#include <memory>
+
+#include "BenchSupport.hpp"
+#include "ValidationBench.hpp"
+#include "../domain/behaviors/chain/ChainMetrics.hpp"
+#include "../domain/behaviors/chain/DescriptionLengthHandler.hpp"
+#include "../domain/behaviors/chain/PriorityValidationHandler.hpp"
+
+namespace bench {
+
+inline void runChainMetricsBenchmark(BenchContext& ctx) {
+    using namespace domain::behaviors::chain;
+
+    std::printf("chain-metrics: two-handler chain, requests per second\n");
+
+    const std::size_t iterations = 5'000'000;
+    const auto requests = makeValidationRequests(ctx, 4096);
+    ChainMetrics& metrics = ChainMetrics::getInstance();
+
+    auto chain = std::make_shared<DescriptionLengthHandler>(10);
+    chain->setNext(std::make_shared<PriorityValidationHandler>());
+
+    auto run = [&](const char* name) {
+        measure(name, iterations, [&](std::size_t i) {
+            auto req = requests[i % requests.size()];
+            chain->handle(req);
+            doNotOptimize(req.valid);
+        });
+    };
+
+    metrics.setEnabled(false);
+    run("metrics disabled");
+    metrics.setEnabled(true);
+    metrics.setLatencySampling(3);
+    run("metrics, latency sampled 1/8");
+    metrics.setLatencySampling(0);
+    run("metrics, latency on every call");
+    metrics.setLatencySampling(3);
+
+    const auto snapshot = metrics.snapshot();
+    for (const auto& h : snapshot.handlers) {
+        std::printf("  %-20s calls=%-10llu rejected=%-10llu p50=%.0fns p99=%.0fns\n",
+                    h.name.c_str(),
+                    static_cast<unsigned long long>(h.calls),
+                    static_cast<unsigned long long>(h.rejections),
+                    h.percentileNs(0.50), h.percentileNs(0.99));
+    }
+    for (const auto& [reason, count] : snapshot.rejectionsByReason)
+        std::printf("  %-40s %llu\n", reason.c_str(), static_cast<unsigned long long>(count));
+}
+
+} // namespace bench
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/services/ChangeFeed.hpp"
+#include "../infrastructure/repositories/ChangeCapturingTicketRepository.hpp"
+
+namespace bench {
+
+inline void runChangeFeedBenchmark(BenchContext& ctx) {
+    using domain::Priority;
+    using domain::TicketCategory;
+
+    std::printf("change-feed: captured saves and reads per second\n");
+
+    const std::size_t saves = 200'000;
+    std::vector<domain::Ticket> tickets;
+    tickets.reserve(saves);
+    for (std::size_t i = 0; i < saves; ++i) {
+        tickets.emplace_back("TKT-F" + std::to_string(i), "CUST-1", "Printer on floor 3 is jammed again",
+                             Priority::MEDIUM, TicketCategory::TECHNICAL);
+    }
+
+    measure("repository save, no capture", saves, [&](std::size_t i) {
+        ctx.ticketRepo.save(tickets[i]);
+    });
+
+    {
+        auto feed = std::make_shared<domain::ChangeFeed>();
+        infrastructure::ChangeCapturingTicketRepository repo(ctx.ticketRepo, feed);
+        measure("repository save + capture (memory)", saves, [&](std::size_t i) {
+            repo.save(tickets[i]);
+        });
+
+        std::size_t read = 0;
+        const auto start = Clock::now();
+        for (std::uint64_t next = 1;;) {
+            auto batch = feed->read(next, 1024);
+            if (batch.records.empty()) break;
+            read += batch.records.size();
+            next = batch.nextSequence;
+        }
+        report("read from offset 1, batches of 1024", static_cast<double>(read), secondsSince(start));
+    }
+
+    {
+        const auto directory = (std::filesystem::temp_directory_path() / "bench-change-feed").string();
+        std::filesystem::remove_all(directory);
+
+        domain::ChangeFeedOptions options;
+        options.directory = directory;
+        options.flushInterval = std::chrono::milliseconds(0);
+        {
+            auto feed = std::make_shared<domain::ChangeFeed>(options);
+            infrastructure::ChangeCapturingTicketRepository repo(ctx.ticketRepo, feed);
+            measure("repository save + capture (flush per record)", saves, [&](std::size_t i) {
+                repo.save(tickets[i]);
+            });
+        }
+        std::filesystem::remove_all(directory);
+
+        options.flushInterval = domain::ChangeFeedOptions().flushInterval;
+        auto feed = std::make_shared<domain::ChangeFeed>(options);
+        infrastructure::ChangeCapturingTicketRepository repo(ctx.ticketRepo, feed);
+        measure("repository save + capture (group commit)", saves, [&](std::size_t i) {
+            repo.save(tickets[i]);
+        });
+        feed->flush();
+
+        std::size_t read = 0;
+        const auto start = Clock::now();
+        for (std::uint64_t next = 1;;) {
+            auto batch = domain::ChangeFeed::readDirectory(directory, next, 65536);
+            if (batch.records.empty()) break;
+            read += batch.records.size();
+            next = batch.nextSequence;
+        }
+        report("read segment files, batches of 65536", static_cast<double>(read), secondsSince(start));
+
+        const auto stats = feed->getStats();
+        std::printf("    %zu segments, %zu bytes in memory\n", stats.segments, stats.bytes);
+        std::filesystem::remove_all(directory);
+    }
+}
+
+} // namespace bench
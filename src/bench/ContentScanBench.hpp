@@ -0,0 +1,90 @@
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/behaviors/chain/ContentScanHandler.hpp"
+
+namespace bench {
+
+// Support-ticket-like sentences with occasional card numbers and keywords.
+inline std::vector<std::string> makeDescriptionCorpus(std::size_t totalBytes, std::mt19937& rng) {
+    static const std::vector<std::string> words = {
+        "the", "printer", "on", "floor", "three", "is", "not", "working", "again", "after",
+        "update", "invoice", "for", "last", "month", "shows", "wrong", "amount", "please",
+        "refund", "my", "account", "locked", "cannot", "login", "since", "yesterday", "error",
+        "code", "when", "opening", "dashboard", "export", "fails", "with", "timeout", "we",
+        "need", "feature", "to", "filter", "reports", "by", "region", "customer", "support",
+        "ticket", "order", "delivery", "delayed", "package", "damaged", "app", "crashes",
+        "on", "startup", "android", "version", "billing", "address", "changed", "thanks",
+    };
+    std::uniform_int_distribution<std::size_t> pickWord(0, words.size() - 1);
+    std::uniform_int_distribution<int> lengthDist(15, 60);
+    std::uniform_int_distribution<int> rare(0, 99);
+
+    std::vector<std::string> corpus;
+    std::size_t bytes = 0;
+    while (bytes < totalBytes) {
+        std::string d;
+        const int n = lengthDist(rng);
+        for (int i = 0; i < n; ++i) {
+            if (i) d.push_back(' ');
+            d += words[pickWord(rng)];
+        }
+        const int r = rare(rng);
+        if (r == 0) d += " card 4111 1111 1111 1111";
+        else if (r == 1) d += " my password: hunter2";
+        else if (r == 2) d += " you are all useless morons";
+        bytes += d.size();
+        corpus.push_back(std::move(d));
+    }
+    return corpus;
+}
+
+inline void runContentScanBenchmark(BenchContext& /*ctx*/) {
+    using namespace domain::behaviors::chain;
+
+    std::printf("content-scan: description scanning throughput\n");
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> len(6, 14);
+
+    // A few real keywords plus thousands of synthetic ones
+    std::vector<std::string> keywords = {"password:", "passwd", "api key", "useless morons", "idiot"};
+    std::vector<ContentCategory> categories = {
+        ContentCategory::SECRET, ContentCategory::SECRET, ContentCategory::SECRET,
+        ContentCategory::ABUSE, ContentCategory::ABUSE};
+    while (keywords.size() < 5000) {
+        std::string k;
+        for (int i = len(rng); i > 0; --i) k.push_back(static_cast<char>(letter(rng)));
+        // Start with a rarer letter, like most real-world term lists do not
+        k[0] = "qxzjkv"[keywords.size() % 6];
+        keywords.push_back(std::move(k));
+        categories.push_back(ContentCategory::ABUSE);
+    }
+
+    const ContentScanner scanner(keywords, categories);
+    const auto corpus = makeDescriptionCorpus(64u << 20, rng);
+
+    std::size_t corpusBytes = 0;
+    for (const auto& d : corpus) corpusBytes += d.size();
+
+    for (int round = 0; round < 2; ++round) {
+        std::size_t flagged = 0;
+        auto start = Clock::now();
+        for (const auto& d : corpus) {
+            if (scanner.scan(d).categories != 0) ++flagged;
+        }
+        const double seconds = secondsSince(start);
+        std::printf("  %zu patterns, %zu states, %zu KiB: %.2f GB/s, %.0f descriptions/s, %zu flagged\n",
+                    scanner.getPatternCount(), scanner.getStateCount(),
+                    scanner.getMemoryBytes() / 1024,
+                    static_cast<double>(corpusBytes) / seconds / 1e9,
+                    static_cast<double>(corpus.size()) / seconds, flagged);
+    }
+}
+
+} // namespace bench
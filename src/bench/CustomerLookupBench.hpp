@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+
+namespace bench {
+
+inline void runCustomerLookupBenchmark(BenchContext& ctx) {
+    std::printf("customer-lookup: existence checks for unknown customer IDs\n");
+
+    for (int i = 0; i < 10000; ++i)
+        ctx.customerService->registerCustomer("lookup" + std::to_string(i), "l@example.com", "000");
+
+    std::vector<std::string> bogus;
+    for (int i = 0; i < 4096; ++i)
+        bogus.push_back("CUST-" + std::to_string(900000 + i * 7));
+
+    const std::size_t iterations = 5'000'000;
+    measure("repository findById", iterations, [&](std::size_t i) {
+        doNotOptimize(ctx.customerRepo.findById(bogus[i % bogus.size()]));
+    });
+    measure("CustomerService::getCustomer (Bloom filter)", iterations, [&](std::size_t i) {
+        doNotOptimize(ctx.customerService->getCustomer(bogus[i % bogus.size()]));
+    });
+
+    const auto stats = ctx.customerService->getIdFilterStats();
+    std::printf("  filter: %zu items, %zu bits, %zu hashes, %zu bytes, est. FP rate %.5f (configured %.5f)\n",
+                stats.insertedItems, stats.bitCount, stats.hashCount, stats.memoryBytes,
+                stats.estimatedFalsePositiveRate, stats.configuredFalsePositiveRate);
+}
+
+} // namespace bench
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/behaviors/observer/TicketEventBus.hpp"
+#include "../domain/behaviors/observer/TicketLoggingObserver.hpp"
+#include "../domain/behaviors/observer/TicketNotificationObserver.hpp"
+
+namespace bench {
+
+inline void printBusStats(const domain::behaviors::observer::TicketEventBus& bus) {
+    for (const auto& s : bus.getStats()) {
+        std::printf("    [%s] published %llu, delivered %llu in %llu batches, dropped %llu, blocked %llu, high water %zu\n",
+                    s.name.c_str(),
+                    static_cast<unsigned long long>(s.published),
+                    static_cast<unsigned long long>(s.delivered),
+                    static_cast<unsigned long long>(s.batches),
+                    static_cast<unsigned long long>(s.dropped),
+                    static_cast<unsigned long long>(s.blocked),
+                    s.highWater);
+    }
+}
+
+class CountingLogger : public domain::ILogger {
+public:
+    std::atomic<std::size_t> lines{0};
+    void log(const std::string& /*message*/) override { lines.fetch_add(1, std::memory_order_relaxed); }
+};
+
+// Publish throughput of the event bus against calling observers inline, plus
+// a check that every subscriber sees each ticket's events in publish order.
+inline void runEventBusBenchmark(BenchContext& ctx) {
+    using namespace domain::behaviors::observer;
+    using domain::TicketStatus;
+
+    std::printf("event-bus: ticket events per second\n");
+
+    const std::size_t events = 1'000'000;
+    const std::size_t tickets = 1024;
+    std::vector<std::string> ids;
+    for (std::size_t i = 0; i < tickets; ++i) ids.push_back("TKT-E" + std::to_string(i));
+
+    auto logging = std::make_shared<TicketLoggingObserver>(ctx.logger);
+
+    {
+        std::vector<std::shared_ptr<ITicketObserver>> observers = {logging, logging};
+        measure("inline dispatch, 2 observers", events, [&](std::size_t i) {
+            for (auto& o : observers)
+                o->onTicketStatusChanged(ids[i % tickets], TicketStatus::OPEN, TicketStatus::IN_PROGRESS);
+        });
+    }
+
+    {
+        TicketEventBus bus;
+        bus.subscribe(logging, {"logging-a"});
+        bus.subscribe(logging, {"logging-b"});
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < events; ++i)
+            bus.publish(TicketStatusChanged{ids[i % tickets], TicketStatus::OPEN, TicketStatus::IN_PROGRESS});
+        report("bus publish, 2 subscribers", static_cast<double>(events), secondsSince(start));
+        bus.flush();
+        report("bus publish + delivery, 2 subscribers", static_cast<double>(events), secondsSince(start));
+        printBusStats(bus);
+    }
+
+    {
+        // Delivery to the existing observers, one event per call versus
+        // adaptive batches: a bulk import followed by a bulk status change
+        for (const std::size_t maxBatch : {std::size_t{1}, std::size_t{256}}) {
+            auto counter = std::make_shared<CountingLogger>();
+            TicketEventBus bus;
+            SubscriptionOptions options;
+            options.maxBatch = maxBatch;
+            options.name = "logging";
+            bus.subscribe(std::make_shared<TicketLoggingObserver>(counter), options);
+            options.name = "notification";
+            bus.subscribe(std::make_shared<TicketNotificationObserver>(ctx.notifier, ctx.customerRepo), options);
+
+            const std::size_t imported = events / 4;
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < imported; ++i) {
+                bus.publish(TicketCreated{ids[i % tickets], "CUST-1", domain::Priority::LOW,
+                                          domain::TicketCategory::GENERAL});
+            }
+            for (std::size_t i = 0; i < imported; ++i)
+                bus.publish(TicketStatusChanged{ids[i % tickets], TicketStatus::OPEN, TicketStatus::CLOSED});
+            bus.flush();
+            report(maxBatch == 1 ? "observers, one event per call" : "observers, adaptive batches",
+                   static_cast<double>(2 * imported), secondsSince(start));
+            std::printf("    %zu log lines for %zu events\n", counter->lines.load(), 2 * imported);
+            printBusStats(bus);
+        }
+    }
+
+    {
+        // A subscriber slower than the producers: DROP keeps publish() fast
+        TicketEventBus bus;
+        SubscriptionOptions slow{"slow-drop", 1024, 1, OverflowPolicy::DROP};
+        bus.subscribe<TicketStatusChanged>([](const TicketStatusChanged&) {
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+        }, slow);
+        measure("bus publish, slow subscriber (drop)", events / 10, [&](std::size_t i) {
+            bus.publish(TicketStatusChanged{ids[i % tickets], TicketStatus::OPEN, TicketStatus::IN_PROGRESS});
+        });
+        printBusStats(bus);
+    }
+
+    {
+        // Per-ticket ordering with several producers and lanes. Each producer
+        // owns a disjoint set of tickets and publishes a running sequence per
+        // ticket in the agent field; subscribers must see it strictly increasing.
+        const unsigned producers = 4;
+        const std::size_t perProducer = 100'000;
+        std::vector<std::size_t> lastSeen(tickets, 0);
+        std::atomic<std::size_t> outOfOrder{0};
+
+        TicketEventBus bus;
+        bus.subscribe<TicketAssigned>([&](const TicketAssigned& e) {
+            const std::size_t ticket = std::stoul(e.ticketId.substr(5));
+            const std::size_t seq = std::stoul(e.agent);
+            if (seq <= lastSeen[ticket]) outOfOrder.fetch_add(1, std::memory_order_relaxed);
+            lastSeen[ticket] = seq;
+        }, {"ordered", 4096, 4, OverflowPolicy::BLOCK});
+
+        const auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                std::vector<std::size_t> seq(tickets, 0);
+                for (std::size_t i = 0; i < perProducer; ++i) {
+                    const std::size_t ticket = (i * producers + p) % tickets;
+                    bus.publish(TicketAssigned{ids[ticket], std::to_string(++seq[ticket])});
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        bus.flush();
+        report("4 producers, 4 lanes, ordered delivery", static_cast<double>(producers * perProducer),
+               secondsSince(start));
+        printBusStats(bus);
+
+        if (outOfOrder.load() != 0) {
+            std::printf("  FAILED: %zu events delivered out of order\n", outOfOrder.load());
+            std::exit(1);
+        }
+    }
+}
+
+} // namespace bench
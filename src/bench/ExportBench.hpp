@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../infrastructure/exporting/BulkExporter.hpp"
+
+namespace bench {
+
+inline void printExport(const std::string& name, const infrastructure::ExportReport& r, std::size_t expected) {
+    if (!r.ok() || r.exported != expected) {
+        std::printf("  FAILED: %s: %zu of %zu exported %s\n", name.c_str(), r.exported, expected, r.error.c_str());
+        std::exit(1);
+    }
+    report(name, static_cast<double>(r.exported), r.seconds);
+    std::printf("    %.1f MB/s, %zu files\n", static_cast<double>(r.bytes) / r.seconds / 1e6, r.files.size());
+}
+
+// Ticket export: findAll() and one ostream << per field against the paged
+// exporter in each format, to one file and split over several. The
+// baseline writes the same columns, unquoted.
+inline void runExportBenchmark(BenchContext& ctx) {
+    namespace fs = std::filesystem;
+    using namespace domain;
+    using namespace infrastructure;
+
+    std::printf("export: tickets written per second\n");
+
+    const std::string customer = ctx.customerService->registerCustomer("Export Customer", "export@example.com", "+40700000000");
+    const std::size_t batches = 100, perBatch = 2'000;
+    for (std::size_t b = 0; b < batches; ++b) {
+        std::vector<NewTicket> batch(perBatch);
+        for (std::size_t i = 0; i < perBatch; ++i) {
+            batch[i].customerId = customer;
+            batch[i].description = "Printer on floor " + std::to_string(i % 9) + " shows \"paper jam\", restarted twice";
+            batch[i].priority = static_cast<Priority>(i % 2);
+            batch[i].category = static_cast<TicketCategory>(i % TicketCategoryCount);
+            batch[i].notifyCustomer = false;
+        }
+        ctx.ticketService->createTickets(std::move(batch));
+    }
+    const std::size_t tickets = ctx.ticketRepo.findAll().size();
+
+    const fs::path dir = fs::temp_directory_path() / "support-export-bench";
+    fs::create_directories(dir);
+
+    {
+        const auto start = Clock::now();
+        std::ofstream out(dir / "baseline.txt");
+        for (const auto& t : ctx.ticketService->getAllTickets()) {
+            out << t->getId() << ',' << t->getCustomerId() << ",\"" << t->getDescription() << "\","
+                << TicketFactory::getStatusName(t->getStatus()) << ','
+                << TicketFactory::getPriorityName(t->getPriority()) << ','
+                << TicketFactory::getCategoryName(t->getCategory()) << ',' << t->getAssignedTo() << ','
+                << t->getCreatedAt() << ',';
+            const auto tags = t->getTags();
+            for (std::size_t i = 0; i < tags.size(); ++i) out << (i ? "|" : "") << tags[i];
+            out << '\n';
+        }
+        out.close();
+        report("findAll + ostream per field", static_cast<double>(tickets), secondsSince(start));
+    }
+
+    BulkExporter exporter(ctx.customerService, ctx.ticketService);
+    const unsigned parts = std::max(2u, std::thread::hardware_concurrency());
+    for (const char* file : {"tickets.csv", "tickets.jsonl", "tickets.bin"}) {
+        for (const unsigned files : {1u, parts}) {
+            ExportOptions options;
+            options.files = files;
+            printExport(std::string(file) + ", " + std::to_string(files) + (files == 1 ? " file" : " files"),
+                        exporter.exportTickets((dir / file).string(), options), tickets);
+        }
+    }
+
+    TicketFilter filter;
+    filter.category = TicketCategory::BILLING;
+    filter.tags = {"finance"};
+    const auto filtered = exporter.exportTickets((dir / "high.csv").string(), {}, filter);
+    report("tickets.csv, filtered", static_cast<double>(filtered.scanned), filtered.seconds);
+    std::printf("    %zu of %zu tickets matched\n", filtered.exported, filtered.scanned);
+
+    fs::remove_all(dir);
+}
+
+} // namespace bench
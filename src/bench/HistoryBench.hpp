@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/services/TicketHistoryService.hpp"
+
+namespace bench {
+
+inline void runHistoryBenchmark(BenchContext&) {
+    using domain::Ticket;
+    using domain::TicketStatus;
+
+    std::printf("history: record, replay and compaction\n");
+
+    const std::size_t tickets = 50'000;
+    const std::size_t cycles = 20;   // status cycles per ticket
+    const std::int64_t t0 = 1'700'000'000'000;
+
+    domain::TicketHistoryService history;
+
+    std::vector<std::string> ids;
+    for (std::size_t i = 0; i < tickets; ++i) {
+        ids.push_back("TKT-H" + std::to_string(i));
+        Ticket ticket(ids.back(), "CUST-" + std::to_string(i % 500),
+                      "Printer on floor 3 is jammed again", domain::Priority::MEDIUM,
+                      domain::TicketCategory::TECHNICAL);
+        history.recordCreated(ticket, t0);
+    }
+
+    const std::size_t eventsPerTicket = cycles * 5 + 1;
+    const auto recordStart = Clock::now();
+    for (std::size_t c = 0; c < cycles; ++c) {
+        for (std::size_t i = 0; i < tickets; ++i) {
+            const std::int64_t at = t0 + static_cast<std::int64_t>(c * 1000 + i % 997) * 1000;
+            history.recordStatusChanged(ids[i], TicketStatus::IN_PROGRESS, at);
+            history.recordAssigned(ids[i], "agent-" + std::to_string((i + c) % 40), at + 10);
+            history.recordTagAdded(ids[i], c % 2 ? "printer" : "hardware", at + 20);
+            history.recordStatusChanged(ids[i], TicketStatus::RESOLVED, at + 300);
+            history.recordStatusChanged(ids[i], c + 1 == cycles ? TicketStatus::CLOSED : TicketStatus::OPEN,
+                                        at + 600);
+        }
+    }
+    report("events recorded", static_cast<double>(tickets * cycles * 5), secondsSince(recordStart));
+
+    auto stats = history.getStats();
+    std::printf("    %zu events, %zu bytes (%.2f bytes/event), %zu snapshots\n",
+                stats.events, stats.logBytes,
+                static_cast<double>(stats.logBytes) / static_cast<double>(stats.events), stats.snapshots);
+
+    const std::int64_t midpoint = t0 + static_cast<std::int64_t>(cycles / 2) * 1000 * 1000;
+    measure("rebuildAt (mid-history)", tickets, [&](std::size_t i) {
+        doNotOptimize(history.rebuildAt(ids[i], midpoint));
+    });
+    std::printf("    each rebuild replays up to %zu of %zu events\n",
+                domain::TicketHistoryOptions{}.snapshotInterval, eventsPerTicket);
+
+    const auto compactStart = Clock::now();
+    const std::size_t saved = history.compactClosed(t0 + static_cast<std::int64_t>(cycles) * 1000 * 1000 * 10);
+    report("tickets compacted", static_cast<double>(tickets), secondsSince(compactStart));
+
+    stats = history.getStats();
+    std::printf("    saved %zu bytes; now %zu events in %zu bytes\n", saved, stats.events, stats.logBytes);
+}
+
+} // namespace bench
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/behaviors/chain/TicketValidation.hpp"
+#include "../domain/services/SupportFacade.hpp"
+#include "../infrastructure/http/HttpServer.hpp"
+#include "../infrastructure/http/SupportHttpApi.hpp"
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+// Customers and tickets for the request mix of the network benchmarks
+struct LoadData {
+    std::vector<std::string> customerIds;
+    std::vector<std::string> ticketIds;
+};
+
+inline LoadData seedLoadData(BenchContext& ctx, const std::string& name, std::size_t customers, std::size_t tickets) {
+    LoadData data;
+    for (std::size_t i = 0; i < customers; ++i) {
+        data.customerIds.push_back(ctx.customerService->registerCustomer(
+            name + " Customer " + std::to_string(i), name + std::to_string(i) + "@example.com", "+40722000000"));
+    }
+    for (std::size_t i = 0; i < tickets; ++i) {
+        data.ticketIds.push_back(ctx.ticketService->createTicket(
+            data.customerIds[i % customers], "Seeded ticket for the " + name + " benchmark", domain::Priority::MEDIUM));
+    }
+    return data;
+}
+
+// The configured validation without rate limits: the mix creates many
+// tickets per customer
+inline domain::behaviors::chain::TicketValidation makeLoadValidation(BenchContext& ctx) {
+    using namespace domain::behaviors::chain;
+    ThrottleConfig unlimited;
+    for (auto& limit : unlimited.perCustomer) limit = {1e9, 1e9};
+    return TicketValidation(*ctx.customerService,
+                            ContentScanner::loadFromFile("config/content_patterns.txt").scanner, unlimited);
+}
+
+struct LoadResult {
+    std::size_t requests = 0;
+    double seconds = 0;
+    double p50 = 0;         // microseconds
+    double p99 = 0;
+    std::size_t unexpected = 0;
+    std::string firstError;
+};
+
+inline double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) return 0;
+    const auto k = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(k), values.end());
+    return values[k];
+}
+
+// `connections` threads, each with its own Session, send `perConnection`
+// requests in bursts of `depth`. A Session provides
+//
+//   bool connected();
+//   void add(std::size_t n);   // queue request number n of the mix
+//   bool flush();              // send the queued burst
+//   int next(std::string& error);   // 1 for an expected reply, 0 for an
+//                                   // unexpected one, -1 if the connection broke
+//
+// Latency is measured per request, from sending its burst to its reply.
+template <typename MakeSession>
+LoadResult runLoad(unsigned connections, std::size_t perConnection, std::size_t depth, MakeSession makeSession) {
+    std::vector<std::vector<double>> latencies(connections);
+    std::atomic<std::size_t> unexpected{0};
+    std::string firstError;
+
+    const auto start = Clock::now();
+    std::vector<std::thread> clients;
+    for (unsigned c = 0; c < connections; ++c) {
+        clients.emplace_back([&, c] {
+            auto session = makeSession(c);
+            if (!session.connected()) {
+                unexpected += perConnection;
+                return;
+            }
+            auto& mine = latencies[c];
+            mine.reserve(perConnection);
+            std::string error;
+            for (std::size_t i = 0; i < perConnection; i += depth) {
+                const std::size_t burst = std::min(depth, perConnection - i);
+                for (std::size_t k = i; k < i + burst; ++k) session.add(k * 7 + c);
+                const auto sent = Clock::now();
+                if (!session.flush()) {
+                    unexpected += burst;
+                    return;
+                }
+                for (std::size_t k = 0; k < burst; ++k) {
+                    const int got = session.next(error);
+                    mine.push_back(secondsSince(sent) * 1e6);
+                    if (got == 1) continue;
+                    if (unexpected++ == 0) firstError = error;
+                    if (got < 0) return;
+                }
+            }
+        });
+    }
+    for (auto& t : clients) t.join();
+
+    LoadResult result;
+    result.seconds = secondsSince(start);
+    std::vector<double> all;
+    for (auto& l : latencies) all.insert(all.end(), l.begin(), l.end());
+    result.requests = all.size();
+    result.p50 = percentile(all, 0.50);
+    result.p99 = percentile(all, 0.99);
+    result.unexpected = unexpected;
+    result.firstError = firstError;
+    return result;
+}
+
+// Prints the result; exits if any reply was unexpected or missing
+inline void reportLoad(const std::string& name, const LoadResult& result, std::size_t expected) {
+    report(name, static_cast<double>(result.requests), result.seconds);
+    std::printf("    latency p50 %8.1f us   p99 %8.1f us\n", result.p50, result.p99);
+    if (result.unexpected != 0 || result.requests != expected) {
+        std::printf("  FAILED: %zu unexpected replies (first: %s)\n", result.unexpected, result.firstError.c_str());
+        std::exit(1);
+    }
+}
+
+#if defined(__linux__)
+
+// Blocking loopback client that writes a burst of requests, then reads back
+// one response per request
+class HttpLoadClient {
+private:
+    int fd = -1;
+    std::string in;
+
+    bool readMore() {
+        char buffer[64 * 1024];
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return false;
+        in.append(buffer, static_cast<std::size_t>(n));
+        return true;
+    }
+
+public:
+    explicit HttpLoadClient(std::uint16_t port) {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        const int on = 1;
+        if (fd >= 0) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+
+    ~HttpLoadClient() {
+        if (fd >= 0) ::close(fd);
+    }
+
+    HttpLoadClient(HttpLoadClient&& other) noexcept : fd(other.fd), in(std::move(other.in)) { other.fd = -1; }
+    HttpLoadClient(const HttpLoadClient&) = delete;
+    HttpLoadClient& operator=(const HttpLoadClient&) = delete;
+
+    bool connected() const { return fd >= 0; }
+
+    bool send(const std::string& requests) {
+        std::size_t sent = 0;
+        while (sent < requests.size()) {
+            const ssize_t n = ::send(fd, requests.data() + sent, requests.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            sent += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    // Status and body of the next response; status 0 if the connection broke
+    int receive(std::string& body) {
+        std::size_t headEnd;
+        while ((headEnd = in.find("\r\n\r\n")) == std::string::npos) {
+            if (!readMore()) return 0;
+        }
+        if (in.compare(0, 9, "HTTP/1.1 ") != 0) return 0;
+        const int status = std::atoi(in.c_str() + 9);
+        const auto length = in.find("Content-Length: ");
+        if (length == std::string::npos || length > headEnd) return 0;
+        const std::size_t size = std::strtoul(in.c_str() + length + 16, nullptr, 10);
+        while (in.size() < headEnd + 4 + size) {
+            if (!readMore()) return 0;
+        }
+        body.assign(in, headEnd + 4, size);
+        in.erase(0, headEnd + 4 + size);
+        return status;
+    }
+};
+
+inline std::string httpRequest(const char* method, const std::string& path, const std::string& body = "") {
+    std::string r = method;
+    r += ' ';
+    r += path;
+    r += " HTTP/1.1\r\nHost: localhost\r\n";
+    if (!body.empty()) {
+        r += "Content-Type: application/json\r\nContent-Length: ";
+        r += std::to_string(body.size());
+        r += "\r\n";
+    }
+    r += "\r\n";
+    r += body;
+    return r;
+}
+
+// The mix: GET /tickets/{id} 70%, POST /tickets 20%, PATCH /tickets/{id} 10%
+class HttpLoadSession {
+private:
+    HttpLoadClient client;
+    const LoadData& data;
+    std::string burst, body;
+    std::vector<int> expected;
+    std::size_t received = 0;
+
+public:
+    HttpLoadSession(std::uint16_t port, const LoadData& d) : client(port), data(d) {}
+
+    bool connected() const { return client.connected(); }
+
+    void add(std::size_t n) {
+        const std::string& ticket = data.ticketIds[n % data.ticketIds.size()];
+        if (n % 10 < 7) {
+            burst += httpRequest("GET", "/tickets/" + ticket);
+            expected.push_back(200);
+        } else if (n % 10 < 9) {
+            burst += httpRequest("POST", "/tickets",
+                                 "{\"customerId\":\"" + data.customerIds[n % data.customerIds.size()] +
+                                     "\",\"description\":\"Created over the network by the benchmark\","
+                                     "\"priority\":\"High\",\"category\":\"Technical\"}");
+            expected.push_back(201);
+        } else {
+            burst += httpRequest("PATCH", "/tickets/" + ticket, "{\"assignedTo\":\"Agent-" + std::to_string(n % 5) + "\"}");
+            expected.push_back(200);
+        }
+    }
+
+    bool flush() {
+        const bool sent = client.send(burst);
+        burst.clear();
+        return sent;
+    }
+
+    int next(std::string& error) {
+        const int want = expected[received++];
+        if (received == expected.size()) {
+            expected.clear();
+            received = 0;
+        }
+        const int got = client.receive(body);
+        if (got == want) return 1;
+        error = std::to_string(got) + " " + body;
+        return got == 0 ? -1 : 0;
+    }
+};
+
+// Embedded HTTP server over loopback: several keep-alive connections send
+// the request mix, first one request at a time, then pipelined 16 deep
+inline void runHttpBenchmark(BenchContext& ctx) {
+    std::printf("http: JSON API requests per second over loopback\n");
+
+    const LoadData data = seedLoadData(ctx, "Http", 1'000, 10'000);
+    domain::SupportFacade facade(ctx.customerService, ctx.ticketService, ctx.notifier);
+    const auto validation = makeLoadValidation(ctx);
+    infrastructure::SupportHttpApi api(ctx.customerService, ctx.ticketService, facade, validation);
+    infrastructure::HttpServerOptions options;
+    options.port = 0;
+    infrastructure::HttpServer server(
+        [&api](const infrastructure::HttpRequest& request) { return api.handle(request); }, options);
+    if (!server.start()) {
+        std::printf("  FAILED: %s\n", server.error().c_str());
+        std::exit(1);
+    }
+
+    const unsigned connections = 4;
+    const std::size_t perConnection = 10'000;
+    for (std::size_t depth : {1, 16}) {
+        const auto result = runLoad(connections, perConnection, depth,
+                                    [&](unsigned) { return HttpLoadSession(server.port(), data); });
+        reportLoad(std::to_string(connections) + " connections, pipeline depth " + std::to_string(depth), result,
+                   connections * perConnection);
+    }
+
+    server.stop();
+    const auto stats = server.getStats();
+    std::printf("    server: %llu requests on %llu connections\n",
+                static_cast<unsigned long long>(stats.requests),
+                static_cast<unsigned long long>(stats.connections));
+}
+
+#else
+
+inline void runHttpBenchmark(BenchContext&) {
+    std::printf("http: skipped, the HTTP server needs Linux (epoll)\n");
+}
+
+#endif
+
+} // namespace bench
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../infrastructure/importing/BulkImporter.hpp"
+
+namespace bench {
+
+inline void printImport(const std::string& name, const infrastructure::ImportReport& r) {
+    if (!r.ok()) {
+        std::printf("  FAILED: %s: %s\n", name.c_str(), r.error.c_str());
+        std::exit(1);
+    }
+    report(name, static_cast<double>(r.rows), r.seconds);
+    std::printf("    %.1f MB/s, parse %.3f s on %u threads, load %.3f s, %zu imported, %zu rejected\n",
+                static_cast<double>(r.bytes) / r.seconds / 1e6, r.parseSeconds, r.threads,
+                r.loadSeconds, r.imported, r.rejected);
+}
+
+// Bulk import of generated CSV / JSONL files against reading the same rows
+// line by line and registering them one call at a time.
+inline void runImportBenchmark(BenchContext& ctx) {
+    namespace fs = std::filesystem;
+    using namespace infrastructure;
+
+    std::printf("import: rows per second from CSV / JSONL files\n");
+
+    const std::size_t customers = 200'000;
+    const std::size_t tickets = 500'000;
+    const fs::path dir = fs::temp_directory_path() / "support-import-bench";
+    fs::create_directories(dir);
+    const std::string customersCsv = (dir / "customers.csv").string();
+    const std::string ticketsCsv = (dir / "tickets.csv").string();
+    const std::string ticketsJsonl = (dir / "tickets.jsonl").string();
+
+    {
+        std::ofstream out(customersCsv);
+        out << "id,name,email,phone,type\n";
+        for (std::size_t i = 0; i < customers; ++i) {
+            out << "CUST-" << 2'000'000 + i << ",\"Imported, Customer " << i << "\",imported" << i
+                << "@example.com,+4070" << 1'000'000 + i << ',' << (i % 7 == 0 ? "VIP" : "Regular") << '\n';
+        }
+        // a few bad rows
+        out << "CUST-BAD1,No Email,not-an-email,1,Regular\n"
+            << "CUST-BAD2,Bad Type,bad@example.com,1,Platinum\n";
+    }
+    {
+        std::ofstream csv(ticketsCsv), jsonl(ticketsJsonl);
+        csv << "id,customerId,description,status,priority,category,assignedTo,createdAt,tags\n";
+        const char* statuses[] = {"Open", "In Progress", "Resolved", "Closed"};
+        const char* priorities[] = {"Low", "Medium", "High", "Critical"};
+        const char* categories[] = {"Technical", "Billing", "General", "Complaint", "Feature Request"};
+        for (std::size_t i = 0; i < tickets; ++i) {
+            const std::string customer = "CUST-" + std::to_string(2'000'000 + i % customers);
+            csv << "TKT-" << 3'000'000 + i << ',' << customer
+                << ",\"Legacy ticket " << i << ": \"\"printer\"\" offline,\nsee attached log\","
+                << statuses[i % 4] << ',' << priorities[i % 4] << ',' << categories[i % 5]
+                << ",Agent-00" << i % 9 << ',' << 1'600'000'000 + i << ",legacy|migrated\n";
+            jsonl << "{\"id\":\"TKT-" << 4'000'000 + i << "\",\"customerId\":\"" << customer
+                  << "\",\"description\":\"Legacy ticket " << i << ": \\\"printer\\\" offline\\nsee attached log\""
+                  << ",\"status\":\"" << statuses[i % 4] << "\",\"priority\":\"" << priorities[i % 4]
+                  << "\",\"category\":\"" << categories[i % 5] << "\",\"assignedTo\":\"Agent-00" << i % 9
+                  << "\",\"createdAt\":" << 1'600'000'000 + i << ",\"tags\":[\"legacy\",\"migrated\"]}\n";
+        }
+    }
+
+    {
+        // Baseline: getline, split, one registerCustomer() per row
+        const std::size_t rows = customers / 4;
+        std::ifstream in(customersCsv);
+        std::string line;
+        std::getline(in, line);
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < rows && std::getline(in, line); ++i) {
+            std::vector<std::string> fields;
+            std::stringstream ss(line);
+            std::string field;
+            while (std::getline(ss, field, ',')) fields.push_back(field);
+            doNotOptimize(ctx.customerService->registerCustomer(fields[1], fields[3], fields[4]));
+        }
+        report("getline + registerCustomer per row", static_cast<double>(rows), secondsSince(start));
+    }
+
+    BulkImporter importer(ctx.customerService, ctx.ticketService);
+    ImportOptions options;
+    options.errorFile = (dir / "rejected.txt").string();
+
+    printImport("customers.csv, bulk import", importer.importCustomers(customersCsv, options));
+
+    for (const unsigned threads : {1u, std::max(2u, std::thread::hardware_concurrency())}) {
+        options.threads = threads;
+        const std::string suffix = ", " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        printImport("tickets.csv" + suffix, importer.importTickets(ticketsCsv, options));
+        printImport("tickets.jsonl" + suffix, importer.importTickets(ticketsJsonl, options));
+    }
+
+    const auto check = importer.importCustomers(customersCsv, options);
+    if (check.rejected != 2 || check.imported != customers) {
+        std::printf("  FAILED: expected %zu imported and 2 rejected, got %zu and %zu\n",
+                    customers, check.imported, check.rejected);
+        std::exit(1);
+    }
+    fs::remove_all(dir);
+}
+
+} // namespace bench
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/behaviors/chain/TicketValidation.hpp"
+#include "../domain/services/SupportFacade.hpp"
+
+namespace bench {
+
+// Customer + first ticket onboarding: one registerCustomerAndOpenTicket()
+// call per customer against the pipelined batch.
+inline void runOnboardingBenchmark(BenchContext& ctx) {
+    using namespace domain;
+
+    std::printf("onboarding: customers registered with their first ticket\n");
+
+    SupportFacade facade(ctx.customerService, ctx.ticketService, ctx.notifier);
+    const behaviors::chain::TicketValidation validation(*ctx.customerService, nullptr);
+    const std::size_t customers = 50'000;
+
+    std::vector<OnboardingRequest> requests(customers);
+    for (std::size_t i = 0; i < customers; ++i) {
+        auto& r = requests[i];
+        r.name = "Customer " + std::to_string(i);
+        r.email = "onboard" + std::to_string(i) + "@example.com";
+        r.phone = "+40700" + std::to_string(100000 + i);
+        r.issueDescription = "Cannot log in to the billing portal since the update";
+        r.priority = static_cast<Priority>(i % PriorityCount);
+        r.category = static_cast<TicketCategory>(i % TicketCategoryCount);
+    }
+    // Every 100th request is invalid and must leave nothing behind
+    for (std::size_t i = 0; i < customers; i += 100) requests[i].email = "no-at-sign";
+
+    measure("registerCustomerAndOpenTicket, serial", customers / 5, [&](std::size_t i) {
+        const auto& r = requests[i + 1];
+        doNotOptimize(facade.registerCustomerAndOpenTicket(r.name, r.email, r.phone, r.issueDescription,
+                                                           r.priority, r.category));
+    });
+
+    const std::size_t customersBefore = ctx.customerService->getAllCustomers().size();
+    const auto batch = facade.registerCustomersAndOpenTickets(requests, validation);
+    report("registerCustomersAndOpenTickets, pipeline", static_cast<double>(customers), batch.seconds);
+    for (const auto& stage : batch.stages) {
+        std::printf("    %-10s %8zu items  %12.0f items/s busy  (%.3f s)\n",
+                    stage.name, stage.items, stage.itemsPerSecond(), stage.busySeconds);
+    }
+    std::printf("    %zu onboarded, %zu rejected\n", batch.succeeded, batch.failed);
+
+    const std::size_t added = ctx.customerService->getAllCustomers().size() - customersBefore;
+    if (batch.failed != customers / 100 || batch.succeeded != added) {
+        std::printf("  FAILED: %zu onboarded, %zu failed, %zu customers added\n",
+                    batch.succeeded, batch.failed, added);
+        std::exit(1);
+    }
+}
+
+} // namespace bench
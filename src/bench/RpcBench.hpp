@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "BenchSupport.hpp"
+#include "HttpBench.hpp"
+#include "../client/RpcClient.hpp"
+#include "../infrastructure/rpc/RpcServer.hpp"
+#include "../infrastructure/rpc/SupportRpcApi.hpp"
+
+namespace bench {
+
+#if defined(__linux__)
+
+// The HTTP benchmark's mix as RpcProtocol requests, on one batch per burst
+class RpcLoadSession {
+private:
+    client::SupportRpcClient client;
+    client::RpcRequestBatch batch;
+    client::RpcReply reply;
+    const LoadData& data;
+
+public:
+    RpcLoadSession(const std::string& path, const LoadData& d) : data(d) { client.connect(path); }
+
+    bool connected() const { return client.isConnected(); }
+
+    void add(std::size_t n) {
+        const std::string& ticket = data.ticketIds[n % data.ticketIds.size()];
+        if (n % 10 < 7) {
+            batch.getTicket(ticket);
+        } else if (n % 10 < 9) {
+            batch.createTicket(data.customerIds[n % data.customerIds.size()],
+                               "Created over the network by the benchmark", domain::Priority::HIGH,
+                               domain::TicketCategory::TECHNICAL);
+        } else {
+            batch.assignTicket(ticket, "Agent-" + std::to_string(n % 5));
+        }
+    }
+
+    bool flush() {
+        const bool sent = client.send(batch) != 0;
+        batch.clear();
+        return sent;
+    }
+
+    int next(std::string& error) {
+        if (!client.receive(reply)) {
+            error = client.error();
+            return -1;
+        }
+        if (reply.ok()) return 1;
+        error = reply.error();
+        return 0;
+    }
+};
+
+// The binary protocol over a Unix domain socket against the JSON API over
+// loopback TCP, with the same services, request mix and connections
+inline void runRpcBenchmark(BenchContext& ctx) {
+    std::printf("rpc: binary protocol (Unix socket) vs JSON over HTTP, requests per second\n");
+
+    const LoadData data = seedLoadData(ctx, "Rpc", 1'000, 10'000);
+    domain::SupportFacade facade(ctx.customerService, ctx.ticketService, ctx.notifier);
+    const auto validation = makeLoadValidation(ctx);
+
+    infrastructure::SupportHttpApi httpApi(ctx.customerService, ctx.ticketService, facade, validation);
+    infrastructure::HttpServerOptions httpOptions;
+    httpOptions.port = 0;
+    infrastructure::HttpServer http(
+        [&httpApi](const infrastructure::HttpRequest& request) { return httpApi.handle(request); }, httpOptions);
+
+    infrastructure::SupportRpcApi rpcApi(ctx.customerService, ctx.ticketService, validation);
+    infrastructure::RpcServerOptions rpcOptions;
+    rpcOptions.path = "/tmp/support-bench-" + std::to_string(::getpid()) + ".sock";
+    infrastructure::RpcServer rpc(
+        [&rpcApi](infrastructure::RpcOperation op, const char* p, const char* end, std::string& out) {
+            return rpcApi.handle(op, p, end, out);
+        },
+        rpcOptions);
+
+    if (!http.start() || !rpc.start()) {
+        std::printf("  FAILED: %s%s\n", http.error().c_str(), rpc.error().c_str());
+        std::exit(1);
+    }
+
+    const unsigned connections = 4;
+    const std::size_t perConnection = 20'000;
+    const std::size_t expected = connections * perConnection;
+    for (std::size_t depth : {1, 16, 64}) {
+        const auto overHttp = runLoad(connections, perConnection, depth,
+                                      [&](unsigned) { return HttpLoadSession(http.port(), data); });
+        const auto overRpc = runLoad(connections, perConnection, depth,
+                                     [&](unsigned) { return RpcLoadSession(rpcOptions.path, data); });
+        const std::string setup = ", depth " + std::to_string(depth);
+        reportLoad("HTTP/JSON, TCP loopback" + setup, overHttp, expected);
+        reportLoad("binary, Unix socket" + setup, overRpc, expected);
+        std::printf("    binary / HTTP: %.2fx\n",
+                    (static_cast<double>(overRpc.requests) / overRpc.seconds) /
+                        (static_cast<double>(overHttp.requests) / overHttp.seconds));
+    }
+
+    rpc.stop();
+    http.stop();
+}
+
+#else
+
+inline void runRpcBenchmark(BenchContext&) {
+    std::printf("rpc: skipped, the servers need Linux (epoll)\n");
+}
+
+#endif
+
+} // namespace bench
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/services/SlaScheduler.hpp"
+#include "../domain/util/TimingWheel.hpp"
+
+namespace bench {
+
+inline void runSlaBenchmark(BenchContext&) {
+    using domain::Priority;
+    using domain::TicketStatus;
+    using Clock = domain::SlaScheduler::Clock;
+
+    std::printf("sla: timer operations per second\n");
+
+    const std::size_t timers = 1'000'000;
+    std::vector<std::uint64_t> due(timers);
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (auto& d : due) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        d = x % (7 * 24 * 3600);   // within a week, in seconds
+    }
+
+    {
+        domain::TimingWheel<std::uint32_t> wheel;
+        std::vector<domain::TimingWheel<std::uint32_t>::TimerId> ids(timers);
+        measure("timing wheel: schedule", timers, [&](std::size_t i) {
+            ids[i] = wheel.schedule(due[i], static_cast<std::uint32_t>(i));
+        });
+        measure("timing wheel: cancel", timers / 2, [&](std::size_t i) {
+            doNotOptimize(wheel.cancel(ids[i * 2]));
+        });
+        std::size_t fired = 0;
+        const auto start = Clock::now();
+        wheel.advanceTo(7 * 24 * 3600, [&](std::uint32_t, std::uint64_t) { ++fired; });
+        report("timing wheel: advance one week (fired timers)", static_cast<double>(fired),
+               std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    {
+        std::multimap<std::uint64_t, std::uint32_t> ordered;
+        std::vector<std::multimap<std::uint64_t, std::uint32_t>::iterator> its(timers);
+        measure("std::multimap: schedule", timers, [&](std::size_t i) {
+            its[i] = ordered.emplace(due[i], static_cast<std::uint32_t>(i));
+        });
+        measure("std::multimap: cancel", timers / 2, [&](std::size_t i) {
+            ordered.erase(its[i * 2]);
+        });
+    }
+
+    {
+        const auto t0 = Clock::time_point(std::chrono::seconds(1'700'000'000));
+        domain::SlaScheduler scheduler(domain::SlaPolicy{}, t0);
+        std::size_t breaches = 0;
+        scheduler.setBreachHandler([&](const domain::SlaBreach&) { ++breaches; });
+
+        std::vector<std::string> ids;
+        for (std::size_t i = 0; i < timers; ++i) ids.push_back("TKT-S" + std::to_string(i));
+
+        measure("SlaScheduler: track on creation", timers, [&](std::size_t i) {
+            scheduler.track(ids[i], TicketStatus::OPEN, static_cast<Priority>(i % 4), t0);
+        });
+        measure("SlaScheduler: re-track on status change", timers / 2, [&](std::size_t i) {
+            scheduler.track(ids[i * 2], TicketStatus::IN_PROGRESS, static_cast<Priority>(i % 4), t0);
+        });
+
+        const auto start = Clock::now();
+        scheduler.advanceTo(t0 + std::chrono::hours(24 * 8));
+        report("SlaScheduler: breaches delivered", static_cast<double>(breaches),
+               std::chrono::duration<double>(Clock::now() - start).count());
+    }
+}
+
+} // namespace bench
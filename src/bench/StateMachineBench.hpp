@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/behaviors/state/TicketStates.hpp"
+
+namespace bench {
+
+// The state machine as it was before the transition table: one heap-allocated
+// state object per transition, held by a shared_ptr per ticket.
+namespace legacy_state {
+
+using domain::TicketStatus;
+
+class Machine;
+
+class State {
+public:
+    virtual ~State() = default;
+    virtual TicketStatus getStatus() const = 0;
+    virtual void startProgress(Machine&) {}
+    virtual void resolve(Machine&) {}
+    virtual void close(Machine&) {}
+    virtual void reopen(Machine&) {}
+};
+
+class Machine {
+private:
+    std::shared_ptr<State> current;
+
+public:
+    explicit Machine(std::shared_ptr<State> initial) : current(std::move(initial)) {}
+    TicketStatus getStatus() const { return current->getStatus(); }
+    void setState(std::shared_ptr<State> s) { current = std::move(s); }
+    void startProgress() { current->startProgress(*this); }
+    void resolve()       { current->resolve(*this); }
+    void close()         { current->close(*this); }
+    void reopen()        { current->reopen(*this); }
+};
+
+class Open : public State {
+public:
+    TicketStatus getStatus() const override { return TicketStatus::OPEN; }
+    void startProgress(Machine& m) override;
+};
+
+class InProgress : public State {
+public:
+    TicketStatus getStatus() const override { return TicketStatus::IN_PROGRESS; }
+    void resolve(Machine& m) override;
+    void close(Machine& m) override;
+};
+
+class Resolved : public State {
+public:
+    TicketStatus getStatus() const override { return TicketStatus::RESOLVED; }
+    void close(Machine& m) override;
+    void reopen(Machine& m) override;
+};
+
+class Closed : public State {
+public:
+    TicketStatus getStatus() const override { return TicketStatus::CLOSED; }
+    void reopen(Machine& m) override;
+};
+
+inline void Open::startProgress(Machine& m)  { m.setState(std::make_shared<InProgress>()); }
+inline void InProgress::resolve(Machine& m)  { m.setState(std::make_shared<Resolved>()); }
+inline void InProgress::close(Machine& m)    { m.setState(std::make_shared<Closed>()); }
+inline void Resolved::close(Machine& m)      { m.setState(std::make_shared<Closed>()); }
+inline void Resolved::reopen(Machine& m)     { m.setState(std::make_shared<Open>()); }
+inline void Closed::reopen(Machine& m)       { m.setState(std::make_shared<Open>()); }
+
+} // namespace legacy_state
+
+template <typename Machine>
+inline void fire(Machine& m, domain::behaviors::state::TicketEvent event) {
+    using domain::behaviors::state::TicketEvent;
+    switch (event) {
+        case TicketEvent::START_PROGRESS: m.startProgress(); break;
+        case TicketEvent::RESOLVE:        m.resolve(); break;
+        case TicketEvent::CLOSE:          m.close(); break;
+        case TicketEvent::REOPEN:         m.reopen(); break;
+    }
+}
+
+inline void runStateMachineBenchmark(BenchContext&) {
+    using namespace domain::behaviors::state;
+
+    std::printf("state-machine: events applied per second over 1M tickets\n");
+
+    const std::size_t tickets = 1'000'000;
+    const std::size_t events = 16'000'000;
+
+    // Random events on random tickets; about 40% of them change the status.
+    std::vector<std::uint32_t> target(events);
+    std::vector<TicketEvent> kind(events);
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (std::size_t i = 0; i < events; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        target[i] = static_cast<std::uint32_t>(x % tickets);
+        kind[i] = static_cast<TicketEvent>((x >> 32) % TicketEventCount);
+    }
+
+    {
+        std::vector<legacy_state::Machine> machines;
+        machines.reserve(tickets);
+        for (std::size_t i = 0; i < tickets; ++i)
+            machines.emplace_back(std::make_shared<legacy_state::Open>());
+
+        measure("shared_ptr state per ticket", events, [&](std::size_t i) {
+            fire(machines[target[i]], kind[i]);
+        });
+        doNotOptimize(machines[tickets / 2].getStatus());
+    }
+
+    {
+        std::vector<TicketStateMachine> machines(tickets, TicketStateMachine(domain::TicketStatus::OPEN));
+
+        measure("transition table", events, [&](std::size_t i) {
+            machines[target[i]].apply(kind[i]);
+        });
+        doNotOptimize(machines[tickets / 2].getStatus());
+
+        measure("flyweight ITicketState objects", events, [&](std::size_t i) {
+            TicketStateMachine& m = machines[target[i]];
+            ITicketState& state = m.getState();
+            switch (kind[i]) {
+                case TicketEvent::START_PROGRESS: state.startProgress(m); break;
+                case TicketEvent::RESOLVE:        state.resolve(m); break;
+                case TicketEvent::CLOSE:          state.close(m); break;
+                case TicketEvent::REOPEN:         state.reopen(m); break;
+            }
+        });
+        doNotOptimize(machines[tickets / 2].getStatus());
+    }
+
+    std::printf("  bytes per ticket: shared_ptr %zu (+ state object), table %zu\n",
+                sizeof(legacy_state::Machine), sizeof(TicketStateMachine));
+}
+
+} // namespace bench
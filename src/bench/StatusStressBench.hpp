@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/behaviors/state/TicketTransitions.hpp"
+
+namespace bench {
+
+// Many agents moving the same few tickets at once. Every UPDATED result is
+// counted per (ticket, from, to); afterwards the counts must be legal
+// transitions only and must form an unbroken path from OPEN to the ticket's
+// final status (no update lost or applied twice).
+inline void runStatusStressTest(BenchContext& ctx) {
+    using domain::StatusUpdateResult;
+    using domain::TicketStatus;
+    using domain::TicketStatusCount;
+
+    const unsigned threads = 8;
+    const std::size_t ticketCount = 16;
+    const std::size_t attemptsPerThread = 200'000;
+
+    std::printf("status-stress: %u threads, %zu shared tickets\n", threads, ticketCount);
+
+    const std::string customerId =
+        ctx.customerService->registerCustomer("stress", "stress@example.com", "000");
+    std::vector<std::string> ids;
+    for (std::size_t i = 0; i < ticketCount; ++i)
+        ids.push_back(ctx.ticketService->createTicket(customerId, "Stress test ticket",
+                                                      domain::Priority::LOW));
+
+    using TransitionCounts =
+        std::array<std::array<std::atomic<std::uint64_t>, TicketStatusCount>, TicketStatusCount>;
+    std::vector<TransitionCounts> applied(ticketCount);
+    std::array<std::atomic<std::uint64_t>, 4> results{};
+
+    auto agent = [&](unsigned seed) {
+        std::uint64_t x = 0x9E3779B97F4A7C15ull * (seed + 1);
+        for (std::size_t i = 0; i < attemptsPerThread; ++i) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            const std::size_t t = x % ticketCount;
+            const auto from = static_cast<TicketStatus>((x >> 16) % TicketStatusCount);
+            const auto to = static_cast<TicketStatus>((x >> 24) % TicketStatusCount);
+
+            const StatusUpdateResult r = ctx.ticketService->updateTicketStatus(ids[t], from, to);
+            results[static_cast<std::size_t>(r)].fetch_add(1, std::memory_order_relaxed);
+            if (r == StatusUpdateResult::UPDATED) {
+                applied[t][static_cast<std::size_t>(from)][static_cast<std::size_t>(to)]
+                    .fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    const auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; ++i) workers.emplace_back(agent, i);
+    for (auto& w : workers) w.join();
+    report("updateTicketStatus attempts", static_cast<double>(threads * attemptsPerThread),
+           secondsSince(start));
+
+    std::printf("  updated=%llu illegal=%llu conflict=%llu not_found=%llu\n",
+                static_cast<unsigned long long>(results[0].load()),
+                static_cast<unsigned long long>(results[2].load()),
+                static_cast<unsigned long long>(results[3].load()),
+                static_cast<unsigned long long>(results[1].load()));
+
+    bool ok = results[1].load() == 0;
+    for (std::size_t t = 0; t < ticketCount; ++t) {
+        const TicketStatus final = ctx.ticketRepo.findById(ids[t])->getStatus();
+        for (std::size_t s = 0; s < TicketStatusCount; ++s) {
+            long long balance = 0;
+            for (std::size_t o = 0; o < TicketStatusCount; ++o) {
+                const auto in = applied[t][o][s].load();
+                const auto out = applied[t][s][o].load();
+                if (out > 0 && !domain::behaviors::state::canTransition(
+                        static_cast<TicketStatus>(s), static_cast<TicketStatus>(o))) ok = false;
+                balance += static_cast<long long>(in) - static_cast<long long>(out);
+            }
+            const long long expected = (s == static_cast<std::size_t>(final) ? 1 : 0) -
+                                       (s == static_cast<std::size_t>(TicketStatus::OPEN) ? 1 : 0);
+            if (balance != expected) ok = false;
+        }
+    }
+
+    std::printf("  transition history consistent: %s\n", ok ? "yes" : "NO");
+    if (!ok) std::exit(1);
+}
+
+} // namespace bench
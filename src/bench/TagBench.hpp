@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/models/Tags.hpp"
+#include "../domain/util/TagIndex.hpp"
+
+namespace bench {
+
+inline void runTagBenchmark(BenchContext& ctx) {
+    using domain::Priority;
+    using domain::TicketCategory;
+
+    std::printf("tags: \"urgent AND finance\" queries per second\n");
+
+    // Tickets with the factory's default tags plus a few random extra ones
+    const std::size_t tickets = 200'000;
+    const TicketCategory categories[] = {TicketCategory::TECHNICAL, TicketCategory::BILLING,
+                                         TicketCategory::COMPLAINT, TicketCategory::GENERAL};
+    domain::TicketFactory factory;
+    std::uint64_t x = 0x9E3779B97F4A7C15ull;
+    std::vector<std::vector<std::string>> names(tickets);   // the vector-of-strings model
+    for (std::size_t i = 0; i < tickets; ++i) {
+        auto ticket = factory.createTicket("TKT-T" + std::to_string(i), "CUST-1", "Tag bench ticket",
+                                           Priority::LOW, categories[i % 4]);
+        for (int k = 0; k < 2; ++k) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            const auto tag = x % 3 == 0 ? std::string(x % 2 ? "finance" : "urgent")
+                                        : "topic-" + std::to_string(x % 100);
+            ticket->addTag(tag);
+        }
+        names[i] = ticket->getTags();
+        ctx.ticketRepo.store(std::move(ticket));
+    }
+
+    const std::vector<std::string> query = {"urgent", "finance"};
+    std::size_t expected = 0;
+    for (const auto& t : names) {
+        if (std::find(t.begin(), t.end(), "urgent") != t.end() &&
+            std::find(t.begin(), t.end(), "finance") != t.end()) {
+            ++expected;
+        }
+    }
+    std::printf("  %zu of %zu bench tickets match\n", expected, tickets);
+
+    const std::size_t queries = 20;
+    measure("scan, vector<string> tags", queries, [&](std::size_t) {
+        std::size_t n = 0;
+        for (const auto& t : names) {
+            if (std::all_of(query.begin(), query.end(), [&](const std::string& q) {
+                    return std::find(t.begin(), t.end(), q) != t.end();
+                })) {
+                ++n;
+            }
+        }
+        doNotOptimize(n);
+    });
+
+    const auto all = ctx.ticketRepo.findAll();
+    domain::TagSet required;
+    for (const auto& q : query) required.add(domain::TagDictionary::getInstance().intern(q));
+    measure("scan, Ticket::hasAllTags", queries, [&](std::size_t) {
+        std::size_t n = 0;
+        for (const auto& t : all) n += t->hasAllTags(required);
+        doNotOptimize(n);
+    });
+
+    std::size_t found = 0;
+    measure("TicketService::findTicketsByTags (bitmap index)", queries, [&](std::size_t) {
+        found = ctx.ticketService->findTicketsByTags(query).size();
+    });
+    std::printf("    index returned %zu tickets over %zu stored\n", found, all.size());
+    if (found < expected) {
+        std::printf("  FAILED: index missed tickets\n");
+        std::exit(1);
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/behaviors/chain/ThrottleHandler.hpp"
+
+namespace bench {
+
+inline void runThrottleBenchmark(BenchContext& /*ctx*/) {
+    using namespace domain::behaviors::chain;
+
+    std::printf("throttle: token-bucket checks, one looping integration among normal traffic\n");
+
+    std::vector<std::string> customers;
+    for (int i = 0; i < 10000; ++i) customers.push_back("CUST-" + std::to_string(100000 + i));
+
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        CustomerThrottle throttle;
+        const std::size_t perThread = 1'000'000;
+
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (std::size_t i = 0; i < perThread; ++i) {
+                    // Half the traffic is one runaway customer
+                    const std::string& id = (i & 1) ? customers[0] : customers[(i * 7 + t) % customers.size()];
+                    const auto type = static_cast<domain::CustomerType>(i % domain::CustomerTypeCount);
+                    doNotOptimize(throttle.tryAcquire(id, type));
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        report(std::to_string(threads) + " thread(s)", static_cast<double>(perThread) * threads,
+               secondsSince(start));
+
+        const auto stats = throttle.getStats();
+        std::uint64_t allowed = 0, rejected = 0;
+        for (std::size_t i = 0; i < domain::CustomerTypeCount; ++i) {
+            allowed += stats.allowed[i];
+            rejected += stats.rejectedByCustomerLimit[i] + stats.rejectedByTypeLimit[i];
+        }
+        std::printf("    allowed %llu, rejected %llu, tracked customers %zu\n",
+                    static_cast<unsigned long long>(allowed),
+                    static_cast<unsigned long long>(rejected), stats.trackedCustomers);
+    }
+}
+
+} // namespace bench
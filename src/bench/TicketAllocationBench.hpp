@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/builder/TicketBuilder.hpp"
+#include "../domain/factory/TicketFactory.hpp"
+#include "../domain/util/Arena.hpp"
+
+// Heap allocations made by the current thread. The bench is a single
+// translation unit, so replacing the global operators here counts every
+// allocation in the program.
+namespace bench {
+inline thread_local std::size_t heapAllocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++bench::heapAllocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// GCC sees malloc() behind new and free() behind delete once inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace bench {
+
+inline void runTicketAllocationBenchmark(BenchContext& ctx) {
+    using domain::Priority;
+    using domain::TicketCategory;
+
+    std::printf("ticket-alloc: heap allocations and tickets per second\n");
+
+    const std::size_t tickets = 200'000;
+    const std::string description = "The invoice for March lists the premium plan twice";
+
+    auto run = [&](const char* name, auto&& createOne) {
+        const std::size_t before = heapAllocations;
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < tickets; ++i) createOne(i);
+        const double seconds = secondsSince(start);
+        report(name, static_cast<double>(tickets), seconds);
+        std::printf("    %.2f heap allocations per ticket\n",
+                    static_cast<double>(heapAllocations - before) / tickets);
+    };
+
+    auto idFor = [](std::size_t i) { return "TKT-A" + std::to_string(i); };
+
+    // The copying path: const& builder setters, a fresh default-tag vector,
+    // copying build() and a repository save() that copies the ticket again
+    run("copying builder + save()", [&](std::size_t i) {
+        const std::string id = idFor(i);
+        const std::string customerId = "CUST-1";
+        domain::TicketBuilder builder;
+        builder.withId(id).withCustomerId(customerId).withDescription(description)
+               .withPriority(Priority::HIGH).withCategory(TicketCategory::TECHNICAL)
+               .withAssignedTo(domain::TicketFactory::getAutoAssignedAgent(Priority::HIGH));
+        const std::vector<std::string> tags = domain::TicketFactory::getDefaultTags(TicketCategory::TECHNICAL);
+        for (const auto& tag : tags) builder.addTag(tag);
+        auto ticket = builder.build();
+        ctx.ticketRepo.save(*ticket);
+    });
+
+    domain::TicketFactory factory;
+    run("moving factory + store()", [&](std::size_t i) {
+        ctx.ticketRepo.store(factory.createTicket(idFor(i), "CUST-1", description,
+                                                  Priority::HIGH, TicketCategory::TECHNICAL));
+    });
+
+    {
+        domain::Arena arena(tickets * (sizeof(domain::Ticket) + 64));
+        run("moving factory + store(), arena", [&](std::size_t i) {
+            ctx.ticketRepo.store(factory.createTicket(idFor(i), "CUST-1", description,
+                                                      Priority::HIGH, TicketCategory::TECHNICAL, &arena));
+        });
+    }
+
+    // End to end through the service, one at a time and as one batch
+    const std::string customerId = ctx.customerService->registerCustomer("alloc", "alloc@example.com", "000");
+    run("TicketService::createTicket", [&](std::size_t) {
+        doNotOptimize(ctx.ticketService->createTicket(customerId, description, Priority::HIGH,
+                                                      TicketCategory::TECHNICAL));
+    });
+
+    std::vector<domain::NewTicket> batch(tickets, domain::NewTicket{customerId, description, Priority::HIGH,
+                                                                    TicketCategory::TECHNICAL});
+    const std::size_t before = heapAllocations;
+    const auto start = Clock::now();
+    const auto ids = ctx.ticketService->createTickets(std::move(batch));
+    report("TicketService::createTickets (one arena)", static_cast<double>(ids.size()), secondsSince(start));
+    std::printf("    %.2f heap allocations per ticket\n",
+                static_cast<double>(heapAllocations - before) / tickets);
+}
+
+} // namespace bench
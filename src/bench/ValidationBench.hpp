@@ -0,0 +1,103 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/behaviors/chain/CustomerExistsHandler.hpp"
+#include "../domain/behaviors/chain/DescriptionLengthHandler.hpp"
+#include "../domain/behaviors/chain/PriorityValidationHandler.hpp"
+#include "../domain/behaviors/chain/ValidationPipeline.hpp"
+#include "../domain/behaviors/chain/ValidationRuleEngine.hpp"
+
+namespace bench {
+
+inline std::vector<domain::behaviors::chain::TicketCreationRequest>
+makeValidationRequests(BenchContext& ctx, std::size_t count) {
+    using domain::behaviors::chain::TicketCreationRequest;
+
+    std::vector<std::string> ids;
+    for (int i = 0; i < 64; ++i)
+        ids.push_back(ctx.customerService->registerCustomer(
+            "bench" + std::to_string(i), "bench@example.com", "000"));
+
+    std::vector<TicketCreationRequest> requests;
+    requests.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        TicketCreationRequest req;
+        // Every 8th request targets an unknown customer, every 5th is CRITICAL.
+        req.customerId = (i % 8 == 0) ? "CUST-UNKNOWN-" + std::to_string(i) : ids[i % ids.size()];
+        req.description = (i % 3 == 0) ? "short" : "Printer on floor 3 is jammed again";
+        req.priority = (i % 5 == 0) ? domain::Priority::CRITICAL : domain::Priority::MEDIUM;
+        req.category = domain::TicketCategory::TECHNICAL;
+        requests.push_back(std::move(req));
+    }
+    return requests;
+}
+
+inline void runValidationBenchmark(BenchContext& ctx) {
+    using namespace domain::behaviors::chain;
+
+    std::printf("validation: requests validated per second\n");
+
+    const std::size_t iterations = 2'000'000;
+    const auto requests = makeValidationRequests(ctx, 4096);
+
+    measure("shared_ptr chain built per request", iterations, [&](std::size_t i) {
+        auto req = requests[i % requests.size()];
+        auto customerHandler = std::make_shared<CustomerExistsHandler>(*ctx.customerService);
+        auto lengthHandler   = std::make_shared<DescriptionLengthHandler>(10);
+        auto priorityHandler = std::make_shared<PriorityValidationHandler>();
+        customerHandler->setNext(lengthHandler);
+        lengthHandler->setNext(priorityHandler);
+        customerHandler->handle(req);
+        doNotOptimize(req.valid);
+    });
+
+    auto customerHandler = std::make_shared<CustomerExistsHandler>(*ctx.customerService);
+    auto lengthHandler   = std::make_shared<DescriptionLengthHandler>(10);
+    auto priorityHandler = std::make_shared<PriorityValidationHandler>();
+    customerHandler->setNext(lengthHandler);
+    lengthHandler->setNext(priorityHandler);
+
+    measure("shared_ptr chain reused", iterations, [&](std::size_t i) {
+        auto req = requests[i % requests.size()];
+        customerHandler->handle(req);
+        doNotOptimize(req.valid);
+    });
+
+    const auto pipeline = makeDefaultValidationPipeline(*ctx.customerService);
+    measure("compile-time ValidationPipeline", iterations, [&](std::size_t i) {
+        auto req = requests[i % requests.size()];
+        doNotOptimize(pipeline.validate(req));
+    });
+
+    ValidationRuleEngine engine;
+    ThrottleConfig unlimited;
+    for (auto& limit : unlimited.perCustomer) limit = {1e9, 1e9};
+    CustomerThrottle throttle(unlimited);
+    const auto configured = makeConfiguredValidationPipeline(
+        *ctx.customerService, throttle, engine,
+        ContentScanner::loadFromFile("config/content_patterns.txt").scanner);
+    measure("configured ValidationPipeline (all stages)", iterations, [&](std::size_t i) {
+        auto req = requests[i % requests.size()];
+        doNotOptimize(configured.validate(req));
+    });
+
+    // Rules only, without the customer lookup
+    auto rulesChain = std::make_shared<DescriptionLengthHandler>(10);
+    rulesChain->setNext(std::make_shared<PriorityValidationHandler>());
+    measure("rules only: virtual handler chain", iterations, [&](std::size_t i) {
+        auto req = requests[i % requests.size()];
+        rulesChain->handle(req);
+        doNotOptimize(req.valid);
+    });
+    measure("rules only: rule engine decision table", iterations, [&](std::size_t i) {
+        auto req = requests[i % requests.size()];
+        engine.check(req);
+        doNotOptimize(req.valid);
+    });
+}
+
+} // namespace bench
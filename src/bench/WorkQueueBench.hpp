@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "../domain/services/WorkQueueService.hpp"
+
+namespace bench {
+
+// nextTicket() from per-agent heaps against scanning every ticket for the
+// agent's most urgent OPEN one, plus a check that claims come out in
+// priority order.
+inline void runWorkQueueBenchmark(BenchContext& ctx) {
+    using namespace domain;
+
+    std::printf("work-queue: claiming the next ticket\n");
+
+    const std::size_t agents = 100;
+    const std::size_t tickets = 200'000;
+
+    std::vector<std::string> ids(tickets), owners(tickets);
+    std::vector<Priority> priorities(tickets);
+    std::vector<TicketCategory> categories(tickets);
+    {
+        std::mt19937 rng(5);
+        for (std::size_t i = 0; i < tickets; ++i) {
+            ids[i] = "TKT-Q" + std::to_string(i);
+            owners[i] = rng() % 4 == 0 ? std::string() : "Agent-" + std::to_string(rng() % agents);
+            priorities[i] = static_cast<Priority>(rng() % PriorityCount);
+            categories[i] = static_cast<TicketCategory>(rng() % TicketCategoryCount);
+        }
+    }
+
+    {
+        WorkQueueService queues;
+        const auto base = WorkQueueService::Clock::now();
+        measure("enqueue", tickets, [&](std::size_t i) {
+            queues.enqueue(ids[i], owners[i], categories[i], priorities[i], base + std::chrono::seconds(i));
+        });
+        measure("reprioritize (decrease-key)", tickets / 10, [&](std::size_t i) {
+            queues.reprioritize(ids[i * 10], Priority::CRITICAL);
+        });
+        measure("reassign", tickets / 10, [&](std::size_t i) {
+            queues.reassign(ids[i * 10 + 1], "Agent-" + std::to_string(i % agents));
+        });
+
+        // Each agent drains its own queue; priorities must never go up
+        std::size_t claimed = 0, outOfOrder = 0;
+        const auto start = Clock::now();
+        for (std::size_t a = 0; a < agents; ++a) {
+            const std::string agent = "Agent-" + std::to_string(a);
+            int last = static_cast<int>(PriorityCount);
+            while (auto id = queues.claim(agent)) {
+                const std::size_t i = std::stoul(id->substr(5));
+                const int p = (i % 10 == 0) ? static_cast<int>(Priority::CRITICAL) : static_cast<int>(priorities[i]);
+                if (p > last) ++outOfOrder;
+                last = p;
+                ++claimed;
+            }
+        }
+        report("claim, own queue", static_cast<double>(claimed), secondsSince(start));
+
+        const std::vector<TicketCategory> everyTeam = {
+            TicketCategory::TECHNICAL, TicketCategory::BILLING, TicketCategory::GENERAL,
+            TicketCategory::COMPLAINT, TicketCategory::FEATURE_REQUEST};
+        std::size_t teamClaims = 0;
+        const auto teamStart = Clock::now();
+        while (queues.claim("Agent-0", everyTeam)) ++teamClaims;
+        report("claim, 5 team queues", static_cast<double>(teamClaims), secondsSince(teamStart));
+
+        const auto stats = queues.getStats();
+        std::printf("    claimed %llu, still queued %zu\n",
+                    static_cast<unsigned long long>(stats.claimed), stats.queued);
+        if (outOfOrder != 0 || stats.queued != 0 || claimed + teamClaims != tickets) {
+            std::printf("  FAILED: %zu claims out of priority order, %zu tickets left\n", outOfOrder, stats.queued);
+            std::exit(1);
+        }
+    }
+
+    {
+        // Baseline: what an agent would do without a queue
+        const std::size_t repoTickets = 20'000;
+        std::vector<std::shared_ptr<Ticket>> all;
+        for (std::size_t i = 0; i < repoTickets; ++i) {
+            all.push_back(std::make_shared<Ticket>(ids[i], "CUST-Q", "queued", priorities[i], categories[i]));
+            all.back()->setAssignedTo(owners[i]);
+        }
+        measure("scan all tickets for the next one", 500, [&](std::size_t n) {
+            const std::string agent = "Agent-" + std::to_string(n % agents);
+            const Ticket* best = nullptr;
+            for (const auto& t : all) {
+                if (t->getStatus() != TicketStatus::OPEN || t->getAssignedTo() != agent) continue;
+                if (!best || t->getPriority() > best->getPriority() ||
+                    (t->getPriority() == best->getPriority() && t->getCreatedAt() < best->getCreatedAt()))
+                    best = t.get();
+            }
+            doNotOptimize(best);
+        });
+    }
+
+    {
+        // End to end: created through TicketService, claimed with nextTicket()
+        auto queues = std::make_shared<WorkQueueService>();
+        ctx.ticketService->setWorkQueues(queues);
+        const std::string customerId = ctx.customerService->registerCustomer(
+            "Queue Bench", "queue.bench@example.com", "+40123456789");
+
+        const std::size_t created = 20'000;
+        for (std::size_t i = 0; i < created; ++i)
+            ctx.ticketService->createTicket(customerId, "Printer on fire", priorities[i], categories[i]);
+
+        // The factory's fixed agents get HIGH and CRITICAL tickets, the rest wait for any agent
+        std::vector<std::string> staff = {"Senior-Agent-001", "Agent-002"};
+        for (std::size_t a = 0; a < 8; ++a) staff.push_back("Agent-" + std::to_string(a));
+
+        std::size_t served = 0, idle = 0;
+        const auto start = Clock::now();
+        for (std::size_t turn = 0; idle < staff.size(); ++turn) {
+            if (ctx.ticketService->nextTicket(staff[turn % staff.size()]).empty()) {
+                ++idle;
+            } else {
+                ++served;
+                idle = 0;
+            }
+        }
+        report("TicketService::nextTicket", static_cast<double>(served), secondsSince(start));
+        ctx.ticketService->setWorkQueues(nullptr);
+
+        if (served != created) {
+            std::printf("  FAILED: %zu of %zu tickets served\n", served, created);
+            std::exit(1);
+        }
+    }
+}
+
+} // namespace bench
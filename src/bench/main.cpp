@@ -0,0 +1,75 @@
+// Micro-benchmarks for the support system.
+//
+//   g++ -std=c++17 -O2 -pthread src/bench/main.cpp -o bench
+//   ./bench               # run everything
+//   ./bench validation    # run selected benchmarks by name
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "AssignmentBench.hpp"
+#include "BatchBench.hpp"
+#include "BulkTransitionBench.hpp"
+#include "ChainMetricsBench.hpp"
+#include "ChangeFeedBench.hpp"
+#include "ContentScanBench.hpp"
+#include "CustomerLookupBench.hpp"
+#include "EventBusBench.hpp"
+#include "ExportBench.hpp"
+#include "HistoryBench.hpp"
+#include "HttpBench.hpp"
+#include "ImportBench.hpp"
+#include "OnboardingBench.hpp"
+#include "RpcBench.hpp"
+#include "SlaBench.hpp"
+#include "StateMachineBench.hpp"
+#include "StatusStressBench.hpp"
+#include "TagBench.hpp"
+#include "ThrottleBench.hpp"
+#include "TicketAllocationBench.hpp"
+#include "ValidationBench.hpp"
+#include "WorkQueueBench.hpp"
+
+int main(int argc, char** argv) {
+    const std::vector<std::pair<std::string, std::function<void(bench::BenchContext&)>>> benchmarks = {
+        {"validation", bench::runValidationBenchmark},
+        {"customer-lookup", bench::runCustomerLookupBenchmark},
+        {"content-scan", bench::runContentScanBenchmark},
+        {"throttle", bench::runThrottleBenchmark},
+        {"chain-metrics", bench::runChainMetricsBenchmark},
+        {"state-machine", bench::runStateMachineBenchmark},
+        {"status-stress", bench::runStatusStressTest},
+        {"bulk-transition", bench::runBulkTransitionBenchmark},
+        {"history", bench::runHistoryBenchmark},
+        {"sla", bench::runSlaBenchmark},
+        {"event-bus", bench::runEventBusBenchmark},
+        {"change-feed", bench::runChangeFeedBenchmark},
+        {"ticket-alloc", bench::runTicketAllocationBenchmark},
+        {"tags", bench::runTagBenchmark},
+        {"assignment", bench::runAssignmentBenchmark},
+        {"work-queue", bench::runWorkQueueBenchmark},
+        {"onboarding", bench::runOnboardingBenchmark},
+        {"import", bench::runImportBenchmark},
+        {"export", bench::runExportBenchmark},
+        {"batch", bench::runBatchBenchmark},
+        {"http", bench::runHttpBenchmark},
+        {"rpc", bench::runRpcBenchmark},
+    };
+
+    bench::BenchContext ctx;
+
+    for (const auto& [name, run] : benchmarks) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) {
+            if (name == argv[i]) selected = true;
+        }
+        if (selected) {
+            run(ctx);
+            std::printf("\n");
+        }
+    }
+    return 0;
+}
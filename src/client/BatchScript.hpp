@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace client {
+
+// One line of a batch script, e.g.
+//
+//   c1 = register "Ana Pop" ana@example.com +40700000001 VIP
+//   create $c1 High Technical "Cannot log in since the update"
+//
+// Words are separated by blanks; "double quotes" keep blanks and take \" and
+// \\ escapes. $name is replaced by the result of an earlier `name = ...`
+// command, $_ by the result of the previous command.
+struct BatchCommand {
+    std::size_t line = 0;
+    std::string saveAs;               // variable receiving the result, if any
+    std::string verb;
+    std::vector<std::string> args;
+};
+
+struct BatchOptions {
+    bool echo = true;                 // one result line per command; false prints only errors
+    bool stopOnError = false;         // throttled commands do not stop the run
+    bool throttle = true;             // false: create skips the per-customer rate limits
+};
+
+struct BatchVerbStats {
+    std::size_t commands = 0;
+    std::size_t failed = 0;
+    std::size_t throttled = 0;        // refused by the rate limits, not counted in failed
+};
+
+struct BatchSummary {
+    std::size_t commands = 0;
+    std::size_t failed = 0;
+    std::size_t throttled = 0;
+    double seconds = 0;
+    std::map<std::string, BatchVerbStats> verbs;
+
+    double opsPerSecond() const {
+        return seconds > 0 ? static_cast<double>(commands) / seconds : 0;
+    }
+};
+
+// Splits `text` into a command. Returns false for blank and comment lines
+// (error empty) and for lines that cannot be parsed (error set).
+inline bool parseBatchLine(const std::string& text, std::size_t line,
+                           const std::unordered_map<std::string, std::string>& variables,
+                           BatchCommand& command, std::string& error) {
+    error.clear();
+    std::vector<std::string> words;
+    std::size_t i = 0;
+    const std::size_t n = text.size();
+
+    for (;;) {
+        while (i < n && (text[i] == ' ' || text[i] == '\t' || text[i] == '\r')) ++i;
+        if (i == n || text[i] == '#') break;
+
+        std::string word;
+        if (text[i] == '"') {
+            ++i;
+            while (i < n && text[i] != '"') {
+                if (text[i] == '\\' && i + 1 < n) ++i;
+                word.push_back(text[i++]);
+            }
+            if (i == n) {
+                error = "Unterminated quote";
+                return false;
+            }
+            ++i;
+        } else {
+            while (i < n && text[i] != ' ' && text[i] != '\t' && text[i] != '\r') word.push_back(text[i++]);
+            if (word.size() > 1 && word[0] == '$') {
+                auto it = variables.find(word.substr(1));
+                if (it == variables.end()) {
+                    error = "Unknown variable " + word;
+                    return false;
+                }
+                word = it->second;
+            }
+        }
+        words.push_back(std::move(word));
+    }
+    if (words.empty()) return false;
+
+    command = BatchCommand();
+    command.line = line;
+    std::size_t first = 0;
+    if (words.size() >= 2 && words[1] == "=") {
+        command.saveAs = words[0];
+        first = 2;
+        if (words.size() == 2) {
+            error = "Missing command after '='";
+            return false;
+        }
+    }
+    command.verb = words[first];
+    command.args.assign(words.begin() + static_cast<std::ptrdiff_t>(first) + 1, words.end());
+    return true;
+}
+
+} // namespace client
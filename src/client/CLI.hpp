@@ -1,8 +1,12 @@
 #pragma once
 
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // DOMAIN SERVICES
@@ -11,6 +15,9 @@
 #include "../domain/services/NotificationService.hpp"
 #include "../domain/services/SupportFacade.hpp"
 
+// DOMAIN FACTORIES (enum names)
+#include "../domain/factory/EnumNames.hpp"
+
 // DOMAIN MODELS
 #include "../domain/models/Customer.hpp"
 #include "../domain/models/Ticket.hpp"
@@ -22,11 +29,21 @@
 #include "../domain/behaviors/chain/CustomerExistsHandler.hpp"
 #include "../domain/behaviors/chain/DescriptionLengthHandler.hpp"
 #include "../domain/behaviors/chain/PriorityValidationHandler.hpp"
+#include "../domain/behaviors/chain/ValidationPipeline.hpp"
+#include "../domain/behaviors/chain/ChainMetrics.hpp"
+#include "../domain/behaviors/chain/TicketValidation.hpp"
 
 // BEHAVIORAL: STATE
 #include "../domain/behaviors/state/TicketStateMachine.hpp"
 #include "../domain/behaviors/state/TicketStates.hpp"
 
+// INFRASTRUCTURE: BULK IMPORT / EXPORT
+#include "../infrastructure/importing/BulkImporter.hpp"
+#include "../infrastructure/exporting/BulkExporter.hpp"
+
+// BATCH MODE
+#include "BatchScript.hpp"
+
 namespace client {
 
 class CommandLineInterface {
@@ -36,17 +53,24 @@ private:
     domain::SupportFacade&                   facade;
     domain::NotificationService&             notifier;
 
+    // Shared with the servers; its rules are re-read when the file changes
+    domain::behaviors::chain::TicketValidation& validation;
+
 public:
     CommandLineInterface(
         std::shared_ptr<domain::CustomerService> customerService,
         std::shared_ptr<domain::TicketService>   ticketService,
         domain::SupportFacade&                   facade,
-        domain::NotificationService&             notifier
+        domain::NotificationService&             notifier,
+        domain::behaviors::chain::TicketValidation& validation
     )
         : customerService(std::move(customerService))
         , ticketService(std::move(ticketService))
         , facade(facade)
-        , notifier(notifier) {}
+        , notifier(notifier)
+        , validation(validation)
+    {
+    }
 
     void run() {
         int choice = -1;
@@ -62,13 +86,287 @@ public:
                 case 5: handlePrintAllCustomers(); break;
                 case 6: handlePrintAllTickets(); break;
                 case 7: handleSimulateTicketState(); break;       // State demo
+                case 8: handleShowValidationMetrics(); break;
+                case 9: handleNextTicket(); break;
+                case 10: handleImport(); break;
+                case 11: handleExport(); break;
                 case 0: break;
                 default: std::cout << "Invalid option.\n"; break;
             }
         }
     }
 
+    // Runs commands from `in` without prompts, e.g. from a script or a load
+    // generator (line syntax in BatchScript.hpp):
+    //
+    //   register <name> <email> <phone> [type]     -> customer id
+    //   create <customerId> <priority> <category> <description>
+    //                                              -> ticket id (validated like option 2)
+    //   status <ticketId> <status>
+    //   ticket <ticketId>
+    //   customer <customerId>
+    //   query [status=] [priority=] [category=] [customer=] [agent=] [tag=]... [limit=]
+    //                                              -> number of matches, then up to limit of them
+    //   next <agentId>                             -> ticket id, "" if none is waiting
+    //
+    // Enums take their names or numbers. Each command prints "ok <result>",
+    // "error line <n>: <reason>" or, for a create refused by the rate limits,
+    // "throttled line <n>: <reason>"; a summary follows at the end. Bulk
+    // loads of many tickets per customer can turn the limits off with
+    // BatchOptions::throttle. All output goes through one large buffer.
+    BatchSummary runBatch(std::istream& in, std::FILE* out, const BatchOptions& options = {}) {
+        const auto started = std::chrono::steady_clock::now();
+        BatchSummary summary;
+        infrastructure::OutputBuffer output(out, 64 * 1024);
+        std::unordered_map<std::string, std::string> variables;
+        std::string text, error, result, detail;
+        BatchCommand command;
+
+        // Read once up front instead of checking the file for every ticket
+        validation.getRuleEngine().reloadIfChanged();
+
+        for (std::size_t line = 1; std::getline(in, text); ++line) {
+            const bool parsed = parseBatchLine(text, line, variables, command, error);
+            if (!parsed && error.empty()) continue;   // blank or comment
+
+            result.clear();
+            detail.clear();
+            bool throttled = false;
+            const bool ok = parsed && executeBatchCommand(command, options, result, detail, error, throttled);
+
+            auto& verb = summary.verbs[parsed ? command.verb : "(invalid)"];
+            ++summary.commands;
+            ++verb.commands;
+            std::string& o = output.data();
+            if (ok) {
+                variables["_"] = result;
+                if (!command.saveAs.empty()) variables[command.saveAs] = result;
+                if (options.echo) {
+                    o += "ok ";
+                    o += result;
+                    o += '\n';
+                    o += detail;
+                }
+            } else if (throttled) {
+                ++summary.throttled;
+                ++verb.throttled;
+                o += "throttled line ";
+                o += std::to_string(line);
+                o += ": ";
+                o += error;
+                o += '\n';
+            } else {
+                ++summary.failed;
+                ++verb.failed;
+                o += "error line ";
+                o += std::to_string(line);
+                o += ": ";
+                o += error;
+                o += '\n';
+            }
+            output.commit();
+            if (!ok && !throttled && options.stopOnError) break;
+        }
+
+        summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        char row[160];
+        std::snprintf(row, sizeof(row), "batch: %zu commands in %.3f s (%.0f ops/s), %zu failed, %zu throttled\n",
+                      summary.commands, summary.seconds, summary.opsPerSecond(), summary.failed, summary.throttled);
+        output.data() += row;
+        for (const auto& [name, stats] : summary.verbs) {
+            std::snprintf(row, sizeof(row), "  %-10s %10zu  %zu failed, %zu throttled\n", name.c_str(), stats.commands,
+                          stats.failed, stats.throttled);
+            output.data() += row;
+        }
+        output.close();
+        return summary;
+    }
+
 private:
+    // `throttled` is set when a create is refused by the rate limits
+    bool executeBatchCommand(const BatchCommand& c, const BatchOptions& options, std::string& result,
+                             std::string& detail, std::string& error, bool& throttled) {
+        using namespace domain;
+        const auto& a = c.args;
+        auto usage = [&](const char* text) {
+            error = std::string("Usage: ") + text;
+            return false;
+        };
+
+        if (c.verb == "register") {
+            if (a.size() < 3 || a.size() > 4) return usage("register <name> <email> <phone> [type]");
+            CustomerType type = CustomerType::REGULAR;
+            if (a.size() == 4 && !parseCustomerType(a[3], type)) {
+                error = "Unknown customer type: " + a[3];
+                return false;
+            }
+            if (a[1].find('@') == std::string::npos) {
+                error = "Invalid email: " + a[1];
+                return false;
+            }
+            result = customerService->registerCustomer(a[0], a[1], a[2], type);
+            return true;
+        }
+
+        if (c.verb == "create") {
+            if (a.size() != 4) return usage("create <customerId> <priority> <category> <description>");
+            behaviors::chain::TicketCreationRequest req;
+            req.customerId = a[0];
+            req.description = a[3];
+            if (!parsePriority(a[1], req.priority)) {
+                error = "Unknown priority: " + a[1];
+                return false;
+            }
+            if (!parseTicketCategory(a[2], req.category)) {
+                error = "Unknown category: " + a[2];
+                return false;
+            }
+            if (!(options.throttle ? validation.validate(req) : validation.validateUnthrottled(req))) {
+                error = req.errorMessage;
+                throttled = domain::behaviors::chain::ThrottleRule::rejected(req);
+                return false;
+            }
+            result = ticketService->createTicket(req.customerId, req.description, req.priority, req.category);
+            if (result.empty()) {
+                error = "Ticket could not be created";
+                return false;
+            }
+            for (const auto& flag : req.flags) detail += "  flagged: " + flag + "\n";
+            return true;
+        }
+
+        if (c.verb == "status") {
+            if (a.size() != 2) return usage("status <ticketId> <status>");
+            TicketStatus status;
+            if (!parseTicketStatus(a[1], status)) {
+                error = "Unknown status: " + a[1];
+                return false;
+            }
+            switch (ticketService->updateTicketStatus(a[0], status)) {
+                case StatusUpdateResult::UPDATED:
+                    result = TicketFactory::getStatusName(status);
+                    return true;
+                case StatusUpdateResult::NOT_FOUND:
+                    error = "Unknown ticket: " + a[0];
+                    return false;
+                case StatusUpdateResult::ILLEGAL_TRANSITION:
+                    error = "Not allowed: " + a[0] + " -> " + TicketFactory::getStatusName(status);
+                    return false;
+                case StatusUpdateResult::CONFLICT:
+                    error = "Changed concurrently: " + a[0];
+                    return false;
+            }
+            return false;
+        }
+
+        if (c.verb == "ticket") {
+            if (a.size() != 1) return usage("ticket <ticketId>");
+            auto t = ticketService->getTicket(a[0]);
+            if (!t) {
+                error = "Unknown ticket: " + a[0];
+                return false;
+            }
+            result = a[0];
+            appendTicketLine(detail, *t);
+            return true;
+        }
+
+        if (c.verb == "customer") {
+            if (a.size() != 1) return usage("customer <customerId>");
+            auto customer = customerService->getCustomer(a[0]);
+            if (!customer) {
+                error = "Unknown customer: " + a[0];
+                return false;
+            }
+            result = a[0];
+            detail += "  " + customer->getName() + " | " + customer->getEmail() + " | " + customer->getPhone() +
+                      " | " + CustomerFactory::getTypeName(customer->getType()) + "\n";
+            return true;
+        }
+
+        if (c.verb == "query") {
+            infrastructure::TicketFilter filter;
+            std::size_t limit = 20;
+            for (const auto& arg : a) {
+                const auto eq = arg.find('=');
+                const std::string key = arg.substr(0, eq);
+                const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+                bool valid = true;
+                if (eq == std::string::npos) {
+                    valid = false;
+                } else if (key == "status") {
+                    filter.status.emplace();
+                    valid = parseTicketStatus(value, *filter.status);
+                } else if (key == "priority") {
+                    filter.priority.emplace();
+                    valid = parsePriority(value, *filter.priority);
+                } else if (key == "category") {
+                    filter.category.emplace();
+                    valid = parseTicketCategory(value, *filter.category);
+                } else if (key == "customer") {
+                    filter.customerId = value;
+                } else if (key == "agent") {
+                    filter.assignedTo = value;
+                } else if (key == "tag") {
+                    filter.tags.push_back(value);
+                } else if (key == "limit") {
+                    limit = static_cast<std::size_t>(std::strtoul(value.c_str(), nullptr, 10));
+                } else {
+                    valid = false;
+                }
+                if (!valid) {
+                    error = "Bad query term: " + arg;
+                    return false;
+                }
+            }
+
+            const infrastructure::TicketMatcher matches(std::move(filter));
+            const std::size_t pageSize = 4096;
+            std::size_t found = 0;
+            std::string after;
+            for (;;) {
+                const auto page = ticketService->getTicketsPage(after, pageSize);
+                for (const auto& t : page) {
+                    if (!matches(*t)) continue;
+                    if (found++ < limit) appendTicketLine(detail, *t);
+                }
+                if (page.size() < pageSize) break;
+                after = page.back()->getId();
+            }
+            result = std::to_string(found);
+            return true;
+        }
+
+        if (c.verb == "next") {
+            if (a.size() != 1) return usage("next <agentId>");
+            result = ticketService->nextTicket(a[0]);
+            return true;
+        }
+
+        error = "Unknown command: " + c.verb;
+        return false;
+    }
+
+    static void appendTicketLine(std::string& out, const domain::Ticket& t) {
+        using domain::TicketFactory;
+        out += "  ";
+        out += t.getId();
+        out += " | ";
+        out += t.getCustomerId();
+        out += " | ";
+        out += TicketFactory::getStatusName(t.getStatus());
+        out += " | ";
+        out += TicketFactory::getPriorityName(t.getPriority());
+        out += " | ";
+        out += TicketFactory::getCategoryName(t.getCategory());
+        out += " | ";
+        out += t.getAssignedTo();
+        out += " | ";
+        out += t.getDescription();
+        out += '\n';
+    }
+
     void showMenu() {
         std::cout << "\n========= SUPPORT SYSTEM =========\n";
         std::cout << "1. Register customer\n";
@@ -78,10 +376,31 @@ private:
         std::cout << "5. Print all customers\n";
         std::cout << "6. Print all tickets\n";
         std::cout << "7. Simulate ticket lifecycle (State pattern)\n";
+        std::cout << "8. Show validation metrics\n";
+        std::cout << "9. Take next ticket (agent work queue)\n";
+        std::cout << "10. Import customers or tickets from CSV / JSONL\n";
+        std::cout << "11. Export customers or tickets to CSV / JSONL / binary\n";
         std::cout << "0. Exit\n";
         std::cout << "Choose: ";
     }
 
+    // Reads one of an enum's `count` values by number; anything else is refused
+    template <typename Enum>
+    static bool readEnum(const char* prompt, std::size_t count, Enum& out) {
+        int value = -1;
+        std::cout << prompt;
+        if (!(std::cin >> value)) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        if (value < 0 || value >= static_cast<int>(count)) {
+            std::cout << "Invalid choice, expected 0-" << count - 1 << ".\n";
+            return false;
+        }
+        out = static_cast<Enum>(value);
+        return true;
+    }
+
     // 1. Register customer
     void handleCreateCustomer() {
         std::string name, email, phone;
@@ -100,7 +419,8 @@ private:
         using namespace domain::behaviors::chain;
 
         std::string customerId, issue;
-        int priority, category;
+        domain::Priority priority;
+        domain::TicketCategory category;
 
         std::cout << "Customer ID: ";
         std::cin >> customerId;
@@ -108,30 +428,20 @@ private:
         std::cin.ignore();
         std::getline(std::cin, issue);
 
-        std::cout << "Priority (0=LOW,1=MEDIUM,2=HIGH,3=CRITICAL): ";
-        std::cin >> priority;
-
-        std::cout << "Category (0=TECHNICAL,1=BILLING,2=GENERAL,3=COMPLAINT,4=FEATURE_REQUEST): ";
-        std::cin >> category;
-
-        TicketCreationRequest req{
-            customerId,
-            issue,
-            static_cast<domain::Priority>(priority),
-            static_cast<domain::TicketCategory>(category)
-        };
-
-        // Build chain: CustomerExists -> DescriptionLength -> PriorityValidation
-        auto customerHandler = std::make_shared<CustomerExistsHandler>(*customerService);
-        auto lengthHandler   = std::make_shared<DescriptionLengthHandler>(10);
-        auto priorityHandler = std::make_shared<PriorityValidationHandler>();
-
-        customerHandler->setNext(lengthHandler);
-        lengthHandler->setNext(priorityHandler);
+        if (!readEnum("Priority (0=LOW,1=MEDIUM,2=HIGH,3=CRITICAL): ", domain::PriorityCount, priority) ||
+            !readEnum("Category (0=TECHNICAL,1=BILLING,2=GENERAL,3=COMPLAINT,4=FEATURE_REQUEST): ",
+                      domain::TicketCategoryCount, category))
+            return;
 
-        customerHandler->handle(req);
+        TicketCreationRequest req;
+        req.customerId = customerId;
+        req.description = issue;
+        req.priority = priority;
+        req.category = category;
 
-        if (!req.valid) {
+        // CustomerExists -> configured rules
+        validation.getRuleEngine().reloadIfChanged();
+        if (!validation.validate(req)) {
             std::cout << "❌ Ticket creation failed: " << req.errorMessage << "\n";
             return;
         }
@@ -144,12 +454,16 @@ private:
         );
 
         std::cout << "✅ Ticket created successfully via validated pipeline.\n";
+        for (const auto& flag : req.flags) {
+            std::cout << "⚠ Flagged for review: " << flag << "\n";
+        }
     }
 
     // 3. Facade workflow
     void handleFacadeWorkflow() {
         std::string name, email, phone, issue;
-        int priority, category;
+        domain::Priority priority;
+        domain::TicketCategory category;
 
         std::cout << "Customer name: ";
         std::cin >> name;
@@ -162,19 +476,29 @@ private:
         std::cin.ignore();
         std::getline(std::cin, issue);
 
-        std::cout << "Priority (0=LOW,1=MEDIUM,2=HIGH,3=CRITICAL): ";
-        std::cin >> priority;
+        if (!readEnum("Priority (0=LOW,1=MEDIUM,2=HIGH,3=CRITICAL): ", domain::PriorityCount, priority) ||
+            !readEnum("Category (0=TECHNICAL,1=BILLING,2=GENERAL,3=COMPLAINT,4=FEATURE_REQUEST): ",
+                      domain::TicketCategoryCount, category))
+            return;
 
-        std::cout << "Category (0=TECHNICAL,1=BILLING,2=GENERAL,3=COMPLAINT,4=FEATURE_REQUEST): ";
-        std::cin >> category;
+        // The customer is new, so only the rules and content scan apply
+        domain::behaviors::chain::TicketCreationRequest req;
+        req.description = issue;
+        req.priority = priority;
+        req.category = category;
+        validation.getRuleEngine().reloadIfChanged();
+        if (!validation.validateForNewCustomer(req)) {
+            std::cout << "❌ Onboarding failed: " << req.errorMessage << "\n";
+            return;
+        }
 
         auto result = facade.registerCustomerAndOpenTicket(
             name,
             email,
             phone,
             issue,
-            static_cast<domain::Priority>(priority),
-            static_cast<domain::TicketCategory>(category)
+            priority,
+            category
         );
 
         std::cout << "Customer ID: " << result.first  << "\n";
@@ -205,18 +529,33 @@ private:
     }
 
     // 6. Print tickets
+    // A page of tickets at a time, written with one call per page
     void handlePrintAllTickets() {
-        auto tickets = ticketService->getAllTickets();
+        using domain::TicketFactory;
+        const std::size_t pageSize = 1024;
+        std::string after, text;
         std::cout << "\nAll tickets:\n";
-        for (const auto& t : tickets) {
-            if (!t) continue;
-            std::cout << "ID: "         << t->getId()
-                      << " | CustomerID: " << t->getCustomerId()
-                      << " | Description: " << t->getDescription()
-                      << " | Status: "    << static_cast<int>(t->getStatus())
-                      << " | Priority: "  << static_cast<int>(t->getPriority())
-                      << " | Category: "  << static_cast<int>(t->getCategory())
-                      << "\n";
+        for (;;) {
+            const auto page = ticketService->getTicketsPage(after, pageSize);
+            text.clear();
+            for (const auto& t : page) {
+                text += "ID: ";
+                text += t->getId();
+                text += " | CustomerID: ";
+                text += t->getCustomerId();
+                text += " | Description: ";
+                text += t->getDescription();
+                text += " | Status: ";
+                text += TicketFactory::getStatusName(t->getStatus());
+                text += " | Priority: ";
+                text += TicketFactory::getPriorityName(t->getPriority());
+                text += " | Category: ";
+                text += TicketFactory::getCategoryName(t->getCategory());
+                text += "\n";
+            }
+            std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+            if (page.size() < pageSize) break;
+            after = page.back()->getId();
         }
     }
 
@@ -225,8 +564,7 @@ private:
         using namespace domain::behaviors::state;
         using domain::TicketStatus;
 
-        auto state = std::make_shared<OpenState>();
-        TicketStateMachine sm(state);
+        TicketStateMachine sm(TicketStatus::OPEN);
 
         auto printStatus = [](TicketStatus s) {
             std::cout << "Current status: " << static_cast<int>(s) << "\n";
@@ -251,6 +589,103 @@ private:
         sm.reopen();
         printStatus(sm.getStatus());
     }
+
+    // 8. Per-handler validation metrics
+    void handleShowValidationMetrics() {
+        const auto snapshot = domain::behaviors::chain::ChainMetrics::getInstance().snapshot();
+
+        std::cout << "\nValidation handlers:\n";
+        for (const auto& h : snapshot.handlers) {
+            char line[160];
+            std::snprintf(line, sizeof(line),
+                          "%-20s calls=%-8llu rejected=%-8llu p50=%.0fns p99=%.0fns\n",
+                          h.name.c_str(),
+                          static_cast<unsigned long long>(h.calls),
+                          static_cast<unsigned long long>(h.rejections),
+                          h.percentileNs(0.50), h.percentileNs(0.99));
+            std::cout << line;
+        }
+
+        if (!snapshot.rejectionsByReason.empty()) {
+            std::cout << "Rejections by reason:\n";
+            for (const auto& [reason, count] : snapshot.rejectionsByReason)
+                std::cout << " - " << reason << ": " << count << "\n";
+        }
+    }
+
+    // 9. Claim the most urgent ticket waiting for an agent
+    void handleNextTicket() {
+        std::string agent;
+        std::cout << "Agent ID: ";
+        std::cin >> agent;
+
+        const std::string id = ticketService->nextTicket(agent);
+        if (id.empty()) std::cout << "No tickets waiting for " << agent << "\n";
+        else std::cout << "Now working on: " << id << "\n";
+    }
+
+    // 10. Bulk import from a file
+    void handleImport() {
+        int kind;
+        std::string path;
+        std::cout << "Import (0=customers,1=tickets): ";
+        std::cin >> kind;
+        std::cout << "File (.csv or .jsonl): ";
+        std::cin >> path;
+
+        infrastructure::BulkImporter importer(customerService, ticketService);
+        const auto report = kind == 1 ? importer.importTickets(path) : importer.importCustomers(path);
+        if (!report.ok()) {
+            std::cout << "Import failed: " << report.error << "\n";
+            return;
+        }
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "%zu rows, %zu imported, %zu rejected in %.2f s (%.0f rows/s, %u threads)\n",
+                      report.rows, report.imported, report.rejected, report.seconds,
+                      report.rowsPerSecond(), report.threads);
+        std::cout << line;
+        if (report.rejected) std::cout << "Rejected rows written to " << report.errorFile << "\n";
+    }
+
+    // 11. Export
+    void handleExport() {
+        int kind, status;
+        unsigned files;
+        std::string path;
+        std::cout << "Export (0=customers,1=tickets): ";
+        std::cin >> kind;
+        std::cout << "File (.csv, .jsonl or .bin): ";
+        std::cin >> path;
+        std::cout << "Split into how many files: ";
+        std::cin >> files;
+
+        infrastructure::ExportOptions options;
+        options.files = files;
+        infrastructure::ExportReport report;
+        infrastructure::BulkExporter exporter(customerService, ticketService);
+        if (kind == 1) {
+            std::cout << "Status (-1=all,0=OPEN,1=IN_PROGRESS,2=RESOLVED,3=CLOSED): ";
+            std::cin >> status;
+            infrastructure::TicketFilter filter;
+            if (status >= 0 && status < static_cast<int>(domain::TicketStatusCount))
+                filter.status = static_cast<domain::TicketStatus>(status);
+            report = exporter.exportTickets(path, options, filter);
+        } else {
+            report = exporter.exportCustomers(path, options);
+        }
+        if (!report.ok()) {
+            std::cout << "Export failed: " << report.error << "\n";
+            return;
+        }
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "%zu of %zu records exported in %.2f s (%.0f records/s, %.1f MB)\n",
+                      report.exported, report.scanned, report.seconds,
+                      report.recordsPerSecond(), static_cast<double>(report.bytes) / 1e6);
+        std::cout << line;
+        for (const auto& f : report.files) std::cout << "  " << f << "\n";
+    }
 };
 
 } // namespace client
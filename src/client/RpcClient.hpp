@@ -0,0 +1,320 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "../domain/models/Customer.hpp"
+#include "../domain/models/Enums.hpp"
+#include "../domain/models/Ticket.hpp"
+#include "../infrastructure/exporting/BinaryFormat.hpp"
+#include "../infrastructure/rpc/RpcProtocol.hpp"
+
+namespace client {
+
+// Requests to send together. Each call adds one request; its reply comes
+// back at the same position (see SupportRpcClient::call).
+class RpcRequestBatch {
+private:
+    std::string bytes;
+    std::vector<std::size_t> frames;   // where each request starts in `bytes`
+
+    template <typename Fn>
+    void add(infrastructure::RpcOperation operation, Fn&& arguments) {
+        const std::size_t start = infrastructure::beginRpcFrame(bytes, 0, static_cast<std::uint8_t>(operation));
+        arguments();
+        infrastructure::endRpcFrame(bytes, start);
+        frames.push_back(start);
+    }
+
+    friend class SupportRpcClient;
+
+public:
+    std::size_t size() const { return frames.size(); }
+    bool empty() const { return frames.empty(); }
+
+    void clear() {
+        bytes.clear();
+        frames.clear();
+    }
+
+    void ping() {
+        add(infrastructure::RpcOperation::PING, [] {});
+    }
+
+    void registerCustomer(const std::string& name, const std::string& email, const std::string& phone,
+                          domain::CustomerType type = domain::CustomerType::REGULAR) {
+        using namespace infrastructure::binary_detail;
+        add(infrastructure::RpcOperation::REGISTER_CUSTOMER, [&] {
+            putString(bytes, name);
+            putString(bytes, email);
+            putString(bytes, phone);
+            bytes.push_back(static_cast<char>(type));
+        });
+    }
+
+    void getCustomer(const std::string& id) {
+        add(infrastructure::RpcOperation::GET_CUSTOMER, [&] { infrastructure::binary_detail::putString(bytes, id); });
+    }
+
+    void createTicket(const std::string& customerId, const std::string& description, domain::Priority priority,
+                      domain::TicketCategory category = domain::TicketCategory::GENERAL) {
+        using namespace infrastructure::binary_detail;
+        add(infrastructure::RpcOperation::CREATE_TICKET, [&] {
+            putString(bytes, customerId);
+            putString(bytes, description);
+            bytes.push_back(static_cast<char>(priority));
+            bytes.push_back(static_cast<char>(category));
+        });
+    }
+
+    void getTicket(const std::string& id) {
+        add(infrastructure::RpcOperation::GET_TICKET, [&] { infrastructure::binary_detail::putString(bytes, id); });
+    }
+
+    void updateStatus(const std::string& id, domain::TicketStatus status) {
+        add(infrastructure::RpcOperation::UPDATE_STATUS, [&] {
+            infrastructure::binary_detail::putString(bytes, id);
+            bytes.push_back(static_cast<char>(status));
+        });
+    }
+
+    void assignTicket(const std::string& id, const std::string& agent) {
+        using namespace infrastructure::binary_detail;
+        add(infrastructure::RpcOperation::ASSIGN_TICKET, [&] {
+            putString(bytes, id);
+            putString(bytes, agent);
+        });
+    }
+
+    void queryTickets(const infrastructure::RpcTicketQuery& query) {
+        add(infrastructure::RpcOperation::QUERY_TICKETS, [&] { infrastructure::appendRpcQuery(bytes, query); });
+    }
+
+    void nextTicket(const std::string& agent) {
+        add(infrastructure::RpcOperation::NEXT_TICKET, [&] { infrastructure::binary_detail::putString(bytes, agent); });
+    }
+};
+
+struct RpcReply {
+    std::uint32_t id = 0;
+    infrastructure::RpcStatus status = infrastructure::RpcStatus::INTERNAL_ERROR;
+    std::string result;
+
+    bool ok() const { return status == infrastructure::RpcStatus::OK; }
+
+    // The message of a failed request; "" if it succeeded
+    std::string error() const {
+        std::string message;
+        if (ok()) return message;
+        const char* p = result.data();
+        infrastructure::binary_detail::getString(p, p + result.size(), message);
+        return message;
+    }
+
+    // REGISTER_CUSTOMER, CREATE_TICKET, NEXT_TICKET: the id
+    std::string text() const {
+        std::string value;
+        const char* p = result.data();
+        if (ok()) infrastructure::binary_detail::getString(p, p + result.size(), value);
+        return value;
+    }
+
+    // GET_CUSTOMER, GET_TICKET
+    template <typename Record>
+    bool decode(std::shared_ptr<Record>& out) const {
+        const char* p = result.data();
+        return ok() && readRecord(p, p + result.size(), out);
+    }
+
+    // QUERY_TICKETS: the page and the cursor for the next one ("" at the end)
+    bool decode(std::vector<std::shared_ptr<domain::Ticket>>& tickets, std::string& next) const {
+        tickets.clear();
+        const char* p = result.data();
+        const char* end = p + result.size();
+        if (!ok() || result.size() < 4) return false;
+        const std::uint32_t count = infrastructure::rpc_detail::getU32(p);
+        p += 4;
+        tickets.resize(count);
+        for (auto& t : tickets) {
+            if (!readRecord(p, end, t)) return false;
+        }
+        return infrastructure::binary_detail::getString(p, end, next);
+    }
+
+private:
+    template <typename Record>
+    static bool readRecord(const char*& p, const char* end, std::shared_ptr<Record>& out) {
+        std::uint64_t n;
+        if (!infrastructure::binary_detail::getVarint(p, end, n) || n > static_cast<std::uint64_t>(end - p))
+            return false;
+        const char* recordEnd = p + n;
+        if (!infrastructure::decodeBinaryRecord(p, recordEnd, out)) return false;
+        p = recordEnd;
+        return true;
+    }
+};
+
+// Blocking client for an RpcServer's Unix domain socket. call() sends a
+// whole batch with one write and then reads the replies; send() and
+// receive() let a caller keep several batches in flight on one connection.
+// Not for use by several threads at once.
+class SupportRpcClient {
+private:
+    int fd = -1;
+    std::string in;
+    std::size_t consumed = 0;   // of `in`
+    std::uint32_t nextId = 1;
+    std::string failure;
+
+#if defined(MSG_NOSIGNAL)
+    static constexpr int SendFlags = MSG_NOSIGNAL;   // a closed server is an error, not SIGPIPE
+#else
+    static constexpr int SendFlags = 0;
+#endif
+
+    bool fail(const std::string& what) {
+        failure = what + ": " + std::strerror(errno);
+        close();
+        return false;
+    }
+
+#if !defined(_WIN32)
+    bool readMore() {
+        if (consumed > 0) {
+            in.erase(0, consumed);
+            consumed = 0;
+        }
+        char buffer[64 * 1024];
+        for (;;) {
+            const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (n > 0) {
+                in.append(buffer, static_cast<std::size_t>(n));
+                return true;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n == 0) errno = ECONNRESET;
+            return fail("receive");
+        }
+    }
+#endif
+
+public:
+    SupportRpcClient() = default;
+    SupportRpcClient(const SupportRpcClient&) = delete;
+    SupportRpcClient& operator=(const SupportRpcClient&) = delete;
+
+    ~SupportRpcClient() { close(); }
+
+    bool connect(const std::string& path) {
+        close();
+#if !defined(_WIN32)
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path)) {
+            errno = ENAMETOOLONG;
+            return fail("Bad socket path " + path);
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return fail("socket");
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+            return fail("Cannot connect to " + path);
+        failure.clear();
+        return true;
+#else
+        failure = "Unix domain sockets are not supported here: " + path;
+        return false;
+#endif
+    }
+
+    void close() {
+#if !defined(_WIN32)
+        if (fd >= 0) ::close(fd);
+#endif
+        fd = -1;
+        in.clear();
+        consumed = 0;
+    }
+
+    bool isConnected() const { return fd >= 0; }
+    const std::string& error() const { return failure; }
+
+    // Numbers the batch's requests and sends them with one write; returns
+    // the id of the first (the others follow on), 0 on failure
+    std::uint32_t send(RpcRequestBatch& batch) {
+        if (fd < 0 || batch.empty()) return 0;
+        const std::uint32_t first = nextId;
+        for (std::size_t start : batch.frames)
+            infrastructure::rpc_detail::setU32(&batch.bytes[start + infrastructure::RpcLengthSize], nextId++);
+#if !defined(_WIN32)
+        std::size_t sent = 0;
+        while (sent < batch.bytes.size()) {
+            const ssize_t n = ::send(fd, batch.bytes.data() + sent, batch.bytes.size() - sent, SendFlags);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                fail("send");
+                return 0;
+            }
+            sent += static_cast<std::size_t>(n);
+        }
+#endif
+        return first;
+    }
+
+    // The next reply, in the order the requests were sent
+    bool receive(RpcReply& reply) {
+        using namespace infrastructure;
+        if (fd < 0) return false;
+#if !defined(_WIN32)
+        while (in.size() - consumed < RpcLengthSize) {
+            if (!readMore()) return false;
+        }
+        const std::size_t length = rpc_detail::getU32(in.data() + consumed);
+        if (length < RpcHeaderSize) {
+            errno = EPROTO;
+            return fail("Malformed reply");
+        }
+        while (in.size() - consumed < RpcLengthSize + length) {
+            if (!readMore()) return false;
+        }
+        const char* frame = in.data() + consumed + RpcLengthSize;
+        reply.id = rpc_detail::getU32(frame);
+        reply.status = static_cast<RpcStatus>(static_cast<unsigned char>(frame[4]));
+        reply.result.assign(frame + RpcHeaderSize, length - RpcHeaderSize);
+        consumed += RpcLengthSize + length;
+        return true;
+#else
+        (void)reply;
+        return false;
+#endif
+    }
+
+    // Sends the batch and waits for all its replies, in batch order
+    bool call(RpcRequestBatch& batch, std::vector<RpcReply>& replies) {
+        replies.resize(batch.size());
+        if (batch.empty()) return true;
+        std::uint32_t id = send(batch);
+        if (id == 0) return false;
+        for (auto& reply : replies) {
+            if (!receive(reply)) return false;
+            if (reply.id != id++) {
+                errno = EPROTO;
+                return fail("Reply out of order");
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace client
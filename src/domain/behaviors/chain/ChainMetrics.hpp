@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define CHAIN_METRICS_HAVE_TSC 1
+#endif
+
+#include "TicketCreationRequest.hpp"
+
+namespace domain::behaviors::chain {
+
+struct HandlerMetricsSnapshot {
+    static constexpr std::size_t BucketCount = 32;
+
+    std::string name;
+    std::uint64_t calls = 0;
+    std::uint64_t rejections = 0;
+    std::uint64_t timedCalls = 0;
+
+    // Bucket i counts sampled calls that took [2^(i-1), 2^i) ns
+    std::array<std::uint64_t, BucketCount> latencyNs{};
+
+    double percentileNs(double p) const {
+        if (timedCalls == 0) return 0;
+        const auto rank = static_cast<std::uint64_t>(p * static_cast<double>(timedCalls - 1));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i) {
+            seen += latencyNs[i];
+            if (seen > rank) return static_cast<double>(std::uint64_t{1} << i);
+        }
+        return static_cast<double>(std::uint64_t{1} << (BucketCount - 1));
+    }
+};
+
+struct ChainMetricsSnapshot {
+    std::vector<HandlerMetricsSnapshot> handlers;
+
+    // "<handler>/<rejection code>" -> count
+    std::map<std::string, std::uint64_t> rejectionsByReason;
+};
+
+// Per-handler call/rejection counters and latency histograms.
+//
+// Every thread writes to its own buffer (single writer, relaxed stores, no
+// shared cache lines); snapshot() sums all buffers. When a thread exits, its
+// counts are folded into a shared buffer and its own is freed. Latency is taken from the TSC where available
+// and only for one call in 2^samplingShift to keep the hot path short.
+class ChainMetrics {
+public:
+    static constexpr std::size_t MaxHandlers = 64;
+    static constexpr std::size_t MaxReasonsPerHandler = 8;
+    using Slot = std::uint32_t;
+
+private:
+    struct Reason {
+        std::string code;
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    struct Counters {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> rejections{0};
+        std::atomic<std::uint64_t> timedCalls{0};
+        std::array<std::atomic<std::uint64_t>, HandlerMetricsSnapshot::BucketCount> ticks{};
+
+        // Append-only: a code is written once before reasonCount publishes it.
+        // Codes beyond the limit are counted in the last entry as "other".
+        std::atomic<std::uint32_t> reasonCount{0};
+        std::array<Reason, MaxReasonsPerHandler> reasons;
+    };
+
+    struct ThreadBuffer {
+        std::array<Counters, MaxHandlers> handlers;
+        std::uint32_t sampleCounter = 0;
+    };
+
+    // Frees the thread's buffer when it exits
+    struct BufferOwner {
+        ChainMetrics* metrics = nullptr;
+        std::shared_ptr<ThreadBuffer> buffer;
+
+        ~BufferOwner() {
+            if (metrics) metrics->retire(buffer);
+        }
+    };
+
+    std::mutex mtx;
+    std::vector<std::string> names;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    ThreadBuffer retired;   // counts of exited threads, written under mtx
+    std::atomic<bool> enabled{true};
+    std::atomic<std::uint32_t> samplingShift{3};
+
+    ChainMetrics() = default;
+
+    // The thread keeps a plain pointer to its buffer (no TLS guard on
+    // access); the owner is only touched on first use and at thread exit.
+    ThreadBuffer& localBuffer() {
+        static thread_local ThreadBuffer* local = nullptr;
+        if (!local) {
+            static thread_local BufferOwner owner;
+            owner.buffer = std::make_shared<ThreadBuffer>();
+            owner.metrics = this;
+            std::lock_guard<std::mutex> lock(mtx);
+            buffers.push_back(owner.buffer);
+            local = owner.buffer.get();
+        }
+        return *local;
+    }
+
+    void retire(const std::shared_ptr<ThreadBuffer>& buffer) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (Slot s = 0; s < names.size(); ++s) {
+            const Counters& from = buffer->handlers[s];
+            Counters& to = retired.handlers[s];
+            bump(to.calls, from.calls.load(std::memory_order_relaxed));
+            bump(to.rejections, from.rejections.load(std::memory_order_relaxed));
+            bump(to.timedCalls, from.timedCalls.load(std::memory_order_relaxed));
+            for (std::size_t i = 0; i < HandlerMetricsSnapshot::BucketCount; ++i)
+                bump(to.ticks[i], from.ticks[i].load(std::memory_order_relaxed));
+            const std::uint32_t used = from.reasonCount.load(std::memory_order_acquire);
+            for (std::uint32_t r = 0; r < used; ++r)
+                countReason(to, from.reasons[r].code, from.reasons[r].count.load(std::memory_order_relaxed));
+        }
+        buffers.erase(std::remove(buffers.begin(), buffers.end(), buffer), buffers.end());
+    }
+
+    static void countReason(Counters& c, const std::string& code, std::uint64_t by = 1) {
+        const std::uint32_t used = c.reasonCount.load(std::memory_order_relaxed);
+        for (std::uint32_t i = 0; i < used; ++i) {
+            if (c.reasons[i].code == code) {
+                bump(c.reasons[i].count, by);
+                return;
+            }
+        }
+        if (used < MaxReasonsPerHandler - 1) {
+            c.reasons[used].code = code;
+            bump(c.reasons[used].count, by);
+            c.reasonCount.store(used + 1, std::memory_order_release);
+            return;
+        }
+        if (used == MaxReasonsPerHandler - 1) {
+            c.reasons[used].code = "other";
+            c.reasonCount.store(used + 1, std::memory_order_release);
+        }
+        bump(c.reasons[MaxReasonsPerHandler - 1].count, by);
+    }
+
+    static void bump(std::atomic<std::uint64_t>& c, std::uint64_t by = 1) {
+        // Only the owning thread writes, so no read-modify-write is needed.
+        c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    static std::uint32_t bucketFor(std::uint64_t value) {
+        std::uint32_t b = 0;
+        while (value > 0 && b + 1 < HandlerMetricsSnapshot::BucketCount) {
+            value >>= 1;
+            ++b;
+        }
+        return b;
+    }
+
+    static double ticksPerNs() {
+#if defined(CHAIN_METRICS_HAVE_TSC)
+        static const double ratio = [] {
+            const auto t0 = std::chrono::steady_clock::now();
+            const std::uint64_t c0 = __rdtsc();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const std::uint64_t c1 = __rdtsc();
+            const auto t1 = std::chrono::steady_clock::now();
+            const double ns = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            return ns > 0 ? static_cast<double>(c1 - c0) / ns : 1.0;
+        }();
+        return ratio;
+#else
+        return 1.0;
+#endif
+    }
+
+public:
+    static ChainMetrics& getInstance() {
+        static ChainMetrics instance;
+        return instance;
+    }
+
+    ChainMetrics(const ChainMetrics&) = delete;
+    ChainMetrics& operator=(const ChainMetrics&) = delete;
+
+    static std::uint64_t now() {
+#if defined(CHAIN_METRICS_HAVE_TSC)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Handlers with the same name share a slot. Past MaxHandlers - 1 names,
+    // the rest share the last slot, reported as "other".
+    Slot registerHandler(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (Slot i = 0; i < names.size(); ++i) {
+            if (names[i] == name) return i;
+        }
+        if (names.size() >= MaxHandlers - 1) {
+            if (names.size() < MaxHandlers) names.push_back("other");
+            return MaxHandlers - 1;
+        }
+        names.push_back(name);
+        return static_cast<Slot>(names.size() - 1);
+    }
+
+    void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Time one call in 2^shift (0 = every call).
+    void setLatencySampling(std::uint32_t shift) {
+        samplingShift.store(shift, std::memory_order_relaxed);
+    }
+
+    // Runs fn(request) and records it against the handler's slot.
+    template <typename Fn>
+    void record(Slot slot, TicketCreationRequest& request, Fn&& fn) {
+        if (!isEnabled()) {
+            fn(request);
+            return;
+        }
+
+        ThreadBuffer& buffer = localBuffer();
+        Counters& c = buffer.handlers[slot];
+
+        const std::uint32_t mask = (1u << samplingShift.load(std::memory_order_relaxed)) - 1;
+        const bool timed = (buffer.sampleCounter++ & mask) == 0;
+
+        const std::uint64_t start = timed ? now() : 0;
+        fn(request);
+        if (timed) {
+            bump(c.timedCalls);
+            bump(c.ticks[bucketFor(now() - start)]);
+        }
+
+        bump(c.calls);
+        if (!request.valid) {
+            bump(c.rejections);
+            static const std::string unspecified = "unspecified";
+            countReason(c, request.rejectionCode.empty() ? unspecified : request.rejectionCode);
+        }
+    }
+
+    ChainMetricsSnapshot snapshot() {
+        const double perNs = ticksPerNs();
+
+        // Held throughout, so an exiting thread is counted exactly once
+        std::lock_guard<std::mutex> lock(mtx);
+        std::vector<const ThreadBuffer*> all{&retired};
+        for (const auto& b : buffers) all.push_back(b.get());
+
+        ChainMetricsSnapshot result;
+        result.handlers.resize(names.size());
+
+        for (Slot s = 0; s < names.size(); ++s) {
+            HandlerMetricsSnapshot& h = result.handlers[s];
+            h.name = names[s];
+            for (const ThreadBuffer* b : all) {
+                const Counters& c = b->handlers[s];
+                h.calls += c.calls.load(std::memory_order_relaxed);
+                h.rejections += c.rejections.load(std::memory_order_relaxed);
+                h.timedCalls += c.timedCalls.load(std::memory_order_relaxed);
+
+                // Re-bucket from ticks to nanoseconds using each bucket's lower bound
+                for (std::size_t i = 0; i < HandlerMetricsSnapshot::BucketCount; ++i) {
+                    const std::uint64_t n = c.ticks[i].load(std::memory_order_relaxed);
+                    if (n == 0) continue;
+                    const double lowerTicks = i == 0 ? 0.0 : static_cast<double>(std::uint64_t{1} << (i - 1));
+                    h.latencyNs[bucketFor(static_cast<std::uint64_t>(lowerTicks / perNs))] += n;
+                }
+
+                const std::uint32_t used = c.reasonCount.load(std::memory_order_acquire);
+                for (std::uint32_t r = 0; r < used; ++r) {
+                    result.rejectionsByReason[h.name + "/" + c.reasons[r].code] +=
+                        c.reasons[r].count.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        return result;
+    }
+};
+
+} // namespace domain::behaviors::chain
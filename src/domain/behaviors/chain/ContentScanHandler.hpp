@@ -0,0 +1,273 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ITicketHandler.hpp"
+#include "TicketCreationRequest.hpp"
+#include "../../util/AhoCorasick.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace domain::behaviors::chain {
+
+enum class ContentCategory : std::uint8_t {
+    CARD_NUMBER,
+    SECRET,
+    ABUSE
+};
+
+constexpr std::size_t ContentCategoryCount = 3;
+
+enum class ContentAction : std::uint8_t {
+    ALLOW,
+    FLAG,
+    REJECT
+};
+
+struct ContentScanResult {
+    // Bit per ContentCategory
+    std::uint8_t categories = 0;
+    std::string firstMatch;
+
+    bool has(ContentCategory c) const {
+        return (categories >> static_cast<unsigned>(c)) & 1u;
+    }
+};
+
+class ContentScanner;
+
+struct ContentPatternLoadResult {
+    // Never null: without a readable file it only finds card numbers
+    std::shared_ptr<ContentScanner> scanner;
+    bool ok = false;
+    std::size_t patternCount = 0;
+    std::string error;
+};
+
+// Finds PII and abusive terms in ticket descriptions: keyword patterns go
+// through one Aho-Corasick automaton, card numbers are found by scanning digit
+// runs and confirming them with the Luhn checksum. Immutable once built, so a
+// single scanner can be shared by all threads.
+class ContentScanner {
+private:
+    std::vector<std::string> patterns;
+    std::vector<ContentCategory> patternCategory;
+    AhoCorasick automaton;
+
+    static bool luhnValid(const char* digits, std::size_t count) {
+        unsigned sum = 0;
+        bool twice = false;
+        for (std::size_t i = count; i-- > 0;) {
+            unsigned d = static_cast<unsigned>(digits[i] - '0');
+            if (twice) {
+                d *= 2;
+                if (d > 9) d -= 9;
+            }
+            sum += d;
+            twice = !twice;
+        }
+        return sum % 10 == 0;
+    }
+
+    static std::size_t nextDigit(std::string_view text, std::size_t i) {
+#if defined(__SSE2__)
+        const __m128i zeroChar = _mm_set1_epi8('0');
+        const __m128i nine = _mm_set1_epi8(9);
+        while (i + 16 <= text.size()) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+            // (c - '0') as unsigned <= 9  <=>  min(c - '0', 9) == c - '0'
+            const __m128i d = _mm_sub_epi8(block, zeroChar);
+            const int bits = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(d, nine), d));
+            if (bits) return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(bits)));
+            i += 16;
+        }
+#endif
+        while (i < text.size() && (text[i] < '0' || text[i] > '9')) ++i;
+        return i;
+    }
+
+    // Digit runs of 13-19 digits, optionally grouped with spaces or dashes.
+    static bool containsCardNumber(std::string_view text) {
+        char digits[19];
+        std::size_t count = 0;
+        bool overflow = false;
+
+        auto finishRun = [&]() {
+            const bool card = !overflow && count >= 13 && luhnValid(digits, count);
+            count = 0;
+            overflow = false;
+            return card;
+        };
+
+        for (std::size_t i = nextDigit(text, 0); i < text.size(); ++i) {
+            const char c = text[i];
+            if (c >= '0' && c <= '9') {
+                if (count < sizeof(digits)) digits[count++] = c;
+                else overflow = true;
+            } else if ((c == ' ' || c == '-') && count > 0 &&
+                       i + 1 < text.size() && text[i + 1] >= '0' && text[i + 1] <= '9') {
+                continue;
+            } else if (count > 0) {
+                if (finishRun()) return true;
+                i = nextDigit(text, i + 1) - 1;
+            }
+        }
+        return count > 0 && finishRun();
+    }
+
+public:
+    ContentScanner() = default;
+
+    ContentScanner(std::vector<std::string> keywords, std::vector<ContentCategory> categories)
+        : patterns(std::move(keywords))
+        , patternCategory(std::move(categories))
+        , automaton(patterns) {}
+
+    // One pattern per line: "<secret|abuse> <text>"; '#' starts a comment.
+    // Lines that do not fit are skipped and reported in the result.
+    static ContentPatternLoadResult loadFromFile(const std::string& path);
+
+    ContentScanResult scan(std::string_view text) const {
+        ContentScanResult result;
+
+        automaton.forEachMatch(text, [&](std::size_t pattern, std::size_t) {
+            result.categories |= static_cast<std::uint8_t>(
+                1u << static_cast<unsigned>(patternCategory[pattern]));
+            if (result.firstMatch.empty()) result.firstMatch = patterns[pattern];
+            return true;
+        });
+
+        if (containsCardNumber(text))
+            result.categories |= 1u << static_cast<unsigned>(ContentCategory::CARD_NUMBER);
+
+        return result;
+    }
+
+    std::size_t getPatternCount() const { return automaton.getPatternCount(); }
+    std::size_t getStateCount() const { return automaton.getStateCount(); }
+    std::size_t getMemoryBytes() const { return automaton.getMemoryBytes(); }
+};
+
+inline ContentPatternLoadResult ContentScanner::loadFromFile(const std::string& path) {
+    ContentPatternLoadResult result;
+    std::vector<std::string> keywords;
+    std::vector<ContentCategory> categories;
+
+    std::ifstream in(path);
+    if (!in) result.error = "cannot open " + path;
+
+    std::string line;
+    std::size_t lineNo = 0;
+    auto skip = [&](const std::string& what) {
+        if (!result.error.empty()) result.error += "; ";
+        result.error += "line " + std::to_string(lineNo) + ": " + what;
+    };
+    while (std::getline(in, line)) {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        const std::size_t space = line.find(' ');
+        if (space == std::string::npos || space + 1 >= line.size()) {
+            skip("expected \"<secret|abuse> <text>\"");
+            continue;
+        }
+
+        const std::string kind = line.substr(0, space);
+        if (kind == "secret") categories.push_back(ContentCategory::SECRET);
+        else if (kind == "abuse") categories.push_back(ContentCategory::ABUSE);
+        else {
+            skip("unknown kind \"" + kind + "\"");
+            continue;
+        }
+        keywords.push_back(line.substr(space + 1));
+    }
+
+    result.ok = result.error.empty();
+    result.patternCount = keywords.size();
+    result.scanner = std::make_shared<ContentScanner>(std::move(keywords), std::move(categories));
+    return result;
+}
+
+struct ContentScanPolicy {
+    std::array<ContentAction, ContentCategoryCount> actions = {
+        ContentAction::REJECT,  // CARD_NUMBER
+        ContentAction::REJECT,  // SECRET
+        ContentAction::FLAG     // ABUSE
+    };
+
+    ContentAction actionFor(ContentCategory c) const {
+        return actions[static_cast<std::size_t>(c)];
+    }
+};
+
+class ContentScanRule {
+private:
+    std::shared_ptr<const ContentScanner> scanner;
+    ContentScanPolicy policy;
+
+    static const char* describe(ContentCategory c) {
+        switch (c) {
+            case ContentCategory::CARD_NUMBER: return "card-number";
+            case ContentCategory::SECRET:      return "secret";
+            case ContentCategory::ABUSE:       return "abuse";
+        }
+        return "content";
+    }
+
+public:
+    explicit ContentScanRule(std::shared_ptr<const ContentScanner> s,
+                             ContentScanPolicy p = {})
+        : scanner(std::move(s)), policy(p) {}
+
+    void check(TicketCreationRequest& request) const {
+        const ContentScanResult result = scanner->scan(request.description);
+        if (result.categories == 0) return;
+
+        for (std::size_t i = 0; i < ContentCategoryCount; ++i) {
+            const auto category = static_cast<ContentCategory>(i);
+            if (!result.has(category)) continue;
+
+            switch (policy.actionFor(category)) {
+                case ContentAction::REJECT:
+                    request.valid = false;
+                    request.rejectionCode = describe(category);
+                    request.errorMessage = std::string("Description contains sensitive content (") +
+                                           describe(category) + "). Please remove it.";
+                    return;
+                case ContentAction::FLAG:
+                    request.flags.push_back(describe(category));
+                    break;
+                case ContentAction::ALLOW:
+                    break;
+            }
+        }
+    }
+};
+
+class ContentScanHandler : public ITicketHandler {
+private:
+    ContentScanRule rule;
+
+public:
+    explicit ContentScanHandler(std::shared_ptr<const ContentScanner> scanner,
+                                ContentScanPolicy policy = {})
+        : rule(std::move(scanner), policy) {}
+
+    const char* name() const override { return "content-scan"; }
+
+protected:
+    void process(TicketCreationRequest& request) override {
+        rule.check(request);
+    }
+};
+
+} // namespace domain::behaviors::chain
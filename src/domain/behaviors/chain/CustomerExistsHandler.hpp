@@ -4,25 +4,24 @@
 #include <string>
 
 #include "ITicketHandler.hpp"
+#include "ValidationRules.hpp"
 #include "../../services/CustomerService.hpp"
 
 namespace domain::behaviors::chain {
 
 class CustomerExistsHandler : public ITicketHandler {
 private:
-    domain::CustomerService& customerService;
+    CustomerExistsRule rule;
 
 public:
     explicit CustomerExistsHandler(domain::CustomerService& service)
-        : customerService(service) {}
+        : rule(service) {}
+
+    const char* name() const override { return "customer-exists"; }
 
 protected:
     void process(TicketCreationRequest& request) override {
-        auto customer = customerService.getCustomer(request.customerId);
-        if (!customer) {
-            request.valid = false;
-            request.errorMessage = "Customer does not exist: " + request.customerId;
-        }
+        rule.check(request);
     }
 };
 
@@ -1,24 +1,23 @@
 #pragma once
 
 #include "ITicketHandler.hpp"
+#include "ValidationRules.hpp"
 
 namespace domain::behaviors::chain {
 
 class DescriptionLengthHandler : public ITicketHandler {
 private:
-    std::size_t minLength;
+    DescriptionLengthRule rule;
 
 public:
     explicit DescriptionLengthHandler(std::size_t minLen = 10)
-        : minLength(minLen) {}
+        : rule(minLen) {}
+
+    const char* name() const override { return "description-length"; }
 
 protected:
     void process(TicketCreationRequest& request) override {
-        if (request.description.size() < minLength) {
-            request.valid = false;
-            request.errorMessage =
-                "Description too short. Min length: " + std::to_string(minLength);
-        }
+        rule.check(request);
     }
 };
 
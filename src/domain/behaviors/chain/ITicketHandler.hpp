@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include "ChainMetrics.hpp"
 #include "TicketCreationRequest.hpp"
 
 namespace domain::behaviors::chain {
@@ -9,16 +11,33 @@ class ITicketHandler {
 protected:
     std::shared_ptr<ITicketHandler> next;
 
+private:
+    static constexpr ChainMetrics::Slot Unregistered = ~ChainMetrics::Slot{0};
+    std::atomic<ChainMetrics::Slot> metricsSlot{Unregistered};
+
+    ChainMetrics::Slot slot() {
+        ChainMetrics::Slot s = metricsSlot.load(std::memory_order_relaxed);
+        if (s == Unregistered) {
+            s = ChainMetrics::getInstance().registerHandler(name());
+            metricsSlot.store(s, std::memory_order_relaxed);
+        }
+        return s;
+    }
+
 public:
     virtual ~ITicketHandler() = default;
 
+    // Label under which ChainMetrics reports this handler
+    virtual const char* name() const { return "handler"; }
+
     void setNext(std::shared_ptr<ITicketHandler> nextHandler) {
         next = std::move(nextHandler);
     }
 
     void handle(TicketCreationRequest& request) {
         if (!request.valid) return;
-        process(request);
+        ChainMetrics::getInstance().record(slot(), request,
+            [this](TicketCreationRequest& r) { process(r); });
         if (request.valid && next) {
             next->handle(request);
         }
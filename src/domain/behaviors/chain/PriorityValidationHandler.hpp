@@ -1,19 +1,20 @@
 #pragma once
 
 #include "ITicketHandler.hpp"
+#include "ValidationRules.hpp"
 
 namespace domain::behaviors::chain {
 
 class PriorityValidationHandler : public ITicketHandler {
+private:
+    PriorityRule rule;
+
+public:
+    const char* name() const override { return "priority"; }
+
 protected:
     void process(TicketCreationRequest& request) override {
-        // Example rule: CRITICAL must be longer description
-        if (request.priority == domain::Priority::CRITICAL &&
-            request.description.size() < 20) {
-            request.valid = false;
-            request.errorMessage =
-                "CRITICAL tickets must have detailed descriptions (>= 20 chars).";
-        }
+        rule.check(request);
     }
 };
 
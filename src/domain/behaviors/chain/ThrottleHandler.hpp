@@ -0,0 +1,263 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "ITicketHandler.hpp"
+#include "TicketCreationRequest.hpp"
+#include "../../models/Enums.hpp"
+
+namespace domain::behaviors::chain {
+
+struct RateLimit {
+    double ratePerSecond;
+    double burst;
+};
+
+struct ThrottleConfig {
+    // Per customer, by the customer's type
+    std::array<RateLimit, CustomerTypeCount> perCustomer = {{
+        {2.0, 10.0},     // REGULAR
+        {5.0, 30.0},     // PREMIUM
+        {20.0, 100.0}    // VIP
+    }};
+
+    // Across all customers of a type; ratePerSecond <= 0 disables it
+    std::array<RateLimit, CustomerTypeCount> perType = {{
+        {0.0, 0.0},
+        {0.0, 0.0},
+        {0.0, 0.0}
+    }};
+};
+
+struct ThrottleStats {
+    std::array<std::uint64_t, CustomerTypeCount> allowed{};
+    std::array<std::uint64_t, CustomerTypeCount> rejectedByCustomerLimit{};
+    std::array<std::uint64_t, CustomerTypeCount> rejectedByTypeLimit{};
+    std::size_t trackedCustomers = 0;
+};
+
+// Token buckets for ticket creation, kept as GCRA "theoretical arrival
+// times" so that taking a token is a single compare-and-swap.
+//
+// Customers are spread over cache-line-aligned shards; a shard's map is only
+// locked exclusively when a customer is seen for the first time. Every
+// EvictEvery new customers a shard also drops the buckets that have fully
+// refilled, so memory is bounded by the recently active customers.
+// Counters are kept per shard and summed on read.
+class CustomerThrottle {
+public:
+    enum class Decision { ALLOWED, CUSTOMER_LIMIT, TYPE_LIMIT };
+
+private:
+    static constexpr std::size_t ShardCount = 64;
+    static constexpr std::size_t EvictEvery = 1024;
+
+    struct Bucket {
+        std::atomic<std::int64_t> tat{0};
+    };
+
+    struct alignas(64) PaddedBucket : Bucket {};
+
+    struct alignas(64) Shard {
+        std::shared_mutex mtx;
+        std::unordered_map<std::string, PaddedBucket> buckets;
+        std::size_t insertsSinceEviction = 0;
+
+        std::array<std::atomic<std::uint64_t>, CustomerTypeCount> allowed{};
+        std::array<std::atomic<std::uint64_t>, CustomerTypeCount> rejectedByCustomer{};
+        std::array<std::atomic<std::uint64_t>, CustomerTypeCount> rejectedByType{};
+    };
+
+    struct Gcra {
+        std::int64_t intervalNs = 0;   // time per token
+        std::int64_t toleranceNs = 0;  // burst allowance
+    };
+
+    std::array<Gcra, CustomerTypeCount> customerLimits;
+    std::array<Gcra, CustomerTypeCount> typeLimits;
+    std::array<PaddedBucket, CustomerTypeCount> typeBuckets;
+    std::unique_ptr<Shard[]> shards;
+
+    static Gcra toGcra(const RateLimit& limit) {
+        Gcra g;
+        if (limit.ratePerSecond <= 0) return g;
+        g.intervalNs = static_cast<std::int64_t>(1e9 / limit.ratePerSecond);
+        g.toleranceNs = static_cast<std::int64_t>(g.intervalNs * (limit.burst > 1 ? limit.burst - 1 : 0));
+        return g;
+    }
+
+    static bool take(Bucket& bucket, const Gcra& limit, std::int64_t now) {
+        std::int64_t tat = bucket.tat.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::int64_t start = tat > now ? tat : now;
+            if (start - limit.toleranceNs > now) return false;
+            if (bucket.tat.compare_exchange_weak(tat, start + limit.intervalNs,
+                                                 std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    // Gives back a token taken from a customer bucket when the type limit
+    // rejects the request afterwards.
+    static void refund(Bucket& bucket, const Gcra& limit) {
+        bucket.tat.fetch_sub(limit.intervalNs, std::memory_order_relaxed);
+    }
+
+    Shard& shardFor(const std::string& customerId) const {
+        return shards[std::hash<std::string>{}(customerId) % ShardCount];
+    }
+
+    // Caller holds the shard's lock exclusively
+    static std::size_t evictShard(Shard& shard, std::int64_t now) {
+        std::size_t evicted = 0;
+        for (auto it = shard.buckets.begin(); it != shard.buckets.end();) {
+            if (it->second.tat.load(std::memory_order_relaxed) <= now) {
+                it = shard.buckets.erase(it);
+                ++evicted;
+            } else {
+                ++it;
+            }
+        }
+        shard.insertsSinceEviction = 0;
+        return evicted;
+    }
+
+    // Caller holds the shard's lock, so `bucket` cannot be evicted meanwhile
+    Decision acquire(Shard& shard, Bucket& bucket, std::size_t t, std::int64_t nowNs) {
+        if (customerLimits[t].intervalNs > 0 && !take(bucket, customerLimits[t], nowNs)) {
+            shard.rejectedByCustomer[t].fetch_add(1, std::memory_order_relaxed);
+            return Decision::CUSTOMER_LIMIT;
+        }
+
+        if (typeLimits[t].intervalNs > 0 && !take(typeBuckets[t], typeLimits[t], nowNs)) {
+            if (customerLimits[t].intervalNs > 0) refund(bucket, customerLimits[t]);
+            shard.rejectedByType[t].fetch_add(1, std::memory_order_relaxed);
+            return Decision::TYPE_LIMIT;
+        }
+
+        shard.allowed[t].fetch_add(1, std::memory_order_relaxed);
+        return Decision::ALLOWED;
+    }
+
+public:
+    explicit CustomerThrottle(const ThrottleConfig& config = {})
+        : shards(std::make_unique<Shard[]>(ShardCount))
+    {
+        for (std::size_t t = 0; t < CustomerTypeCount; ++t) {
+            customerLimits[t] = toGcra(config.perCustomer[t]);
+            typeLimits[t] = toGcra(config.perType[t]);
+        }
+    }
+
+    Decision tryAcquire(const std::string& customerId, CustomerType type) {
+        return tryAcquireAt(customerId, type,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    Decision tryAcquireAt(const std::string& customerId, CustomerType type, std::int64_t nowNs) {
+        const auto t = static_cast<std::size_t>(type);
+        Shard& shard = shardFor(customerId);
+        {
+            std::shared_lock<std::shared_mutex> readLock(shard.mtx);
+            auto it = shard.buckets.find(customerId);
+            if (it != shard.buckets.end()) return acquire(shard, it->second, t, nowNs);
+        }
+
+        // New (or evicted) customer: insert and take the token under the write lock
+        std::unique_lock<std::shared_mutex> writeLock(shard.mtx);
+        if (++shard.insertsSinceEviction >= EvictEvery) evictShard(shard, nowNs);
+        return acquire(shard, shard.buckets.try_emplace(customerId).first->second, t, nowNs);
+    }
+
+    // Drops every bucket that has fully refilled. tryAcquire() already does
+    // this shard by shard as customers are added.
+    std::size_t evictIdle() {
+        const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        std::size_t evicted = 0;
+        for (std::size_t i = 0; i < ShardCount; ++i) {
+            std::unique_lock<std::shared_mutex> lock(shards[i].mtx);
+            evicted += evictShard(shards[i], now);
+        }
+        return evicted;
+    }
+
+    ThrottleStats getStats() const {
+        ThrottleStats stats;
+        for (std::size_t i = 0; i < ShardCount; ++i) {
+            Shard& shard = shards[i];
+            for (std::size_t t = 0; t < CustomerTypeCount; ++t) {
+                stats.allowed[t] += shard.allowed[t].load(std::memory_order_relaxed);
+                stats.rejectedByCustomerLimit[t] += shard.rejectedByCustomer[t].load(std::memory_order_relaxed);
+                stats.rejectedByTypeLimit[t] += shard.rejectedByType[t].load(std::memory_order_relaxed);
+            }
+            std::shared_lock<std::shared_mutex> lock(shard.mtx);
+            stats.trackedCustomers += shard.buckets.size();
+        }
+        return stats;
+    }
+};
+
+// Needs request.customerType, so place it after CustomerExistsRule.
+class ThrottleRule {
+public:
+    // True if the request was refused by this rule rather than found invalid
+    static bool rejected(const TicketCreationRequest& request) {
+        return request.rejectionCode == "customer-rate-limit" || request.rejectionCode == "type-rate-limit";
+    }
+
+private:
+    CustomerThrottle& throttle;
+
+public:
+    explicit ThrottleRule(CustomerThrottle& t) : throttle(t) {}
+
+    void check(TicketCreationRequest& request) const {
+        switch (throttle.tryAcquire(request.customerId, request.customerType)) {
+            case CustomerThrottle::Decision::ALLOWED:
+                return;
+            case CustomerThrottle::Decision::CUSTOMER_LIMIT:
+                request.valid = false;
+                request.rejectionCode = "customer-rate-limit";
+                request.errorMessage = "Too many tickets from customer " + request.customerId +
+                                       ". Please try again later.";
+                return;
+            case CustomerThrottle::Decision::TYPE_LIMIT:
+                request.valid = false;
+                request.rejectionCode = "type-rate-limit";
+                request.errorMessage = "Ticket intake is busy. Please try again later.";
+                return;
+        }
+    }
+};
+
+class ThrottleHandler : public ITicketHandler {
+private:
+    std::shared_ptr<CustomerThrottle> throttle;
+    ThrottleRule rule;
+
+public:
+    explicit ThrottleHandler(std::shared_ptr<CustomerThrottle> t)
+        : throttle(std::move(t)), rule(*throttle) {}
+
+    const char* name() const override { return "throttle"; }
+
+protected:
+    void process(TicketCreationRequest& request) override {
+        rule.check(request);
+    }
+};
+
+} // namespace domain::behaviors::chain
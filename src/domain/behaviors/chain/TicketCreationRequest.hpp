@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "../../models/Enums.hpp"
 
 namespace domain::behaviors::chain {
@@ -8,11 +9,20 @@ namespace domain::behaviors::chain {
 struct TicketCreationRequest {
     std::string customerId;
     std::string description;
-    domain::Priority priority;
-    domain::TicketCategory category;
+    domain::Priority priority = domain::Priority::MEDIUM;
+    domain::TicketCategory category = domain::TicketCategory::GENERAL;
+
+    // Filled in by CustomerExistsRule once the customer is found
+    domain::CustomerType customerType = domain::CustomerType::REGULAR;
 
     bool valid = true;
     std::string errorMessage;
+
+    // Short, stable reason for a rejection, used to group ChainMetrics counts
+    std::string rejectionCode;
+
+    // Findings that do not reject the ticket (e.g. "abuse")
+    std::vector<std::string> flags;
 };
 
 } // namespace domain::behaviors::chain
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+
+#include "ContentScanHandler.hpp"
+#include "ThrottleHandler.hpp"
+#include "TicketCreationRequest.hpp"
+#include "ValidationPipeline.hpp"
+#include "ValidationRuleEngine.hpp"
+
+namespace domain::behaviors::chain {
+
+// The configured pipelines together with the rule engine, rate limits and
+// content scanner they refer to. Built once per process and shared by every
+// front end (menu, batch mode, HTTP, RPC), so they all apply the same rules
+// and limits and report into the same ChainMetrics. validate*() may be
+// called from many threads at once.
+class TicketValidation {
+private:
+    CustomerThrottle throttle;
+    ValidationRuleEngine engine;
+    std::shared_ptr<const ContentScanner> scanner;
+
+    ConfiguredValidationPipeline pipeline;
+    UnthrottledValidationPipeline unthrottled;
+    ValidationPipeline<Instrumented<RuleEngineRule>, Instrumented<ContentScanRule>> contentOnly;
+
+public:
+    // Starts with the engine's built-in rules; load a rules file through
+    // getRuleEngine(). Without a scanner only card numbers are found.
+    TicketValidation(domain::CustomerService& customerService,
+                     std::shared_ptr<const ContentScanner> contentScanner,
+                     const ThrottleConfig& limits = {})
+        : throttle(limits)
+        , scanner(contentScanner ? std::move(contentScanner) : std::make_shared<const ContentScanner>())
+        , pipeline(makeConfiguredValidationPipeline(customerService, throttle, engine, scanner))
+        , unthrottled(makeUnthrottledValidationPipeline(customerService, engine, scanner))
+        , contentOnly(Instrumented<RuleEngineRule>("rule-engine", RuleEngineRule(engine)),
+                      Instrumented<ContentScanRule>("content-scan", ContentScanRule(scanner))) {}
+
+    // The pipelines refer to the members above
+    TicketValidation(const TicketValidation&) = delete;
+    TicketValidation& operator=(const TicketValidation&) = delete;
+
+    // CustomerExists -> Throttle -> rules -> content scan
+    bool validate(TicketCreationRequest& request) const { return pipeline.validate(request); }
+
+    // The same without the rate limits, for trusted bulk input
+    bool validateUnthrottled(TicketCreationRequest& request) const { return unthrottled.validate(request); }
+
+    // Rules and content scan only, for the first ticket of a customer who is
+    // registered together with it
+    bool validateForNewCustomer(TicketCreationRequest& request) const { return contentOnly.validate(request); }
+
+    ValidationRuleEngine& getRuleEngine() { return engine; }
+    const CustomerThrottle& getThrottle() const { return throttle; }
+};
+
+} // namespace domain::behaviors::chain
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include "ChainMetrics.hpp"
+#include "TicketCreationRequest.hpp"
+#include "ValidationRules.hpp"
+#include "ValidationRuleEngine.hpp"
+#include "ContentScanHandler.hpp"
+#include "ThrottleHandler.hpp"
+
+namespace domain::behaviors::chain {
+
+// Compile-time counterpart of the ITicketHandler chain: the stages are fixed
+// by the template arguments, so validate() is a single inlinable function
+// with no allocation or virtual dispatch. Stages are only read, so one
+// pipeline can be shared by all requests and threads.
+//
+// Use the ITicketHandler chain when the set of rules is decided at runtime.
+template <typename... Stages>
+class ValidationPipeline {
+private:
+    std::tuple<Stages...> stages;
+
+public:
+    explicit ValidationPipeline(Stages... s)
+        : stages(std::move(s)...) {}
+
+    bool validate(TicketCreationRequest& request) const {
+        if (!request.valid) return false;
+        return std::apply([&request](const auto&... stage) {
+            return ((stage.check(request), request.valid) && ...);
+        }, stages);
+    }
+};
+
+// CustomerExists -> DescriptionLength -> PriorityValidation
+using DefaultValidationPipeline =
+    ValidationPipeline<CustomerExistsRule, DescriptionLengthRule, PriorityRule>;
+
+inline DefaultValidationPipeline makeDefaultValidationPipeline(
+    domain::CustomerService& customerService,
+    std::size_t minDescriptionLength = 10)
+{
+    return DefaultValidationPipeline(
+        CustomerExistsRule(customerService),
+        DescriptionLengthRule(minDescriptionLength),
+        PriorityRule());
+}
+
+// Stage wrapper that records the rule in ChainMetrics, under the same name as
+// the equivalent chain handler.
+template <typename Rule>
+class Instrumented {
+private:
+    Rule rule;
+    ChainMetrics::Slot slot;
+
+public:
+    Instrumented(const char* name, Rule r)
+        : rule(std::move(r)), slot(ChainMetrics::getInstance().registerHandler(name)) {}
+
+    void check(TicketCreationRequest& request) const {
+        ChainMetrics::getInstance().record(slot, request,
+            [this](TicketCreationRequest& r) { rule.check(r); });
+    }
+};
+
+// CustomerExists -> Throttle -> rules from a ValidationRuleEngine -> content scan
+using ConfiguredValidationPipeline =
+    ValidationPipeline<Instrumented<CustomerExistsRule>, Instrumented<ThrottleRule>,
+                       Instrumented<RuleEngineRule>, Instrumented<ContentScanRule>>;
+
+inline ConfiguredValidationPipeline makeConfiguredValidationPipeline(
+    domain::CustomerService& customerService,
+    CustomerThrottle& throttle,
+    const ValidationRuleEngine& engine,
+    std::shared_ptr<const ContentScanner> scanner)
+{
+    return ConfiguredValidationPipeline(
+        Instrumented<CustomerExistsRule>("customer-exists", CustomerExistsRule(customerService)),
+        Instrumented<ThrottleRule>("throttle", ThrottleRule(throttle)),
+        Instrumented<RuleEngineRule>("rule-engine", RuleEngineRule(engine)),
+        Instrumented<ContentScanRule>("content-scan", ContentScanRule(std::move(scanner))));
+}
+
+// The configured pipeline without the throttle, for input that is trusted to
+// arrive in bulk (e.g. a batch script replaying a day of tickets)
+using UnthrottledValidationPipeline =
+    ValidationPipeline<Instrumented<CustomerExistsRule>, Instrumented<RuleEngineRule>,
+                       Instrumented<ContentScanRule>>;
+
+inline UnthrottledValidationPipeline makeUnthrottledValidationPipeline(
+    domain::CustomerService& customerService,
+    const ValidationRuleEngine& engine,
+    std::shared_ptr<const ContentScanner> scanner)
+{
+    return UnthrottledValidationPipeline(
+        Instrumented<CustomerExistsRule>("customer-exists", CustomerExistsRule(customerService)),
+        Instrumented<RuleEngineRule>("rule-engine", RuleEngineRule(engine)),
+        Instrumented<ContentScanRule>("content-scan", ContentScanRule(std::move(scanner))));
+}
+
+} // namespace domain::behaviors::chain
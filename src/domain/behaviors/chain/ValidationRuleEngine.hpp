@@ -0,0 +1,471 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ITicketHandler.hpp"
+#include "TicketCreationRequest.hpp"
+#include "../../models/Enums.hpp"
+
+namespace domain::behaviors::chain {
+
+// Validation rules loaded from a text file, one rule per line:
+//
+//   rule priority=CRITICAL min_length=20 message="CRITICAL tickets need details"
+//   rule category=BILLING,COMPLAINT customer=REGULAR not_contains="password" message=...
+//
+// Conditions (priority, category, customer) take comma-separated enum names
+// and default to "any". Checks: min_length, max_length, contains, not_contains
+// (case-insensitive substrings). code names the rule in ChainMetrics
+// (default "line-<n>"). message must be the last key on the line.
+// Lines starting with '#' are comments.
+//
+// Rules are compiled into a flat table with one cell per
+// (priority, category, customer type); each cell holds only the checks that
+// apply to it, in file order.
+
+struct RuleLoadResult {
+    bool ok = false;
+    std::size_t ruleCount = 0;
+    std::string error;
+};
+
+class ValidationRuleEngine {
+public:
+    static constexpr const char* DefaultRules =
+        "rule min_length=10 code=too-short message=\"Description too short. Min length: 10\"\n"
+        "rule priority=CRITICAL min_length=20 code=critical-too-short "
+        "message=\"CRITICAL tickets must have detailed descriptions (>= 20 chars).\"\n";
+
+private:
+    enum class CheckKind : std::uint8_t { MIN_LENGTH, MAX_LENGTH, CONTAINS, NOT_CONTAINS };
+
+    struct Check {
+        CheckKind kind;
+        std::uint32_t length;
+        std::uint32_t pattern;
+        std::uint32_t message;
+    };
+
+    struct Cell {
+        // Fast path: a description inside [minLength, maxLength] passes
+        // every length check of the cell at once.
+        std::size_t minLength = 0;
+        std::size_t maxLength = std::numeric_limits<std::size_t>::max();
+        bool hasPatterns = false;
+        std::vector<Check> checks;
+    };
+
+    static constexpr std::size_t CellCount =
+        PriorityCount * TicketCategoryCount * CustomerTypeCount;
+
+    struct DecisionTable {
+        std::array<Cell, CellCount> cells;
+        std::vector<std::string> patterns;
+        std::vector<std::string> messages;
+        std::vector<std::string> codes;  // parallel to messages
+        std::size_t ruleCount = 0;
+    };
+
+    std::shared_ptr<const DecisionTable> table;
+    std::atomic<std::uint64_t> generation{0};
+
+    std::mutex reloadMtx;
+    std::string sourcePath;
+    std::filesystem::file_time_type sourceTime{};
+
+    std::condition_variable watchWake;
+    bool watching = false;
+    std::thread watcher;
+
+    static std::atomic<std::uint64_t>& generationCounter() {
+        static std::atomic<std::uint64_t> counter{0};
+        return counter;
+    }
+
+    static std::size_t cellIndex(Priority p, TicketCategory c, CustomerType t) {
+        return (static_cast<std::size_t>(p) * TicketCategoryCount +
+                static_cast<std::size_t>(c)) * CustomerTypeCount +
+               static_cast<std::size_t>(t);
+    }
+
+    // Readers cache the table per thread and only touch the shared_ptr when
+    // a reload has bumped the generation.
+    const DecisionTable& currentTable() const {
+        struct Cache {
+            const ValidationRuleEngine* owner = nullptr;
+            std::uint64_t generation = 0;
+            std::shared_ptr<const DecisionTable> table;
+        };
+        thread_local Cache cache;
+
+        const std::uint64_t gen = generation.load(std::memory_order_acquire);
+        if (cache.owner != this || cache.generation != gen) {
+            cache.table = std::atomic_load(&table);
+            cache.owner = this;
+            cache.generation = gen;
+        }
+        return *cache.table;
+    }
+
+    void install(std::shared_ptr<const DecisionTable> compiled) {
+        std::atomic_store(&table, std::move(compiled));
+        generation.store(++generationCounter(), std::memory_order_release);
+    }
+
+    static std::string toLower(std::string s) {
+        for (auto& ch : s) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        return s;
+    }
+
+    static bool containsLower(const std::string& haystackLower, const std::string& needleLower) {
+        return haystackLower.find(needleLower) != std::string::npos;
+    }
+
+    // ----------------------------------------------------------
+    // Parsing
+    // ----------------------------------------------------------
+
+    template <std::size_t N>
+    static bool parseEnumList(const std::string& value,
+                              const std::array<const char*, N>& names,
+                              std::array<bool, N>& selected) {
+        std::stringstream ss(value);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            std::size_t i = 0;
+            while (i < N && item != names[i]) ++i;
+            if (i == N) return false;
+            selected[i] = true;
+        }
+        return true;
+    }
+
+    static bool nextToken(const std::string& line, std::size_t& pos,
+                          std::string& key, std::string& value) {
+        while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) ++pos;
+        if (pos >= line.size()) return false;
+
+        std::size_t end = pos;
+        while (end < line.size() && line[end] != '=' &&
+               !std::isspace(static_cast<unsigned char>(line[end]))) ++end;
+
+        key = line.substr(pos, end - pos);
+        pos = end;
+        if (end >= line.size() || line[end] != '=') {
+            value.clear();
+            return true;
+        }
+        ++pos;
+
+        if (key == "message") {
+            value = line.substr(pos);
+            pos = line.size();
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+                value = value.substr(1, value.size() - 2);
+            return true;
+        }
+
+        value.clear();
+        if (pos < line.size() && line[pos] == '"') {
+            const std::size_t close = line.find('"', pos + 1);
+            if (close == std::string::npos) return false;
+            value = line.substr(pos + 1, close - pos - 1);
+            pos = close + 1;
+        } else {
+            while (pos < line.size() && !std::isspace(static_cast<unsigned char>(line[pos])))
+                value.push_back(line[pos++]);
+        }
+        return true;
+    }
+
+    static std::shared_ptr<const DecisionTable> compile(std::istream& in, RuleLoadResult& result) {
+        static const std::array<const char*, PriorityCount> priorityNames =
+            {"LOW", "MEDIUM", "HIGH", "CRITICAL"};
+        static const std::array<const char*, TicketCategoryCount> categoryNames =
+            {"TECHNICAL", "BILLING", "GENERAL", "COMPLAINT", "FEATURE_REQUEST"};
+        static const std::array<const char*, CustomerTypeCount> customerNames =
+            {"REGULAR", "PREMIUM", "VIP"};
+
+        auto compiled = std::make_shared<DecisionTable>();
+
+        std::string line;
+        std::size_t lineNo = 0;
+        while (std::getline(in, line)) {
+            ++lineNo;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+
+            std::size_t pos = 0;
+            std::string key, value;
+            if (!nextToken(line, pos, key, value) || key.empty() || key[0] == '#') continue;
+
+            auto fail = [&](const std::string& what) {
+                result.ok = false;
+                result.error = "line " + std::to_string(lineNo) + ": " + what;
+                return nullptr;
+            };
+
+            if (key != "rule") return fail("expected 'rule', got '" + key + "'");
+
+            std::array<bool, PriorityCount> priorities{};
+            std::array<bool, TicketCategoryCount> categories{};
+            std::array<bool, CustomerTypeCount> customers{};
+            bool anyPriority = true, anyCategory = true, anyCustomer = true;
+            std::vector<Check> checks;
+            std::string message;
+            std::string code;
+
+            while (nextToken(line, pos, key, value)) {
+                if (key == "priority") {
+                    anyPriority = false;
+                    if (!parseEnumList(value, priorityNames, priorities))
+                        return fail("unknown priority in '" + value + "'");
+                } else if (key == "category") {
+                    anyCategory = false;
+                    if (!parseEnumList(value, categoryNames, categories))
+                        return fail("unknown category in '" + value + "'");
+                } else if (key == "customer") {
+                    anyCustomer = false;
+                    if (!parseEnumList(value, customerNames, customers))
+                        return fail("unknown customer type in '" + value + "'");
+                } else if (key == "min_length" || key == "max_length") {
+                    std::uint32_t n = 0;
+                    try {
+                        n = static_cast<std::uint32_t>(std::stoul(value));
+                    } catch (const std::exception&) {
+                        return fail("invalid length '" + value + "'");
+                    }
+                    checks.push_back(Check{
+                        key == "min_length" ? CheckKind::MIN_LENGTH : CheckKind::MAX_LENGTH, n, 0, 0});
+                } else if (key == "contains" || key == "not_contains") {
+                    if (value.empty()) return fail("empty pattern");
+                    compiled->patterns.push_back(toLower(value));
+                    checks.push_back(Check{
+                        key == "contains" ? CheckKind::CONTAINS : CheckKind::NOT_CONTAINS, 0,
+                        static_cast<std::uint32_t>(compiled->patterns.size() - 1), 0});
+                } else if (key == "code") {
+                    code = value;
+                } else if (key == "message") {
+                    message = value;
+                } else {
+                    return fail("unknown key '" + key + "'");
+                }
+            }
+
+            if (checks.empty()) return fail("rule has no checks");
+            if (message.empty()) message = "Ticket rejected by validation rule on line " +
+                                           std::to_string(lineNo) + ".";
+
+            if (code.empty()) code = "line-" + std::to_string(lineNo);
+
+            compiled->messages.push_back(message);
+            compiled->codes.push_back(code);
+            const auto messageIndex = static_cast<std::uint32_t>(compiled->messages.size() - 1);
+            for (auto& c : checks) c.message = messageIndex;
+
+            for (std::size_t p = 0; p < PriorityCount; ++p) {
+                if (!anyPriority && !priorities[p]) continue;
+                for (std::size_t c = 0; c < TicketCategoryCount; ++c) {
+                    if (!anyCategory && !categories[c]) continue;
+                    for (std::size_t t = 0; t < CustomerTypeCount; ++t) {
+                        if (!anyCustomer && !customers[t]) continue;
+
+                        Cell& cell = compiled->cells[cellIndex(
+                            static_cast<Priority>(p), static_cast<TicketCategory>(c),
+                            static_cast<CustomerType>(t))];
+                        for (const auto& check : checks) {
+                            cell.checks.push_back(check);
+                            switch (check.kind) {
+                                case CheckKind::MIN_LENGTH:
+                                    cell.minLength = std::max<std::size_t>(cell.minLength, check.length);
+                                    break;
+                                case CheckKind::MAX_LENGTH:
+                                    cell.maxLength = std::min<std::size_t>(cell.maxLength, check.length);
+                                    break;
+                                default:
+                                    cell.hasPatterns = true;
+                                    break;
+                            }
+                        }
+                    }
+                }
+            }
+            ++compiled->ruleCount;
+        }
+
+        result.ok = true;
+        result.ruleCount = compiled->ruleCount;
+        return compiled;
+    }
+
+public:
+    ValidationRuleEngine() {
+        loadFromString(DefaultRules);
+    }
+
+    ValidationRuleEngine(const ValidationRuleEngine&) = delete;
+    ValidationRuleEngine& operator=(const ValidationRuleEngine&) = delete;
+
+    ~ValidationRuleEngine() {
+        stopWatching();
+    }
+
+    // A failed load keeps the previously installed rules.
+    RuleLoadResult loadFromString(const std::string& rules) {
+        std::istringstream in(rules);
+        RuleLoadResult result;
+        auto compiled = compile(in, result);
+        if (result.ok) install(std::move(compiled));
+        return result;
+    }
+
+    RuleLoadResult loadFromFile(const std::string& path) {
+        std::lock_guard<std::mutex> lock(reloadMtx);
+
+        RuleLoadResult result;
+        std::ifstream in(path);
+        if (!in) {
+            result.error = "cannot open " + path;
+            return result;
+        }
+
+        std::error_code ec;
+        auto mtime = std::filesystem::last_write_time(path, ec);
+
+        auto compiled = compile(in, result);
+        if (result.ok) {
+            install(std::move(compiled));
+            sourcePath = path;
+            sourceTime = mtime;
+        }
+        return result;
+    }
+
+    // Re-reads the file given to loadFromFile() if it changed on disk.
+    // Validation keeps running on the old table while the new one compiles.
+    bool reloadIfChanged() {
+        std::string path;
+        std::filesystem::file_time_type knownTime;
+        {
+            std::lock_guard<std::mutex> lock(reloadMtx);
+            if (sourcePath.empty()) return false;
+            path = sourcePath;
+            knownTime = sourceTime;
+        }
+
+        std::error_code ec;
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec || mtime == knownTime) return false;
+        return loadFromFile(path).ok;
+    }
+
+    void startWatching(std::chrono::milliseconds interval = std::chrono::seconds(1)) {
+        std::lock_guard<std::mutex> lock(reloadMtx);
+        if (watching) return;
+        watching = true;
+        watcher = std::thread([this, interval] {
+            std::unique_lock<std::mutex> lk(reloadMtx);
+            while (!watchWake.wait_for(lk, interval, [this] { return !watching; })) {
+                lk.unlock();
+                reloadIfChanged();
+                lk.lock();
+            }
+        });
+    }
+
+    void stopWatching() {
+        {
+            std::lock_guard<std::mutex> lock(reloadMtx);
+            if (!watching) return;
+            watching = false;
+        }
+        watchWake.notify_all();
+        watcher.join();
+    }
+
+    std::size_t getRuleCount() const {
+        return currentTable().ruleCount;
+    }
+
+    void check(TicketCreationRequest& request) const {
+        // Values cast from unchecked input have no cell; reject rather than index past the table
+        if (static_cast<std::size_t>(request.priority) >= PriorityCount ||
+            static_cast<std::size_t>(request.category) >= TicketCategoryCount ||
+            static_cast<std::size_t>(request.customerType) >= CustomerTypeCount) {
+            request.valid = false;
+            request.rejectionCode = "out-of-range";
+            request.errorMessage = "Unknown priority, category or customer type";
+            return;
+        }
+
+        const DecisionTable& t = currentTable();
+        const Cell& cell = t.cells[cellIndex(request.priority, request.category, request.customerType)];
+
+        const std::size_t len = request.description.size();
+        if (!cell.hasPatterns && len >= cell.minLength && len <= cell.maxLength) return;
+
+        std::string lowered;
+        if (cell.hasPatterns) lowered = toLower(request.description);
+
+        for (const auto& c : cell.checks) {
+            bool passed = true;
+            switch (c.kind) {
+                case CheckKind::MIN_LENGTH:   passed = len >= c.length; break;
+                case CheckKind::MAX_LENGTH:   passed = len <= c.length; break;
+                case CheckKind::CONTAINS:     passed = containsLower(lowered, t.patterns[c.pattern]); break;
+                case CheckKind::NOT_CONTAINS: passed = !containsLower(lowered, t.patterns[c.pattern]); break;
+            }
+            if (!passed) {
+                request.valid = false;
+                request.rejectionCode = t.codes[c.message];
+                request.errorMessage = t.messages[c.message];
+                return;
+            }
+        }
+    }
+};
+
+// Pipeline stage referring to a shared engine
+class RuleEngineRule {
+private:
+    const ValidationRuleEngine& engine;
+
+public:
+    explicit RuleEngineRule(const ValidationRuleEngine& e) : engine(e) {}
+
+    void check(TicketCreationRequest& request) const {
+        engine.check(request);
+    }
+};
+
+// Chain handler for runtime-assembled chains
+class RuleEngineHandler : public ITicketHandler {
+private:
+    std::shared_ptr<const ValidationRuleEngine> engine;
+
+public:
+    explicit RuleEngineHandler(std::shared_ptr<const ValidationRuleEngine> e)
+        : engine(std::move(e)) {}
+
+    const char* name() const override { return "rule-engine"; }
+
+protected:
+    void process(TicketCreationRequest& request) override {
+        engine->check(request);
+    }
+};
+
+} // namespace domain::behaviors::chain
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "TicketCreationRequest.hpp"
+#include "../../services/CustomerService.hpp"
+
+namespace domain::behaviors::chain {
+
+// Non-virtual validation steps shared by the dynamic handlers and
+// ValidationPipeline. Each rule only reads its own configuration, so a single
+// instance can be used concurrently.
+
+class CustomerExistsRule {
+private:
+    domain::CustomerService& customerService;
+
+public:
+    explicit CustomerExistsRule(domain::CustomerService& service)
+        : customerService(service) {}
+
+    void check(TicketCreationRequest& request) const {
+        auto customer = customerService.getCustomer(request.customerId);
+        if (!customer) {
+            request.valid = false;
+            request.rejectionCode = "unknown-customer";
+            request.errorMessage = "Customer does not exist: " + request.customerId;
+            return;
+        }
+        request.customerType = customer->getType();
+    }
+};
+
+class DescriptionLengthRule {
+private:
+    std::size_t minLength;
+
+public:
+    explicit DescriptionLengthRule(std::size_t minLen = 10)
+        : minLength(minLen) {}
+
+    void check(TicketCreationRequest& request) const {
+        if (request.description.size() < minLength) {
+            request.valid = false;
+            request.rejectionCode = "too-short";
+            request.errorMessage =
+                "Description too short. Min length: " + std::to_string(minLength);
+        }
+    }
+};
+
+class PriorityRule {
+public:
+    void check(TicketCreationRequest& request) const {
+        // Example rule: CRITICAL must be longer description
+        if (request.priority == domain::Priority::CRITICAL &&
+            request.description.size() < 20) {
+            request.valid = false;
+            request.rejectionCode = "critical-too-short";
+            request.errorMessage =
+                "CRITICAL tickets must have detailed descriptions (>= 20 chars).";
+        }
+    }
+};
+
+} // namespace domain::behaviors::chain
@@ -2,6 +2,8 @@
 
 #include <string>
 #include "../../models/Enums.hpp"
+#include "../../util/Span.hpp"
+#include "TicketEvents.hpp"
 
 namespace domain::behaviors::observer {
 
@@ -14,6 +16,19 @@ public:
                                        TicketStatus newStatus) = 0;
 
     virtual void onTicketCreated(const std::string& ticketId) = 0;
+
+    virtual void onTicketAssigned(const std::string& /*ticketId*/,
+                                  const std::string& /*agent*/) {}
+
+    // Batched delivery from TicketEventBus. Events are in publish order;
+    // override to handle a batch with one log line, notification, etc.
+    virtual void onTicketsCreated(Span<const TicketCreated> events) {
+        for (const auto& e : events) onTicketCreated(e.ticketId);
+    }
+
+    virtual void onStatusChanges(Span<const TicketStatusChanged> events) {
+        for (const auto& e : events) onTicketStatusChanged(e.ticketId, e.oldStatus, e.newStatus);
+    }
 };
 
 } // namespace domain::behaviors::observer
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../util/BoundedQueue.hpp"
+#include "ITicketObserver.hpp"
+#include "TicketEvents.hpp"
+
+namespace domain::behaviors::observer {
+
+enum class OverflowPolicy {
+    BLOCK,   // publisher waits for room (backpressure)
+    DROP     // event is dropped and counted
+};
+
+struct SubscriptionOptions {
+    std::string name = "subscriber";
+    std::size_t queueCapacity = 4096;   // per lane
+    unsigned lanes = 1;                 // worker threads; a ticket always maps to the same lane
+    OverflowPolicy overflow = OverflowPolicy::BLOCK;
+    std::size_t maxBatch = 256;         // events per delivery
+    std::chrono::microseconds maxDelay{200};   // longest a batch waits to fill up
+};
+
+struct SubscriptionStats {
+    std::string name;
+    std::uint64_t published = 0;   // accepted into the queue
+    std::uint64_t delivered = 0;
+    std::uint64_t batches = 0;     // deliveries; delivered / batches is the mean batch size
+    std::uint64_t dropped = 0;
+    std::uint64_t blocked = 0;     // publishes that had to wait for room
+    std::uint64_t failed = 0;      // handler threw
+    std::size_t queued = 0;
+    std::size_t highWater = 0;     // largest queue depth seen
+};
+
+// Publishes ticket events to subscribers asynchronously.
+//
+// Every subscription owns one bounded lock-free queue and one worker thread
+// per lane. publish() copies the event into the lane chosen by the ticket id,
+// so events for one ticket are handled in publish order by a single thread
+// while different tickets proceed in parallel. A slow subscriber only fills
+// its own queue; what happens then is its OverflowPolicy.
+//
+// Workers deliver in batches (see ITicketObserver::onTicketsCreated). The
+// batch size adapts to load: it grows while the queue keeps filling batches,
+// letting a worker wait up to maxDelay for more events, and shrinks back to
+// one when the queue runs dry, so a quiet bus still delivers immediately.
+//
+// The subscriber list is copy-on-write, so publish() takes no lock.
+class TicketEventBus {
+public:
+    using SubscriptionId = std::uint64_t;
+    // Receives a batch in publish order; returns the number of events whose
+    // handling threw
+    using BatchHandler = std::function<std::size_t(std::vector<TicketEvent>&)>;
+
+private:
+    struct Lane {
+        BoundedMpscQueue<TicketEvent> queue;
+        std::mutex mtx;
+        std::condition_variable wake;
+        std::atomic<bool> sleeping{false};
+        std::thread worker;
+
+        std::atomic<std::uint64_t> published{0};
+        std::atomic<std::uint64_t> delivered{0};
+        std::atomic<std::uint64_t> batches{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::uint64_t> blocked{0};
+        std::atomic<std::uint64_t> failed{0};
+        std::atomic<std::size_t> highWater{0};
+
+        explicit Lane(std::size_t capacity) : queue(capacity) {}
+    };
+
+    struct Subscription {
+        SubscriptionId id;
+        SubscriptionOptions options;
+        std::uint32_t eventMask;   // bit per TicketEvent alternative
+        BatchHandler handler;
+        std::vector<std::unique_ptr<Lane>> lanes;
+        std::atomic<bool> stopping{false};
+    };
+
+    using SubscriptionList = std::vector<std::shared_ptr<Subscription>>;
+
+    std::shared_ptr<const SubscriptionList> subscriptions = std::make_shared<const SubscriptionList>();
+    std::mutex writeMtx;   // serializes subscribe/unsubscribe
+    SubscriptionId nextId = 1;
+
+    static void wakeConsumer(Lane& lane) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (lane.sleeping.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(lane.mtx);
+            lane.wake.notify_one();
+        }
+    }
+
+    static void run(Subscription& sub, Lane& lane) {
+        using Clock = std::chrono::steady_clock;
+        const std::size_t maxBatch = std::max<std::size_t>(1, sub.options.maxBatch);
+        std::size_t target = 1;
+        std::vector<TicketEvent> batch;
+        batch.reserve(maxBatch);
+        Clock::time_point firstQueued;
+        TicketEvent event;
+        unsigned idle = 0;
+        for (;;) {
+            while (batch.size() < maxBatch && lane.queue.tryPop(event)) {
+                if (batch.empty()) firstQueued = Clock::now();
+                batch.push_back(std::move(event));
+            }
+
+            if (!batch.empty()) {
+                // Under load, give producers a moment to fill the batch
+                if (batch.size() < target && !sub.stopping.load(std::memory_order_acquire) &&
+                    Clock::now() - firstQueued < sub.options.maxDelay) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                target = batch.size() == maxBatch ? std::min(maxBatch, target * 2)
+                                                  : std::max<std::size_t>(1, target / 2);
+
+                const std::size_t failed = sub.handler(batch);
+                if (failed) lane.failed.fetch_add(failed, std::memory_order_relaxed);
+                lane.batches.fetch_add(1, std::memory_order_relaxed);
+                lane.delivered.fetch_add(batch.size(), std::memory_order_release);
+                batch.clear();
+                idle = 0;
+                continue;
+            }
+            if (sub.stopping.load(std::memory_order_acquire)) return;
+            if (++idle < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(lane.mtx);
+            lane.sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            lane.wake.wait(lock, [&] {
+                return lane.queue.size() > 0 || sub.stopping.load(std::memory_order_acquire);
+            });
+            lane.sleeping.store(false, std::memory_order_relaxed);
+            idle = 0;
+        }
+    }
+
+    static void enqueue(Subscription& sub, Lane& lane, TicketEvent event) {
+        if (!lane.queue.tryPush(std::move(event))) {
+            if (sub.options.overflow == OverflowPolicy::DROP) {
+                lane.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            lane.blocked.fetch_add(1, std::memory_order_relaxed);
+            // tryPush leaves the event intact when it fails
+            for (unsigned spins = 0; !lane.queue.tryPush(std::move(event)); ++spins) {
+                wakeConsumer(lane);
+                if (spins < 64) std::this_thread::yield();
+                else std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+        lane.published.fetch_add(1, std::memory_order_relaxed);
+
+        const std::size_t depth = lane.queue.size();
+        std::size_t high = lane.highWater.load(std::memory_order_relaxed);
+        while (depth > high && !lane.highWater.compare_exchange_weak(high, depth, std::memory_order_relaxed)) {}
+
+        wakeConsumer(lane);
+    }
+
+    static void stop(Subscription& sub) {
+        sub.stopping.store(true, std::memory_order_release);
+        for (auto& lane : sub.lanes) {
+            {
+                std::lock_guard<std::mutex> lock(lane->mtx);
+                lane->wake.notify_one();
+            }
+            if (lane->worker.joinable()) lane->worker.join();
+        }
+    }
+
+    // Calls fn(first, last) for each run of consecutive events of one type,
+    // so a batch can be handed to the typed batch methods without reordering
+    template <typename Fn>
+    static std::size_t forEachRun(std::vector<TicketEvent>& batch, Fn&& fn) {
+        std::size_t failed = 0;
+        for (std::size_t i = 0; i < batch.size();) {
+            std::size_t j = i + 1;
+            while (j < batch.size() && batch[j].index() == batch[i].index()) ++j;
+            try {
+                fn(i, j);
+            } catch (...) {
+                failed += j - i;
+            }
+            i = j;
+        }
+        return failed;
+    }
+
+    template <typename E>
+    static std::vector<E> take(std::vector<TicketEvent>& batch, std::size_t first, std::size_t last) {
+        std::vector<E> out;
+        out.reserve(last - first);
+        for (std::size_t i = first; i < last; ++i) out.push_back(std::move(std::get<E>(batch[i])));
+        return out;
+    }
+
+    SubscriptionId add(BatchHandler handler, std::uint32_t mask, SubscriptionOptions options) {
+        auto sub = std::make_shared<Subscription>();
+        sub->options = std::move(options);
+        sub->eventMask = mask;
+        sub->handler = std::move(handler);
+        const unsigned lanes = std::max(1u, sub->options.lanes);
+        for (unsigned i = 0; i < lanes; ++i)
+            sub->lanes.push_back(std::make_unique<Lane>(sub->options.queueCapacity));
+        for (auto& lane : sub->lanes) {
+            Lane* l = lane.get();
+            Subscription* s = sub.get();
+            lane->worker = std::thread([s, l] { run(*s, *l); });
+        }
+
+        std::lock_guard<std::mutex> lock(writeMtx);
+        sub->id = nextId++;
+        auto list = std::make_shared<SubscriptionList>(*std::atomic_load(&subscriptions));
+        list->push_back(sub);
+        std::atomic_store(&subscriptions, std::shared_ptr<const SubscriptionList>(std::move(list)));
+        return sub->id;
+    }
+
+public:
+    static constexpr std::uint32_t AllEvents = ~std::uint32_t{0};
+
+    TicketEventBus() = default;
+    TicketEventBus(const TicketEventBus&) = delete;
+    TicketEventBus& operator=(const TicketEventBus&) = delete;
+
+    ~TicketEventBus() { shutdown(); }
+
+    // Delivers every event to the observer; consecutive creations and status
+    // changes go to onTicketsCreated() / onStatusChanges() as one batch
+    SubscriptionId subscribe(std::shared_ptr<ITicketObserver> observer, SubscriptionOptions options = {}) {
+        return add([observer = std::move(observer)](std::vector<TicketEvent>& batch) {
+            return forEachRun(batch, [&](std::size_t first, std::size_t last) {
+                if (std::holds_alternative<TicketCreated>(batch[first])) {
+                    observer->onTicketsCreated(take<TicketCreated>(batch, first, last));
+                } else if (std::holds_alternative<TicketStatusChanged>(batch[first])) {
+                    observer->onStatusChanges(take<TicketStatusChanged>(batch, first, last));
+                } else {
+                    for (std::size_t i = first; i < last; ++i) {
+                        const auto& e = std::get<TicketAssigned>(batch[i]);
+                        observer->onTicketAssigned(e.ticketId, e.agent);
+                    }
+                }
+            });
+        }, AllEvents, std::move(options));
+    }
+
+    // Delivers only events of type E, one call per event; other events are
+    // not queued at all
+    template <typename E>
+    SubscriptionId subscribe(std::function<void(const E&)> handler, SubscriptionOptions options = {}) {
+        return add([handler = std::move(handler)](std::vector<TicketEvent>& batch) {
+            std::size_t failed = 0;
+            for (const auto& event : batch) {
+                try {
+                    handler(std::get<E>(event));
+                } catch (...) {
+                    ++failed;
+                }
+            }
+            return failed;
+        }, 1u << TicketEvent(std::in_place_type<E>).index(), std::move(options));
+    }
+
+    // Delivers only events of type E, a batch per call
+    template <typename E>
+    SubscriptionId subscribeBatch(std::function<void(Span<const E>)> handler, SubscriptionOptions options = {}) {
+        return add([handler = std::move(handler)](std::vector<TicketEvent>& batch) {
+            return forEachRun(batch, [&](std::size_t first, std::size_t last) {
+                handler(take<E>(batch, first, last));
+            });
+        }, 1u << TicketEvent(std::in_place_type<E>).index(), std::move(options));
+    }
+
+    // Delivers queued events, then stops the subscription's workers
+    void unsubscribe(SubscriptionId id) {
+        std::shared_ptr<Subscription> removed;
+        {
+            std::lock_guard<std::mutex> lock(writeMtx);
+            auto list = std::make_shared<SubscriptionList>(*std::atomic_load(&subscriptions));
+            auto it = std::find_if(list->begin(), list->end(),
+                                   [id](const auto& s) { return s->id == id; });
+            if (it == list->end()) return;
+            removed = *it;
+            list->erase(it);
+            std::atomic_store(&subscriptions, std::shared_ptr<const SubscriptionList>(std::move(list)));
+        }
+        stop(*removed);
+    }
+
+    void publish(const TicketEvent& event) {
+        const auto list = std::atomic_load(&subscriptions);
+        if (list->empty()) return;
+
+        const std::uint32_t bit = 1u << event.index();
+        const std::size_t hash = std::hash<std::string>{}(ticketIdOf(event));
+        for (const auto& sub : *list) {
+            if (!(sub->eventMask & bit)) continue;
+            Lane& lane = *sub->lanes[hash % sub->lanes.size()];
+            enqueue(*sub, lane, event);
+        }
+    }
+
+    // Waits until every event published so far has been handled
+    void flush() {
+        const auto list = std::atomic_load(&subscriptions);
+        for (const auto& sub : *list) {
+            for (const auto& lane : sub->lanes) {
+                while (lane->delivered.load(std::memory_order_acquire) <
+                       lane->published.load(std::memory_order_relaxed)) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+        }
+    }
+
+    void shutdown() {
+        std::shared_ptr<const SubscriptionList> list;
+        {
+            std::lock_guard<std::mutex> lock(writeMtx);
+            list = std::atomic_load(&subscriptions);
+            std::atomic_store(&subscriptions, std::make_shared<const SubscriptionList>());
+        }
+        for (const auto& sub : *list) stop(*sub);
+    }
+
+    std::vector<SubscriptionStats> getStats() const {
+        std::vector<SubscriptionStats> result;
+        const auto list = std::atomic_load(&subscriptions);
+        for (const auto& sub : *list) {
+            SubscriptionStats s;
+            s.name = sub->options.name;
+            for (const auto& lane : sub->lanes) {
+                s.published += lane->published.load(std::memory_order_relaxed);
+                s.delivered += lane->delivered.load(std::memory_order_relaxed);
+                s.batches += lane->batches.load(std::memory_order_relaxed);
+                s.dropped += lane->dropped.load(std::memory_order_relaxed);
+                s.blocked += lane->blocked.load(std::memory_order_relaxed);
+                s.failed += lane->failed.load(std::memory_order_relaxed);
+                s.queued += lane->queue.size();
+                s.highWater = std::max(s.highWater, lane->highWater.load(std::memory_order_relaxed));
+            }
+            result.push_back(std::move(s));
+        }
+        return result;
+    }
+};
+
+} // namespace domain::behaviors::observer
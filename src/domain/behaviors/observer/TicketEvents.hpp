@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <variant>
+#include "../../models/Enums.hpp"
+
+namespace domain::behaviors::observer {
+
+struct TicketCreated {
+    std::string ticketId;
+    std::string customerId;
+    Priority priority;
+    TicketCategory category;
+};
+
+struct TicketStatusChanged {
+    std::string ticketId;
+    TicketStatus oldStatus;
+    TicketStatus newStatus;
+};
+
+struct TicketAssigned {
+    std::string ticketId;
+    std::string agent;
+};
+
+using TicketEvent = std::variant<TicketCreated, TicketStatusChanged, TicketAssigned>;
+
+inline const std::string& ticketIdOf(const TicketEvent& event) {
+    return std::visit([](const auto& e) -> const std::string& { return e.ticketId; }, event);
+}
+
+} // namespace domain::behaviors::observer
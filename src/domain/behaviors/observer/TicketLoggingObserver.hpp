@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include "../../../domain/interfaces/ILogger.hpp"
+#include "../../../domain/factory/TicketFactory.hpp"
 #include "ITicketObserver.hpp"
 
 namespace domain::behaviors::observer {
@@ -9,18 +12,19 @@ namespace domain::behaviors::observer {
 class TicketLoggingObserver : public ITicketObserver {
 private:
     std::shared_ptr<domain::ILogger> logger;
+    std::size_t idsPerLine;
 
 public:
-    explicit TicketLoggingObserver(std::shared_ptr<domain::ILogger> log)
-        : logger(std::move(log)) {}
+    explicit TicketLoggingObserver(std::shared_ptr<domain::ILogger> log, std::size_t idsPerLine = 100)
+        : logger(std::move(log)), idsPerLine(idsPerLine ? idsPerLine : 1) {}
 
     void onTicketStatusChanged(const std::string& ticketId,
                                TicketStatus oldStatus,
                                TicketStatus newStatus) override {
         if (logger) {
             logger->log("Ticket " + ticketId +
-                        " status changed from " + std::to_string(static_cast<int>(oldStatus)) +
-                        " to " + std::to_string(static_cast<int>(newStatus)));
+                        " status changed from " + domain::TicketFactory::getStatusName(oldStatus) +
+                        " to " + domain::TicketFactory::getStatusName(newStatus));
         }
     }
 
@@ -29,6 +33,51 @@ public:
             logger->log("Ticket created: " + ticketId);
         }
     }
+
+    // One line per idsPerLine tickets instead of one per ticket
+    void onTicketsCreated(Span<const TicketCreated> events) override {
+        if (!logger) return;
+        if (events.size() == 1) {
+            onTicketCreated(events[0].ticketId);
+            return;
+        }
+
+        for (std::size_t i = 0; i < events.size(); i += idsPerLine) {
+            const std::size_t end = std::min(events.size(), i + idsPerLine);
+            std::string line = "Tickets created:";
+            for (std::size_t j = i; j < end; ++j) line += (j > i ? ", " : " ") + events[j].ticketId;
+            logger->log(line);
+        }
+    }
+
+    // One line per run of identical transitions (e.g. a bulk update)
+    void onStatusChanges(Span<const TicketStatusChanged> events) override {
+        if (!logger) return;
+        if (events.size() == 1) {
+            onTicketStatusChanged(events[0].ticketId, events[0].oldStatus, events[0].newStatus);
+            return;
+        }
+
+        for (std::size_t i = 0; i < events.size();) {
+            const TicketStatus from = events[i].oldStatus;
+            const TicketStatus to = events[i].newStatus;
+            std::string line = "Tickets changed from " + domain::TicketFactory::getStatusName(from) +
+                               " to " + domain::TicketFactory::getStatusName(to) + ":";
+            std::size_t j = i;
+            for (; j < events.size() && j - i < idsPerLine &&
+                   events[j].oldStatus == from && events[j].newStatus == to; ++j) {
+                line += (j > i ? ", " : " ") + events[j].ticketId;
+            }
+            logger->log(line);
+            i = j;
+        }
+    }
+
+    void onTicketAssigned(const std::string& ticketId, const std::string& agent) override {
+        if (logger) {
+            logger->log("Ticket " + ticketId + " assigned to " + agent);
+        }
+    }
 };
 
 } // namespace domain::behaviors::observer
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include "../../../domain/services/NotificationService.hpp"
 #include "../../../domain/interfaces/ICustomerRepository.hpp"
+#include "../../../domain/factory/TicketFactory.hpp"
 #include "ITicketObserver.hpp"
 
 namespace domain::behaviors::observer {
@@ -11,11 +13,22 @@ class TicketNotificationObserver : public ITicketObserver {
 private:
     domain::NotificationService& notifier;
     domain::ICustomerRepository& customerRepo;
+    std::size_t idsPerMessage;
+
+    template <typename Event, typename Describe>
+    std::string listTickets(Span<const Event> events, Describe describe) const {
+        const std::size_t listed = std::min(events.size(), idsPerMessage);
+        std::string list;
+        for (std::size_t i = 0; i < listed; ++i) list += (i ? ", " : "") + describe(events[i]);
+        if (listed < events.size()) list += " and " + std::to_string(events.size() - listed) + " more";
+        return list;
+    }
 
 public:
     TicketNotificationObserver(domain::NotificationService& n,
-                               domain::ICustomerRepository& repo)
-        : notifier(n), customerRepo(repo) {}
+                               domain::ICustomerRepository& repo,
+                               std::size_t idsPerMessage = 20)
+        : notifier(n), customerRepo(repo), idsPerMessage(idsPerMessage) {}
 
     void onTicketStatusChanged(const std::string& ticketId,
                                TicketStatus /*oldStatus*/,
@@ -24,13 +37,41 @@ public:
         // For simplicity, we just log-notify:
         notifier.notify("support@example.com",
                         "Ticket " + ticketId + " changed to status " +
-                        std::to_string(static_cast<int>(newStatus)));
+                        domain::TicketFactory::getStatusName(newStatus));
     }
 
     void onTicketCreated(const std::string& ticketId) override {
         notifier.notify("support@example.com",
                         "New ticket created: " + ticketId);
     }
+
+    // A batch is one message per channel rather than one per ticket
+    void onTicketsCreated(Span<const TicketCreated> events) override {
+        if (events.size() == 1) {
+            onTicketCreated(events[0].ticketId);
+            return;
+        }
+        notifier.notify("support@example.com",
+                        std::to_string(events.size()) + " new tickets created: " +
+                        listTickets(events, [](const TicketCreated& e) { return e.ticketId; }));
+    }
+
+    void onStatusChanges(Span<const TicketStatusChanged> events) override {
+        if (events.size() == 1) {
+            onTicketStatusChanged(events[0].ticketId, events[0].oldStatus, events[0].newStatus);
+            return;
+        }
+        notifier.notify("support@example.com",
+                        std::to_string(events.size()) + " tickets changed status: " +
+                        listTickets(events, [](const TicketStatusChanged& e) {
+                            return e.ticketId + " -> " + domain::TicketFactory::getStatusName(e.newStatus);
+                        }));
+    }
+
+    void onTicketAssigned(const std::string& ticketId, const std::string& agent) override {
+        notifier.notify("support@example.com",
+                        "Ticket " + ticketId + " assigned to " + agent);
+    }
 };
 
 } // namespace domain::behaviors::observer
@@ -3,29 +3,49 @@
 #include <memory>
 #include "../../models/Enums.hpp"
 #include "ITicketState.hpp"
+#include "TicketTransitions.hpp"
 
 namespace domain::behaviors::state {
 
+// A ticket's lifecycle is a single TicketStatus byte; transitions are lookups
+// in TransitionTable. The ITicketState objects (see TicketStates.hpp) are
+// stateless flyweights shared by every machine.
 class TicketStateMachine {
 private:
-    std::shared_ptr<ITicketState> current;
+    TicketStatus status;
 
 public:
-    explicit TicketStateMachine(std::shared_ptr<ITicketState> initial)
-        : current(std::move(initial)) {}
+    explicit TicketStateMachine(TicketStatus initial = TicketStatus::OPEN)
+        : status(initial) {}
+
+    explicit TicketStateMachine(const std::shared_ptr<ITicketState>& initial)
+        : status(initial->getStatus()) {}
 
     TicketStatus getStatus() const {
-        return current->getStatus();
+        return status;
     }
 
-    void setState(std::shared_ptr<ITicketState> newState) {
-        current = std::move(newState);
+    // Flyweight for the current status; defined in TicketStates.hpp
+    ITicketState& getState() const;
+
+    void setState(const std::shared_ptr<ITicketState>& newState) {
+        status = newState->getStatus();
+    }
+
+    void setStatus(TicketStatus s) { status = s; }
+
+    // Returns false if the event does not apply in the current status.
+    bool apply(TicketEvent event) {
+        const TicketStatus next = nextStatus(status, event);
+        const bool changed = next != status;
+        status = next;
+        return changed;
     }
 
-    void startProgress() { current->startProgress(*this); }
-    void resolve()       { current->resolve(*this); }
-    void close()         { current->close(*this); }
-    void reopen()        { current->reopen(*this); }
+    void startProgress() { apply(TicketEvent::START_PROGRESS); }
+    void resolve()       { apply(TicketEvent::RESOLVE); }
+    void close()         { apply(TicketEvent::CLOSE); }
+    void reopen()        { apply(TicketEvent::REOPEN); }
 };
 
 } // namespace domain::behaviors::state
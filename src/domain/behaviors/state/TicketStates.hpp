@@ -1,106 +1,65 @@
 #pragma once
 
-#include <memory>
+#include <cstddef>
 #include "../../models/Enums.hpp"
 #include "ITicketState.hpp"
 #include "TicketStateMachine.hpp"
+#include "TicketTransitions.hpp"
 
 namespace domain::behaviors::state {
 
-// ----------------------------------------------------------
-// OPEN STATE
-// ----------------------------------------------------------
-class OpenState : public ITicketState {
+// Every state forwards its operations to TransitionTable, so the classes hold
+// no data and one instance of each (see stateFor) serves all tickets.
+template <TicketStatus Status>
+class TableState : public ITicketState {
 public:
     TicketStatus getStatus() const override {
-        return TicketStatus::OPEN;
+        return Status;
     }
 
-    void startProgress(TicketStateMachine& ctx) override;
-    void resolve(TicketStateMachine& /*ctx*/) override { }
-    void close(TicketStateMachine& /*ctx*/) override { }
-    void reopen(TicketStateMachine& /*ctx*/) override { }
-};
+    void startProgress(TicketStateMachine& ctx) override { transition(ctx, TicketEvent::START_PROGRESS); }
+    void resolve(TicketStateMachine& ctx) override       { transition(ctx, TicketEvent::RESOLVE); }
+    void close(TicketStateMachine& ctx) override         { transition(ctx, TicketEvent::CLOSE); }
+    void reopen(TicketStateMachine& ctx) override        { transition(ctx, TicketEvent::REOPEN); }
 
-// ----------------------------------------------------------
-// IN PROGRESS STATE
-// ----------------------------------------------------------
-class InProgressState : public ITicketState {
-public:
-    TicketStatus getStatus() const override {
-        return TicketStatus::IN_PROGRESS;
+private:
+    static void transition(TicketStateMachine& ctx, TicketEvent event) {
+        ctx.setStatus(nextStatus(Status, event));
     }
-
-    void startProgress(TicketStateMachine& /*ctx*/) override { }
-    void resolve(TicketStateMachine& ctx) override;
-    void close(TicketStateMachine& ctx) override;
-    void reopen(TicketStateMachine& /*ctx*/) override { }
 };
 
 // ----------------------------------------------------------
-// RESOLVED STATE
+// OPEN STATE          startProgress -> IN_PROGRESS
 // ----------------------------------------------------------
-class ResolvedState : public ITicketState {
-public:
-    TicketStatus getStatus() const override {
-        return TicketStatus::RESOLVED;
-    }
-
-    void startProgress(TicketStateMachine& /*ctx*/) override { }
-    void resolve(TicketStateMachine& /*ctx*/) override { }
-    void close(TicketStateMachine& ctx) override;
-    void reopen(TicketStateMachine& ctx) override;
-};
+class OpenState : public TableState<TicketStatus::OPEN> {};
 
 // ----------------------------------------------------------
-// CLOSED STATE
+// IN PROGRESS STATE   resolve -> RESOLVED, close -> CLOSED
 // ----------------------------------------------------------
-class ClosedState : public ITicketState {
-public:
-    TicketStatus getStatus() const override {
-        return TicketStatus::CLOSED;
-    }
-
-    void startProgress(TicketStateMachine& /*ctx*/) override { }
-    void resolve(TicketStateMachine& /*ctx*/) override { }
-    void close(TicketStateMachine& /*ctx*/) override { }
-    void reopen(TicketStateMachine& ctx) override;
-};
-
+class InProgressState : public TableState<TicketStatus::IN_PROGRESS> {};
 
 // ----------------------------------------------------------
-// IMPLEMENTATIONS
-// (Must appear AFTER all classes are declared)
+// RESOLVED STATE      close -> CLOSED, reopen -> OPEN
 // ----------------------------------------------------------
+class ResolvedState : public TableState<TicketStatus::RESOLVED> {};
 
-// OpenState → InProgress
-inline void OpenState::startProgress(TicketStateMachine& ctx) {
-    ctx.setState(std::make_shared<InProgressState>());
-}
-
-// InProgress → Resolved
-inline void InProgressState::resolve(TicketStateMachine& ctx) {
-    ctx.setState(std::make_shared<ResolvedState>());
-}
-
-// InProgress → Closed
-inline void InProgressState::close(TicketStateMachine& ctx) {
-    ctx.setState(std::make_shared<ClosedState>());
-}
-
-// Resolved → Closed
-inline void ResolvedState::close(TicketStateMachine& ctx) {
-    ctx.setState(std::make_shared<ClosedState>());
-}
-
-// Resolved → Open
-inline void ResolvedState::reopen(TicketStateMachine& ctx) {
-    ctx.setState(std::make_shared<OpenState>());
+// ----------------------------------------------------------
+// CLOSED STATE        reopen -> OPEN
+// ----------------------------------------------------------
+class ClosedState : public TableState<TicketStatus::CLOSED> {};
+
+// Shared, stateless instance for a status
+inline ITicketState& stateFor(TicketStatus status) {
+    static OpenState open;
+    static InProgressState inProgress;
+    static ResolvedState resolved;
+    static ClosedState closed;
+    static ITicketState* const states[TicketStatusCount] = {&open, &inProgress, &resolved, &closed};
+    return *states[static_cast<std::size_t>(status)];
 }
 
-// Closed → Open
-inline void ClosedState::reopen(TicketStateMachine& ctx) {
-    ctx.setState(std::make_shared<OpenState>());
+inline ITicketState& TicketStateMachine::getState() const {
+    return stateFor(status);
 }
 
 } // namespace domain::behaviors::state
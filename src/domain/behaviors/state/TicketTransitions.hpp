@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "../../models/Enums.hpp"
+
+namespace domain::behaviors::state {
+
+enum class TicketEvent : std::uint8_t {
+    START_PROGRESS,
+    RESOLVE,
+    CLOSE,
+    REOPEN
+};
+
+constexpr std::size_t TicketEventCount = 4;
+
+// Next status for every (status, event); events that do not apply leave the
+// status unchanged.
+//
+//                 START_PROGRESS  RESOLVE    CLOSE   REOPEN
+//   OPEN          IN_PROGRESS     -          -       -
+//   IN_PROGRESS   -               RESOLVED   CLOSED  -
+//   RESOLVED      -               -          CLOSED  OPEN
+//   CLOSED        -               -          -       OPEN
+constexpr std::array<std::array<TicketStatus, TicketEventCount>, TicketStatusCount> TransitionTable = {{
+    {{TicketStatus::IN_PROGRESS, TicketStatus::OPEN,        TicketStatus::OPEN,        TicketStatus::OPEN}},
+    {{TicketStatus::IN_PROGRESS, TicketStatus::RESOLVED,    TicketStatus::CLOSED,      TicketStatus::IN_PROGRESS}},
+    {{TicketStatus::RESOLVED,    TicketStatus::RESOLVED,    TicketStatus::CLOSED,      TicketStatus::OPEN}},
+    {{TicketStatus::CLOSED,      TicketStatus::CLOSED,      TicketStatus::CLOSED,      TicketStatus::OPEN}},
+}};
+
+constexpr TicketStatus nextStatus(TicketStatus from, TicketEvent event) {
+    return TransitionTable[static_cast<std::size_t>(from)][static_cast<std::size_t>(event)];
+}
+
+// True if some event moves a ticket from `from` to `to` (staying put is not a transition).
+constexpr bool canTransition(TicketStatus from, TicketStatus to) {
+    for (std::size_t e = 0; e < TicketEventCount; ++e) {
+        if (from != to && nextStatus(from, static_cast<TicketEvent>(e)) == to) return true;
+    }
+    return false;
+}
+
+static_assert(nextStatus(TicketStatus::OPEN, TicketEvent::START_PROGRESS) == TicketStatus::IN_PROGRESS);
+static_assert(canTransition(TicketStatus::CLOSED, TicketStatus::OPEN));
+static_assert(!canTransition(TicketStatus::OPEN, TicketStatus::CLOSED));
+
+} // namespace domain::behaviors::state
@@ -7,6 +7,7 @@
 
 #include "../models/Ticket.hpp"
 #include "../models/Enums.hpp"
+#include "../util/Arena.hpp"
 
 namespace domain {
 
@@ -18,26 +19,35 @@ private:
     Priority priority = Priority::MEDIUM;
     TicketCategory category = TicketCategory::GENERAL;
     std::string assignedTo;
-    std::vector<std::string> tags;
+    TagSet tags;
 
 public:
-    TicketBuilder& withId(const std::string& v) { id = v; return *this; }
-    TicketBuilder& withCustomerId(const std::string& v) { customerId = v; return *this; }
-    TicketBuilder& withDescription(const std::string& v) { description = v; return *this; }
+    // Values are taken by value and moved in; pass temporaries or std::move()
+    TicketBuilder& withId(std::string v) { id = std::move(v); return *this; }
+    TicketBuilder& withCustomerId(std::string v) { customerId = std::move(v); return *this; }
+    TicketBuilder& withDescription(std::string v) { description = std::move(v); return *this; }
     TicketBuilder& withPriority(Priority v) { priority = v; return *this; }
     TicketBuilder& withCategory(TicketCategory v) { category = v; return *this; }
-    TicketBuilder& withAssignedTo(const std::string& v) { assignedTo = v; return *this; }
-    TicketBuilder& addTag(const std::string& tag) { tags.push_back(tag); return *this; }
+    TicketBuilder& withAssignedTo(std::string v) { assignedTo = std::move(v); return *this; }
+    TicketBuilder& addTag(const std::string& tag) { tags.add(TagDictionary::getInstance().intern(tag)); return *this; }
+    TicketBuilder& withTags(TagSet v) { tags = std::move(v); return *this; }
 
-    std::shared_ptr<Ticket> build() {
-        auto ticket = std::make_shared<Ticket>(id, customerId, description, priority, category);
+    // Copies the builder's values, so the builder can be reused
+    std::shared_ptr<Ticket> build(Arena* arena = nullptr) const& {
+        return TicketBuilder(*this).build(arena);
+    }
 
-        if (!assignedTo.empty())
-            ticket->setAssignedTo(assignedTo);
+    // Moves the values into the ticket. With an arena, the ticket and its
+    // control block are allocated from it.
+    std::shared_ptr<Ticket> build(Arena* arena = nullptr) && {
+        auto ticket = arena
+            ? arena->make<Ticket>(std::move(id), std::move(customerId), std::move(description), priority, category)
+            : std::make_shared<Ticket>(std::move(id), std::move(customerId), std::move(description), priority, category);
 
-        for (const auto& t : tags)
-            ticket->addTag(t);
+        if (!assignedTo.empty())
+            ticket->setAssignedTo(std::move(assignedTo));
 
+        ticket->setTags(std::move(tags));
         return ticket;
     }
 };
@@ -0,0 +1,68 @@
+#ifndef ENUM_NAMES_HPP
+#define ENUM_NAMES_HPP
+
+#include <cctype>
+#include <cstdlib>
+#include <string>
+
+#include "../models/Enums.hpp"
+#include "CustomerFactory.hpp"
+#include "TicketFactory.hpp"
+
+namespace domain {
+
+// Enum values from text written by people or other systems: the factory
+// display name in any case ("In Progress", "in progress"), the enum
+// identifier ("IN_PROGRESS", "in-progress") or the number ("1").
+namespace enum_names {
+
+inline std::string normalized(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == ' ' || c == '-') out.push_back('_');
+        else out.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+    }
+    return out;
+}
+
+template <typename E, typename NameFn>
+inline bool parse(const std::string& text, std::size_t count, NameFn name, E& out) {
+    if (!text.empty() && std::isdigit(static_cast<unsigned char>(text[0]))) {
+        char* endp = nullptr;
+        const unsigned long n = std::strtoul(text.c_str(), &endp, 10);
+        if (*endp != '\0' || n >= count) return false;
+        out = static_cast<E>(n);
+        return true;
+    }
+    const std::string wanted = normalized(text);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (normalized(name(static_cast<E>(i))) == wanted) {
+            out = static_cast<E>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace enum_names
+
+inline bool parseTicketStatus(const std::string& text, TicketStatus& out) {
+    return enum_names::parse(text, TicketStatusCount, TicketFactory::getStatusName, out);
+}
+
+inline bool parsePriority(const std::string& text, Priority& out) {
+    return enum_names::parse(text, PriorityCount, TicketFactory::getPriorityName, out);
+}
+
+inline bool parseTicketCategory(const std::string& text, TicketCategory& out) {
+    return enum_names::parse(text, TicketCategoryCount, TicketFactory::getCategoryName, out);
+}
+
+inline bool parseCustomerType(const std::string& text, CustomerType& out) {
+    return enum_names::parse(text, CustomerTypeCount, CustomerFactory::getTypeName, out);
+}
+
+} // namespace domain
+
+#endif
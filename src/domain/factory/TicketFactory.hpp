@@ -8,6 +8,7 @@
 #include "../models/Ticket.hpp"
 #include "../models/Enums.hpp"
 #include "../builder/TicketBuilder.hpp"
+#include "../util/Arena.hpp"
 
 namespace domain {
 
@@ -16,12 +17,14 @@ class AbstractTicketFactory {
 public:
     virtual ~AbstractTicketFactory() = default;
 
+    // With an arena, the ticket is allocated from it (see TicketService::createTickets)
     virtual std::shared_ptr<Ticket> createTicket(
-        const std::string& id,
-        const std::string& customerId,
-        const std::string& description,
+        std::string id,
+        std::string customerId,
+        std::string description,
         Priority priority,
-        TicketCategory category
+        TicketCategory category,
+        Arena* arena = nullptr
     ) = 0;
 };
 
@@ -29,30 +32,29 @@ public:
 class TicketFactory : public AbstractTicketFactory {
 public:
     std::shared_ptr<Ticket> createTicket(
-        const std::string& id,
-        const std::string& customerId,
-        const std::string& description,
+        std::string id,
+        std::string customerId,
+        std::string description,
         Priority priority,
-        TicketCategory category
+        TicketCategory category,
+        Arena* arena = nullptr
     ) override
     {
         TicketBuilder builder;
 
         builder
-            .withId(id)
-            .withCustomerId(customerId)
-            .withDescription(description)
+            .withId(std::move(id))
+            .withCustomerId(std::move(customerId))
+            .withDescription(std::move(description))
             .withPriority(priority)
-            .withCategory(category);
+            .withCategory(category)
+            .withTags(getDefaultTagSet(category));
 
         auto agent = getAutoAssignedAgent(priority);
         if (!agent.empty())
-            builder.withAssignedTo(agent);
+            builder.withAssignedTo(std::move(agent));
 
-        for (const auto& tag : getDefaultTags(category))
-            builder.addTag(tag);
-
-        return builder.build();
+        return std::move(builder).build(arena);
     }
 
     static std::string getAutoAssignedAgent(Priority p) {
@@ -63,17 +65,43 @@ public:
         }
     }
 
-    static std::vector<std::string> getDefaultTags(TicketCategory c) {
-        std::vector<std::string> tags = {"new"};
+    // Built once per category; callers copy what they keep
+    static const std::vector<std::string>& getDefaultTags(TicketCategory c) {
+        static const std::vector<std::string> technical = {"new", "technical-support"};
+        static const std::vector<std::string> billing = {"new", "finance"};
+        static const std::vector<std::string> complaint = {"new", "urgent"};
+        static const std::vector<std::string> featureRequest = {"new", "product"};
+        static const std::vector<std::string> other = {"new"};
+
+        switch(c) {
+            case TicketCategory::TECHNICAL:       return technical;
+            case TicketCategory::BILLING:         return billing;
+            case TicketCategory::COMPLAINT:       return complaint;
+            case TicketCategory::FEATURE_REQUEST: return featureRequest;
+            default:                              return other;
+        }
+    }
+
+    // getDefaultTags() as interned ids
+    static const TagSet& getDefaultTagSet(TicketCategory c) {
+        static const auto toSet = [](TicketCategory category) {
+            TagSet set;
+            for (const auto& tag : getDefaultTags(category)) set.add(TagDictionary::getInstance().intern(tag));
+            return set;
+        };
+        static const TagSet technical = toSet(TicketCategory::TECHNICAL);
+        static const TagSet billing = toSet(TicketCategory::BILLING);
+        static const TagSet complaint = toSet(TicketCategory::COMPLAINT);
+        static const TagSet featureRequest = toSet(TicketCategory::FEATURE_REQUEST);
+        static const TagSet other = toSet(TicketCategory::GENERAL);
 
         switch(c) {
-            case TicketCategory::TECHNICAL:       tags.push_back("technical-support"); break;
-            case TicketCategory::BILLING:         tags.push_back("finance"); break;
-            case TicketCategory::COMPLAINT:       tags.push_back("urgent"); break;
-            case TicketCategory::FEATURE_REQUEST: tags.push_back("product"); break;
-            default: break;
+            case TicketCategory::TECHNICAL:       return technical;
+            case TicketCategory::BILLING:         return billing;
+            case TicketCategory::COMPLAINT:       return complaint;
+            case TicketCategory::FEATURE_REQUEST: return featureRequest;
+            default:                              return other;
         }
-        return tags;
     }
 
     static std::string getCategoryName(TicketCategory c) {
@@ -1,6 +1,7 @@
 #ifndef I_CUSTOMER_REPOSITORY_HPP
 #define I_CUSTOMER_REPOSITORY_HPP
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <string>
@@ -15,6 +16,25 @@ public:
     virtual void save(const Customer& customer) = 0;
     virtual std::shared_ptr<Customer> findById(const std::string& id) = 0;
     virtual std::vector<std::shared_ptr<Customer>> findAll() = 0;
+
+    // Up to `limit` customers with ids after `afterId`, in id order (see
+    // ITicketRepository::findPage)
+    virtual std::vector<std::shared_ptr<Customer>> findPage(const std::string& afterId, std::size_t limit) {
+        auto all = findAll();
+        std::sort(all.begin(), all.end(), [](const auto& a, const auto& b) { return a->getId() < b->getId(); });
+        auto first = std::upper_bound(all.begin(), all.end(), afterId,
+                                      [](const std::string& id, const auto& c) { return id < c->getId(); });
+        auto last = first + static_cast<std::ptrdiff_t>(std::min<std::size_t>(limit, static_cast<std::size_t>(all.end() - first)));
+        return std::vector<std::shared_ptr<Customer>>(first, last);
+    }
+
+    // save() for many customers, e.g. an import
+    virtual void saveAll(const std::vector<Customer>& customers) {
+        for (const auto& c : customers) save(c);
+    }
+
+    // False if there was no such customer
+    virtual bool remove(const std::string& id) = 0;
 };
 
 } // namespace domain
@@ -1,10 +1,12 @@
 #ifndef I_TICKET_REPOSITORY_HPP
 #define I_TICKET_REPOSITORY_HPP
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <string>
 #include "../models/Ticket.hpp"
+#include "../models/Tags.hpp"
 
 namespace domain {
 
@@ -15,6 +17,65 @@ public:
     virtual void save(const Ticket& ticket) = 0;
     virtual std::shared_ptr<Ticket> findById(const std::string& id) = 0;
     virtual std::vector<std::shared_ptr<Ticket>> findAll() = 0;
+
+    // Up to `limit` tickets with ids after `afterId`, in id order; pass the
+    // last id of one page to get the next, "" for the first. The default
+    // pages through findAll().
+    virtual std::vector<std::shared_ptr<Ticket>> findPage(const std::string& afterId, std::size_t limit) {
+        auto all = findAll();
+        std::sort(all.begin(), all.end(), [](const auto& a, const auto& b) { return a->getId() < b->getId(); });
+        auto first = std::upper_bound(all.begin(), all.end(), afterId,
+                                      [](const std::string& id, const auto& t) { return id < t->getId(); });
+        auto last = first + static_cast<std::ptrdiff_t>(std::min<std::size_t>(limit, static_cast<std::size_t>(all.end() - first)));
+        return std::vector<std::shared_ptr<Ticket>>(first, last);
+    }
+
+    // Saves a newly created ticket. Repositories that keep shared objects can
+    // keep this one instead of a copy; the caller must not change it afterwards
+    // except through the repository's own operations. The default copies.
+    virtual void store(std::shared_ptr<Ticket> ticket) {
+        save(*ticket);
+    }
+
+    // store() for many tickets, e.g. an import; repositories can take their
+    // lock once for the whole batch
+    virtual void storeAll(std::vector<std::shared_ptr<Ticket>> tickets) {
+        for (auto& t : tickets) store(std::move(t));
+    }
+
+    // Tickets that have every tag in `tags`. The default scans findAll();
+    // repositories with a tag index answer from it.
+    virtual std::vector<std::shared_ptr<Ticket>> findByAllTags(const TagSet& tags) {
+        auto all = findAll();
+        all.erase(std::remove_if(all.begin(), all.end(),
+                                 [&](const auto& t) { return !t->hasAllTags(tags); }),
+                  all.end());
+        return all;
+    }
+
+    enum class CasResult { UPDATED, NOT_FOUND, CONFLICT };
+
+    // Changes the stored ticket's status from `expected` to `desired` only if
+    // nobody changed it in between. On CONFLICT, `expected` holds the status
+    // that was found.
+    CasResult compareAndSetStatus(const std::string& id,
+                                  TicketStatus& expected,
+                                  TicketStatus desired) {
+        auto ticket = findById(id);
+        if (!ticket) return CasResult::NOT_FOUND;
+        return compareAndSetStatus(*ticket, expected, desired);
+    }
+
+    // Same, for a ticket already obtained from findById()/findAll().
+    // Repositories that hand out their stored objects can do this in place;
+    // the default compares on the object and saves it.
+    virtual CasResult compareAndSetStatus(Ticket& ticket,
+                                          TicketStatus& expected,
+                                          TicketStatus desired) {
+        if (!ticket.compareAndSetStatus(expected, desired)) return CasResult::CONFLICT;
+        save(ticket);
+        return CasResult::UPDATED;
+    }
 };
 
 } // namespace domain
@@ -1,6 +1,9 @@
 #ifndef ENUMS_HPP
 #define ENUMS_HPP
 
+#include <cstddef>
+#include <cstdint>
+
 namespace domain {
 
 enum class CustomerType {
@@ -9,7 +12,7 @@ enum class CustomerType {
     VIP
 };
 
-enum class TicketStatus {
+enum class TicketStatus : std::uint8_t {
     OPEN,
     IN_PROGRESS,
     RESOLVED,
@@ -31,6 +34,12 @@ enum class TicketCategory {
     FEATURE_REQUEST
 };
 
+// Number of values in each enum, for tables indexed by them.
+constexpr std::size_t CustomerTypeCount   = 3;
+constexpr std::size_t TicketStatusCount   = 4;
+constexpr std::size_t PriorityCount       = 4;
+constexpr std::size_t TicketCategoryCount = 5;
+
 } // namespace domain
 
 #endif
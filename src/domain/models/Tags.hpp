@@ -0,0 +1,154 @@
+#ifndef TAGS_HPP
+#define TAGS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace domain {
+
+using TagId = std::uint32_t;
+
+// Process-wide tag names <-> ids. Ids are dense and never reused, so the
+// first 64 tags registered (the factory's default tags among them) fit in a
+// TagSet's inline bits.
+class TagDictionary {
+private:
+    mutable std::shared_mutex mtx;
+    std::unordered_map<std::string, TagId> ids;
+    std::deque<std::string> names;   // deque: references stay valid as it grows
+
+    TagDictionary() = default;
+    TagDictionary(const TagDictionary&) = delete;
+    TagDictionary& operator=(const TagDictionary&) = delete;
+
+public:
+    static TagDictionary& getInstance() {
+        static TagDictionary instance;
+        return instance;
+    }
+
+    TagId intern(const std::string& name) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mtx);
+            auto it = ids.find(name);
+            if (it != ids.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        auto [it, inserted] = ids.emplace(name, static_cast<TagId>(names.size()));
+        if (inserted) names.push_back(name);
+        return it->second;
+    }
+
+    // nullopt for a tag no ticket has ever had
+    std::optional<TagId> find(const std::string& name) const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        auto it = ids.find(name);
+        if (it == ids.end()) return std::nullopt;
+        return it->second;
+    }
+
+    const std::string& name(TagId id) const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return names.at(id);
+    }
+
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return names.size();
+    }
+};
+
+// Set of tag ids: a 64-bit mask for ids below 64 and a sorted vector for the
+// rest, so the usual handful of tags costs no allocation and set tests are
+// a few bit operations.
+class TagSet {
+public:
+    static constexpr TagId InlineTags = 64;
+
+private:
+    std::uint64_t bits = 0;
+    std::vector<TagId> overflow;   // sorted, ids >= InlineTags
+
+public:
+    TagSet() = default;
+
+    TagSet(std::initializer_list<TagId> tags) {
+        for (TagId t : tags) add(t);
+    }
+
+    // False if the tag was already there
+    bool add(TagId tag) {
+        if (tag < InlineTags) {
+            const std::uint64_t mask = std::uint64_t{1} << tag;
+            if (bits & mask) return false;
+            bits |= mask;
+            return true;
+        }
+        auto it = std::lower_bound(overflow.begin(), overflow.end(), tag);
+        if (it != overflow.end() && *it == tag) return false;
+        overflow.insert(it, tag);
+        return true;
+    }
+
+    bool remove(TagId tag) {
+        if (tag < InlineTags) {
+            const std::uint64_t mask = std::uint64_t{1} << tag;
+            if (!(bits & mask)) return false;
+            bits &= ~mask;
+            return true;
+        }
+        auto it = std::lower_bound(overflow.begin(), overflow.end(), tag);
+        if (it == overflow.end() || *it != tag) return false;
+        overflow.erase(it);
+        return true;
+    }
+
+    bool contains(TagId tag) const {
+        if (tag < InlineTags) return (bits >> tag) & 1u;
+        return std::binary_search(overflow.begin(), overflow.end(), tag);
+    }
+
+    bool containsAll(const TagSet& other) const {
+        if ((bits & other.bits) != other.bits) return false;
+        return std::includes(overflow.begin(), overflow.end(),
+                             other.overflow.begin(), other.overflow.end());
+    }
+
+    bool empty() const { return bits == 0 && overflow.empty(); }
+
+    std::size_t size() const {
+        std::size_t n = overflow.size();
+        for (std::uint64_t b = bits; b; b &= b - 1) ++n;
+        return n;
+    }
+
+    // Calls fn(id) in ascending id order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (std::uint64_t b = bits; b; b &= b - 1) fn(static_cast<TagId>(__builtin_ctzll(b)));
+        for (TagId t : overflow) fn(t);
+    }
+
+    std::vector<std::string> names() const {
+        std::vector<std::string> out;
+        out.reserve(size());
+        const auto& dictionary = TagDictionary::getInstance();
+        forEach([&](TagId t) { out.push_back(dictionary.name(t)); });
+        return out;
+    }
+
+    bool operator==(const TagSet& other) const { return bits == other.bits && overflow == other.overflow; }
+    bool operator!=(const TagSet& other) const { return !(*this == other); }
+};
+
+} // namespace domain
+
+#endif
@@ -1,67 +1,170 @@
 #ifndef TICKET_HPP
 #define TICKET_HPP
 
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 #include <ctime>
 
 #include "Enums.hpp"
+#include "Tags.hpp"
 #include "../behaviors/state/TicketStateMachine.hpp"
 
 namespace domain {
 
+// Ticket status that can be changed with compare-and-swap while the ticket is
+// shared. Copying a ticket copies the status value at that moment.
+class AtomicTicketStatus {
+private:
+    std::atomic<TicketStatus> value;
+
+public:
+    AtomicTicketStatus(TicketStatus s) : value(s) {}
+    AtomicTicketStatus(const AtomicTicketStatus& other) : value(other.load()) {}
+
+    AtomicTicketStatus& operator=(const AtomicTicketStatus& other) {
+        store(other.load());
+        return *this;
+    }
+
+    TicketStatus load() const { return value.load(std::memory_order_acquire); }
+    void store(TicketStatus s) { value.store(s, std::memory_order_release); }
+
+    // On failure, expected receives the current status.
+    bool compareExchange(TicketStatus& expected, TicketStatus desired) {
+        return value.compare_exchange_strong(expected, desired, std::memory_order_acq_rel);
+    }
+};
+
+// The stored ticket is shared with every reader, while services change it
+// from other threads (SLA escalation, assignment). The status is atomic;
+// priority, assignee and tags are guarded by `fieldsMtx` and returned as
+// copies.
 class Ticket {
 private:
     std::string id;
     std::string customerId;
     std::string description;
-    TicketStatus status;
+    AtomicTicketStatus status;
     Priority priority;
     TicketCategory category;
     std::string assignedTo;
     std::time_t createdAt;
-    std::vector<std::string> tags;
+    TagSet tags;
+    mutable std::mutex fieldsMtx;
 
 public:
+    // Strings are taken by value: pass temporaries or std::move() to avoid copies
     Ticket(
-        const std::string& id,
-        const std::string& customerId,
-        const std::string& description,
+        std::string id,
+        std::string customerId,
+        std::string description,
         Priority priority,
         TicketCategory category,
         TicketStatus status = TicketStatus::OPEN
     )
-        : id(id)
-        , customerId(customerId)
-        , description(description)
+        : id(std::move(id))
+        , customerId(std::move(customerId))
+        , description(std::move(description))
         , status(status)
         , priority(priority)
         , category(category)
-        , assignedTo("")
         , createdAt(std::time(nullptr))
     {
     }
 
+    Ticket(const Ticket& other)
+        : id(other.id)
+        , customerId(other.customerId)
+        , description(other.description)
+        , status(other.status)
+        , category(other.category)
+        , createdAt(other.createdAt)
+    {
+        std::lock_guard<std::mutex> lock(other.fieldsMtx);
+        priority = other.priority;
+        assignedTo = other.assignedTo;
+        tags = other.tags;
+    }
+
+    Ticket& operator=(const Ticket& other) {
+        if (this == &other) return *this;
+        std::scoped_lock lock(fieldsMtx, other.fieldsMtx);
+        id = other.id;
+        customerId = other.customerId;
+        description = other.description;
+        status = other.status;
+        priority = other.priority;
+        category = other.category;
+        assignedTo = other.assignedTo;
+        createdAt = other.createdAt;
+        tags = other.tags;
+        return *this;
+    }
+
     // -------- getters --------
-    std::string getId() const { return id; }
-    std::string getCustomerId() const { return customerId; }
-    std::string getDescription() const { return description; }
-    TicketStatus getStatus() const { return status; }
-    Priority getPriority() const { return priority; }
+    const std::string& getId() const { return id; }
+    const std::string& getCustomerId() const { return customerId; }
+    const std::string& getDescription() const { return description; }
+    TicketStatus getStatus() const { return status.load(); }
+    Priority getPriority() const {
+        std::lock_guard<std::mutex> lock(fieldsMtx);
+        return priority;
+    }
     TicketCategory getCategory() const { return category; }
-    std::string getAssignedTo() const { return assignedTo; }
+    std::string getAssignedTo() const {
+        std::lock_guard<std::mutex> lock(fieldsMtx);
+        return assignedTo;
+    }
     std::time_t getCreatedAt() const { return createdAt; }
-    std::vector<std::string> getTags() const { return tags; }
+    std::vector<std::string> getTags() const { return getTagSet().names(); }
+    TagSet getTagSet() const {
+        std::lock_guard<std::mutex> lock(fieldsMtx);
+        return tags;
+    }
+    bool hasTag(const std::string& tag) const {
+        auto id = TagDictionary::getInstance().find(tag);
+        if (!id) return false;
+        std::lock_guard<std::mutex> lock(fieldsMtx);
+        return tags.contains(*id);
+    }
+    bool hasAllTags(const TagSet& required) const {
+        std::lock_guard<std::mutex> lock(fieldsMtx);
+        return tags.containsAll(required);
+    }
 
     // -------- setters used elsewhere --------
-    void setStatus(TicketStatus s) { status = s; }
-    void setPriority(Priority p) { priority = p; }
-    void setAssignedTo(const std::string& a) { assignedTo = a; }
-    void addTag(const std::string& tag) { tags.push_back(tag); }
+    void setStatus(TicketStatus s) { status.store(s); }
+
+    // Sets the status only if it is still `expected`; otherwise returns false
+    // and updates `expected` to the current status.
+    bool compareAndSetStatus(TicketStatus& expected, TicketStatus desired) {
+        return status.compareExchange(expected, desired);
+    }
+    void setPriority(Priority p) {
+        std::lock_guard<std::mutex> lock(fieldsMtx);
+        priority = p;
+    }
+    void setAssignedTo(std::string a) {
+        std::lock_guard<std::mutex> lock(fieldsMtx);
+        assignedTo = std::move(a);
+    }
+    void setCreatedAt(std::time_t t) { createdAt = t; }
+    void addTag(const std::string& tag) {
+        const TagId tagId = TagDictionary::getInstance().intern(tag);
+        std::lock_guard<std::mutex> lock(fieldsMtx);
+        tags.add(tagId);
+    }
+    void setTags(TagSet t) {
+        std::lock_guard<std::mutex> lock(fieldsMtx);
+        tags = std::move(t);
+    }
 
     // -------- State pattern integration --------
     void applyStateMachine(domain::behaviors::state::TicketStateMachine& sm) {
-        status = sm.getStatus();
+        status.store(sm.getStatus());
     }
 };
 
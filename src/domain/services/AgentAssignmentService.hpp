@@ -0,0 +1,298 @@
+#ifndef AGENT_ASSIGNMENT_SERVICE_HPP
+#define AGENT_ASSIGNMENT_SERVICE_HPP
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../models/Enums.hpp"
+#include "../util/IndexedHeap.hpp"
+
+namespace domain {
+
+enum class AgentLevel : std::uint8_t {
+    JUNIOR,
+    REGULAR,
+    SENIOR
+};
+
+constexpr std::size_t AgentLevelCount = 3;
+
+struct AgentProfile {
+    std::string id;
+    AgentLevel level = AgentLevel::REGULAR;
+    std::vector<TicketCategory> skills;   // empty = every category
+    unsigned capacity = 25;               // open tickets before the agent is skipped; 0 = no limit
+    bool available = true;
+};
+
+// Which agents may take a ticket of each priority
+struct AssignmentPolicy {
+    std::array<AgentLevel, PriorityCount> minLevel = {{   // LOW..CRITICAL
+        AgentLevel::JUNIOR, AgentLevel::JUNIOR, AgentLevel::REGULAR, AgentLevel::SENIOR
+    }};
+
+    // When every agent of the required level is away or full, take the
+    // least-loaded agent of a lower level instead of leaving the ticket
+    // unassigned
+    bool fallBackToLowerLevel = true;
+};
+
+struct AgentLoad {
+    std::string id;
+    AgentLevel level = AgentLevel::REGULAR;
+    unsigned openTickets = 0;
+    unsigned capacity = 0;
+    bool available = true;
+};
+
+struct AssignmentStats {
+    std::uint64_t assigned = 0;
+    std::uint64_t fallbacks = 0;     // assigned below the policy's level
+    std::uint64_t unassigned = 0;    // no agent with the skill was available
+    std::uint64_t released = 0;      // tickets resolved or closed
+    std::uint64_t reopened = 0;
+    std::uint64_t transferred = 0;   // reassigned by hand or on escalation
+};
+
+// Assigns new tickets to the least-loaded available agent that has the
+// ticket's category as a skill and the level its priority needs. Ties go to
+// the agent who was assigned least recently.
+//
+// Agents sit in one IndexedHeap per (category, level), keyed by open tickets,
+// so a pick looks at a few heap tops and every load change is an O(log n)
+// update of the agent's heaps. An agent leaves the heaps while unavailable
+// or at capacity. Load counts tickets that are OPEN or IN_PROGRESS;
+// TicketService reports every status change and reassignment here.
+class AgentAssignmentService {
+private:
+    using Key = std::uint32_t;
+
+    struct Load {
+        unsigned open = 0;
+        std::uint64_t lastAssigned = 0;
+
+        bool operator<(const Load& o) const {
+            return open != o.open ? open < o.open : lastAssigned < o.lastAssigned;
+        }
+    };
+
+    struct Agent {
+        AgentProfile profile;
+        std::uint32_t skillMask = 0;
+        Load load;
+    };
+
+    struct Assignment {
+        Key agent;
+        bool open;   // counted in the agent's load
+    };
+
+    using Heap = IndexedHeap<Load>;
+
+    AssignmentPolicy policy;
+
+    mutable std::mutex mtx;
+    std::vector<Agent> agents;
+    std::unordered_map<std::string, Key> keys;
+    std::unordered_map<std::string, Assignment> tickets;
+    std::array<std::array<Heap, AgentLevelCount>, TicketCategoryCount> heaps;
+    std::uint64_t sequence = 0;
+    AssignmentStats stats;
+
+    static std::uint32_t maskOf(const std::vector<TicketCategory>& skills) {
+        if (skills.empty()) return (1u << TicketCategoryCount) - 1;
+        std::uint32_t mask = 0;
+        for (auto c : skills) mask |= 1u << static_cast<unsigned>(c);
+        return mask;
+    }
+
+    static bool isOpen(TicketStatus s) {
+        return s == TicketStatus::OPEN || s == TicketStatus::IN_PROGRESS;
+    }
+
+    bool eligible(const Agent& a) const {
+        return a.profile.available && (a.profile.capacity == 0 || a.load.open < a.profile.capacity);
+    }
+
+    // Puts the agent in, moves it within or takes it out of its heaps
+    void reindex(Key key) {
+        const Agent& a = agents[key];
+        const bool in = eligible(a);
+        const auto level = static_cast<std::size_t>(a.profile.level);
+        for (std::size_t c = 0; c < TicketCategoryCount; ++c) {
+            Heap& heap = heaps[c][level];
+            if (in && (a.skillMask >> c & 1u)) heap.push(key, a.load);
+            else heap.erase(key);
+        }
+    }
+
+    void unindex(Key key) {
+        for (auto& byLevel : heaps)
+            for (auto& heap : byLevel) heap.erase(key);
+    }
+
+    // Least-loaded eligible agent among the levels [from, to)
+    std::optional<Key> pick(TicketCategory category, std::size_t from, std::size_t to) const {
+        std::optional<Key> best;
+        for (std::size_t level = from; level < to; ++level) {
+            const Heap& heap = heaps[static_cast<std::size_t>(category)][level];
+            if (heap.empty()) continue;
+            if (!best || heap.topPriority() < agents[*best].load) best = heap.top();
+        }
+        return best;
+    }
+
+    void addLoad(Key key) {
+        Agent& a = agents[key];
+        ++a.load.open;
+        a.load.lastAssigned = ++sequence;
+        reindex(key);
+    }
+
+    void removeLoad(Key key) {
+        Agent& a = agents[key];
+        if (a.load.open > 0) --a.load.open;
+        reindex(key);
+    }
+
+public:
+    explicit AgentAssignmentService(AssignmentPolicy p = {}) : policy(std::move(p)) {}
+
+    AgentAssignmentService(const AgentAssignmentService&) = delete;
+    AgentAssignmentService& operator=(const AgentAssignmentService&) = delete;
+
+    // Adds the agent, or replaces the profile of a known one (its open
+    // tickets are kept)
+    void registerAgent(AgentProfile profile) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto [it, inserted] = keys.emplace(profile.id, static_cast<Key>(agents.size()));
+        if (inserted) agents.emplace_back();
+        const Key key = it->second;
+
+        unindex(key);
+        Agent& a = agents[key];
+        a.skillMask = maskOf(profile.skills);
+        a.profile = std::move(profile);
+        reindex(key);
+    }
+
+    // False if the agent is unknown
+    bool setAvailable(const std::string& agentId, bool available) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = keys.find(agentId);
+        if (it == keys.end()) return false;
+        agents[it->second].profile.available = available;
+        reindex(it->second);
+        return true;
+    }
+
+    // Picks an agent for a new ticket and counts it in their load; nullopt
+    // if no agent with the skill is available
+    std::optional<std::string> assign(const std::string& ticketId, TicketCategory category, Priority priority) {
+        std::lock_guard<std::mutex> lock(mtx);
+        const auto required = static_cast<std::size_t>(policy.minLevel[static_cast<std::size_t>(priority)]);
+
+        auto key = pick(category, required, AgentLevelCount);
+        if (!key && policy.fallBackToLowerLevel && required > 0) {
+            key = pick(category, 0, required);
+            if (key) ++stats.fallbacks;
+        }
+        if (!key) {
+            ++stats.unassigned;
+            return std::nullopt;
+        }
+
+        auto [it, inserted] = tickets.try_emplace(ticketId, Assignment{*key, true});
+        if (!inserted) {
+            if (it->second.open) removeLoad(it->second.agent);
+            it->second = Assignment{*key, true};
+        }
+        addLoad(*key);
+        ++stats.assigned;
+        return agents[*key].profile.id;
+    }
+
+    // The ticket was given to agentId by hand (or on escalation): moves its
+    // load from the previous agent. Agents that are not registered here are
+    // not tracked.
+    void transfer(const std::string& ticketId, const std::string& agentId, TicketStatus status) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = tickets.find(ticketId);
+        if (it != tickets.end()) {
+            if (it->second.open) removeLoad(it->second.agent);
+            tickets.erase(it);
+        }
+
+        auto agent = keys.find(agentId);
+        if (agent == keys.end()) return;
+        tickets.emplace(ticketId, Assignment{agent->second, isOpen(status)});
+        if (isOpen(status)) addLoad(agent->second);
+        ++stats.transferred;
+    }
+
+    // Resolving or closing a ticket frees a slot; reopening it counts
+    // against the same agent again, even past their capacity
+    void statusChanged(const std::string& ticketId, TicketStatus oldStatus, TicketStatus newStatus) {
+        if (isOpen(oldStatus) == isOpen(newStatus)) return;
+
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = tickets.find(ticketId);
+        if (it == tickets.end()) return;
+
+        Assignment& a = it->second;
+        if (a.open && !isOpen(newStatus)) {
+            a.open = false;
+            removeLoad(a.agent);
+            ++stats.released;
+        } else if (!a.open && isOpen(newStatus)) {
+            a.open = true;
+            Agent& agent = agents[a.agent];
+            ++agent.load.open;
+            reindex(a.agent);
+            ++stats.reopened;
+        }
+    }
+
+    std::optional<AgentLoad> getLoad(const std::string& agentId) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = keys.find(agentId);
+        if (it == keys.end()) return std::nullopt;
+        const Agent& a = agents[it->second];
+        return AgentLoad{a.profile.id, a.profile.level, a.load.open, a.profile.capacity, a.profile.available};
+    }
+
+    // Categories the agent handles; empty if the agent is unknown
+    std::vector<TicketCategory> getSkills(const std::string& agentId) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::vector<TicketCategory> out;
+        auto it = keys.find(agentId);
+        if (it == keys.end()) return out;
+        for (std::size_t c = 0; c < TicketCategoryCount; ++c)
+            if (agents[it->second].skillMask >> c & 1u) out.push_back(static_cast<TicketCategory>(c));
+        return out;
+    }
+
+    std::vector<AgentLoad> getLoads() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::vector<AgentLoad> out;
+        out.reserve(agents.size());
+        for (const auto& a : agents)
+            out.push_back({a.profile.id, a.profile.level, a.load.open, a.profile.capacity, a.profile.available});
+        return out;
+    }
+
+    AssignmentStats getStats() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return stats;
+    }
+};
+
+} // namespace domain
+
+#endif
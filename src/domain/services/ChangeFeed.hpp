@@ -0,0 +1,536 @@
+#ifndef CHANGE_FEED_HPP
+#define CHANGE_FEED_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../models/Customer.hpp"
+#include "../models/Ticket.hpp"
+#include "../util/VarInt.hpp"
+
+namespace domain {
+
+enum class ChangeEntity : std::uint8_t {
+    TICKET,
+    CUSTOMER
+};
+
+// One saved entity. Sequence numbers start at 1 and have no gaps, so a
+// consumer resumes by reading from the last sequence it processed plus one.
+struct ChangeRecord {
+    std::uint64_t sequence = 0;
+    std::int64_t atMs = 0;                // milliseconds since the epoch
+    ChangeEntity entity = ChangeEntity::TICKET;
+    std::string key;                      // entity id
+    std::vector<std::uint8_t> payload;    // encodeTicket() / encodeCustomer(); empty: removed
+};
+
+struct ChangeBatch {
+    std::vector<ChangeRecord> records;
+    std::uint64_t nextSequence = 1;   // pass to the next read()
+    bool truncated = false;           // records before the returned ones were removed by retention
+};
+
+struct ChangeFeedOptions {
+    std::string directory;                       // empty: memory only
+    std::size_t segmentBytes = 8 << 20;          // a new segment is started beyond this
+    std::size_t maxBytes = 256 << 20;            // retention by size, over all segments
+    std::chrono::hours maxAge{24 * 7};           // retention by time; zero keeps everything
+
+    // Group commit: appended records are written to the file together at
+    // least this often instead of one flush each; zero flushes every record
+    std::chrono::milliseconds flushInterval{100};
+};
+
+struct ChangeFeedStats {
+    std::uint64_t firstSequence = 0;   // oldest record kept, 0 if empty
+    std::uint64_t lastSequence = 0;
+    std::size_t segments = 0;
+    std::size_t bytes = 0;
+    std::uint64_t removedRecords = 0;  // dropped by retention
+};
+
+// -------- entity encoding (varints and length-prefixed strings) --------
+
+inline std::vector<std::uint8_t> encodeTicket(const Ticket& t) {
+    std::vector<std::uint8_t> out;
+    appendBytes(out, t.getId());
+    appendBytes(out, t.getCustomerId());
+    appendBytes(out, t.getDescription());
+    out.push_back(static_cast<std::uint8_t>(t.getStatus()));
+    out.push_back(static_cast<std::uint8_t>(t.getPriority()));
+    out.push_back(static_cast<std::uint8_t>(t.getCategory()));
+    appendBytes(out, t.getAssignedTo());
+    appendVarint(out, static_cast<std::uint64_t>(t.getCreatedAt()));
+    const auto& tags = t.getTags();
+    appendVarint(out, tags.size());
+    for (const auto& tag : tags) appendBytes(out, tag);
+    return out;
+}
+
+inline std::optional<Ticket> decodeTicket(const std::vector<std::uint8_t>& in) {
+    const std::uint8_t* data = in.data();
+    std::size_t pos = 0;
+    std::string id, customerId, description, assignedTo;
+    if (!readBytes(data, in.size(), pos, id) || !readBytes(data, in.size(), pos, customerId) ||
+        !readBytes(data, in.size(), pos, description) || in.size() - pos < 3) {
+        return std::nullopt;
+    }
+    const auto status = static_cast<TicketStatus>(data[pos++]);
+    const auto priority = static_cast<Priority>(data[pos++]);
+    const auto category = static_cast<TicketCategory>(data[pos++]);
+    std::uint64_t createdAt = 0, tagCount = 0;
+    if (!readBytes(data, in.size(), pos, assignedTo) || !readVarint(data, in.size(), pos, createdAt) ||
+        !readVarint(data, in.size(), pos, tagCount)) {
+        return std::nullopt;
+    }
+
+    Ticket ticket(id, customerId, description, priority, category, status);
+    ticket.setAssignedTo(assignedTo);
+    ticket.setCreatedAt(static_cast<std::time_t>(createdAt));
+    for (std::uint64_t i = 0; i < tagCount; ++i) {
+        std::string tag;
+        if (!readBytes(data, in.size(), pos, tag)) return std::nullopt;
+        ticket.addTag(tag);
+    }
+    return ticket;
+}
+
+inline std::vector<std::uint8_t> encodeCustomer(const Customer& c) {
+    std::vector<std::uint8_t> out;
+    appendBytes(out, c.getId());
+    appendBytes(out, c.getName());
+    appendBytes(out, c.getEmail());
+    appendBytes(out, c.getPhone());
+    out.push_back(static_cast<std::uint8_t>(c.getType()));
+    return out;
+}
+
+inline std::optional<Customer> decodeCustomer(const std::vector<std::uint8_t>& in) {
+    const std::uint8_t* data = in.data();
+    std::size_t pos = 0;
+    std::string id, name, email, phone;
+    if (!readBytes(data, in.size(), pos, id) || !readBytes(data, in.size(), pos, name) ||
+        !readBytes(data, in.size(), pos, email) || !readBytes(data, in.size(), pos, phone) ||
+        pos >= in.size()) {
+        return std::nullopt;
+    }
+    return Customer(id, name, email, phone, static_cast<CustomerType>(data[pos]));
+}
+
+// Append-only log of repository changes (change data capture).
+//
+// Records are kept in segments of about segmentBytes. Retention removes
+// whole segments, oldest first, once the feed exceeds maxBytes or a
+// segment's newest record is older than maxAge; the segment being written
+// is never removed.
+//
+// With a directory, every segment is also written to
+// <directory>/<first sequence>.cdc, so other processes can read the feed
+// with readDirectory(), and a restarted feed continues the sequence where
+// the files end. Segment file layout:
+//
+//   "CDC1"
+//   repeated: varint length, then
+//             varint sequence, varint atMs, entity byte,
+//             varint key length, key, varint payload length, payload
+//
+// A torn record at the end of a file (crash during a write) is ignored.
+class ChangeFeed {
+public:
+    using Clock = std::chrono::system_clock;
+
+private:
+    static constexpr char Magic[4] = {'C', 'D', 'C', '1'};
+
+    struct Segment {
+        std::uint64_t firstSequence = 0;
+        std::vector<ChangeRecord> records;
+        std::size_t bytes = 0;
+        std::int64_t newestAtMs = 0;
+        std::string path;
+    };
+
+    ChangeFeedOptions options;
+
+    mutable std::shared_mutex mtx;
+    mutable std::condition_variable_any appended;
+    std::deque<Segment> segments;
+    std::ofstream file;                    // active segment, when file-backed
+    std::uint64_t nextSequence = 1;
+    std::size_t totalBytes = 0;
+    std::uint64_t removedRecords = 0;
+    std::string error;                     // why the feed is memory only despite a directory
+
+    // Group commit (see ChangeFeedOptions::flushInterval)
+    std::thread flusher;
+    std::condition_variable_any flushWake;
+    bool unflushed = false;
+    bool stopping = false;
+
+    static std::int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now().time_since_epoch()).count();
+    }
+
+    static std::size_t recordBytes(const ChangeRecord& r) {
+        return sizeof(ChangeRecord) + r.key.size() + r.payload.size();
+    }
+
+    static std::vector<std::uint8_t> encodeRecord(const ChangeRecord& r) {
+        std::vector<std::uint8_t> body;
+        appendVarint(body, r.sequence);
+        appendVarint(body, static_cast<std::uint64_t>(r.atMs));
+        body.push_back(static_cast<std::uint8_t>(r.entity));
+        appendBytes(body, r.key);
+        appendVarint(body, r.payload.size());
+        body.insert(body.end(), r.payload.begin(), r.payload.end());
+
+        std::vector<std::uint8_t> out;
+        appendVarint(out, body.size());
+        out.insert(out.end(), body.begin(), body.end());
+        return out;
+    }
+
+    static bool decodeRecord(const std::uint8_t* data, std::size_t size, std::size_t& pos,
+                             ChangeRecord& r) {
+        std::uint64_t length = 0, atMs = 0, payloadLength = 0;
+        if (!readVarint(data, size, pos, length) || length > size - pos) return false;
+        const std::size_t end = pos + static_cast<std::size_t>(length);
+        if (!readVarint(data, end, pos, r.sequence) || !readVarint(data, end, pos, atMs) || pos >= end)
+            return false;
+        r.atMs = static_cast<std::int64_t>(atMs);
+        r.entity = static_cast<ChangeEntity>(data[pos++]);
+        if (!readBytes(data, end, pos, r.key) || !readVarint(data, end, pos, payloadLength) ||
+            payloadLength != end - pos) {
+            return false;
+        }
+        r.payload.assign(data + pos, data + end);
+        pos = end;
+        return true;
+    }
+
+    static std::string segmentPath(const std::string& directory, std::uint64_t firstSequence) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%020llu.cdc", static_cast<unsigned long long>(firstSequence));
+        return (std::filesystem::path(directory) / name).string();
+    }
+
+    static std::vector<std::string> segmentFiles(const std::string& directory) {
+        std::vector<std::string> paths;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            if (entry.path().extension() == ".cdc") paths.push_back(entry.path().string());
+        }
+        std::sort(paths.begin(), paths.end());   // names are zero-padded sequences
+        return paths;
+    }
+
+    // Calls fn(record) for every complete record of a segment file
+    template <typename Fn>
+    static void scanFile(const std::string& path, Fn&& fn) {
+        std::ifstream in(path, std::ios::binary);
+        const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)),
+                                              std::istreambuf_iterator<char>());
+        if (bytes.size() < sizeof(Magic) || !std::equal(Magic, Magic + sizeof(Magic), bytes.begin()))
+            return;
+        std::size_t pos = sizeof(Magic);
+        ChangeRecord r;
+        while (pos < bytes.size() && decodeRecord(bytes.data(), bytes.size(), pos, r)) {
+            if (!fn(r)) return;
+        }
+    }
+
+    // Falls back to memory only, keeping the records already written
+    void disableFiles(std::string why) {
+        error = std::move(why);
+        options.directory.clear();
+        file.close();
+    }
+
+    void startSegment() {
+        Segment s;
+        s.firstSequence = nextSequence;
+        if (!options.directory.empty()) {
+            s.path = segmentPath(options.directory, nextSequence);
+            file.close();
+            file.open(s.path, std::ios::binary | std::ios::trunc);
+            file.write(Magic, sizeof(Magic));
+            file.flush();
+            unflushed = false;
+            if (!file) {
+                disableFiles("cannot write " + s.path);
+                s.path.clear();
+            }
+        }
+        segments.push_back(std::move(s));
+    }
+
+    void load() {
+        std::error_code ec;
+        std::filesystem::create_directories(options.directory, ec);
+        if (ec) {
+            disableFiles("cannot create " + options.directory + ": " + ec.message());
+            return;
+        }
+        for (const auto& path : segmentFiles(options.directory)) {
+            Segment s;
+            s.path = path;
+            scanFile(path, [&](ChangeRecord& r) {
+                // Sequences continue across files; anything else is a foreign or damaged file
+                if (!segments.empty() || !s.records.empty()) {
+                    if (r.sequence != nextSequence) return false;
+                }
+                if (s.records.empty()) s.firstSequence = r.sequence;
+                nextSequence = r.sequence + 1;
+                s.bytes += recordBytes(r);
+                s.newestAtMs = std::max(s.newestAtMs, r.atMs);
+                s.records.push_back(std::move(r));
+                return true;
+            });
+            if (s.records.empty()) {
+                std::filesystem::remove(path, ec);
+                continue;
+            }
+            totalBytes += s.bytes;
+            segments.push_back(std::move(s));
+        }
+    }
+
+    void enforceRetention(std::int64_t now) {
+        const std::int64_t maxAgeMs = std::chrono::duration_cast<std::chrono::milliseconds>(options.maxAge).count();
+        while (segments.size() > 1) {
+            const Segment& oldest = segments.front();
+            const bool tooBig = totalBytes > options.maxBytes;
+            const bool tooOld = maxAgeMs > 0 && oldest.newestAtMs < now - maxAgeMs;
+            if (!tooBig && !tooOld) break;
+
+            totalBytes -= oldest.bytes;
+            removedRecords += oldest.records.size();
+            if (!oldest.path.empty()) {
+                std::error_code ec;
+                std::filesystem::remove(oldest.path, ec);
+            }
+            segments.pop_front();
+        }
+    }
+
+    // Index of the segment holding `sequence`; segments must not be empty
+    std::size_t segmentFor(std::uint64_t sequence) const {
+        auto it = std::upper_bound(segments.begin(), segments.end(), sequence,
+                                   [](std::uint64_t s, const Segment& seg) { return s < seg.firstSequence; });
+        return it == segments.begin() ? 0 : static_cast<std::size_t>(it - segments.begin()) - 1;
+    }
+
+public:
+    // A directory that cannot be written leaves the feed memory only; see
+    // getError()
+    explicit ChangeFeed(ChangeFeedOptions opts = {}) : options(std::move(opts)) {
+        if (!options.directory.empty()) load();
+        startSegment();
+        enforceRetention(nowMs());
+
+        if (!options.directory.empty() && options.flushInterval.count() > 0) {
+            flusher = std::thread([this] {
+                std::unique_lock<std::shared_mutex> lock(mtx);
+                while (!stopping) {
+                    flushWake.wait_for(lock, options.flushInterval);
+                    if (unflushed) {
+                        file.flush();
+                        unflushed = false;
+                    }
+                }
+            });
+        }
+    }
+
+    ~ChangeFeed() {
+        if (flusher.joinable()) {
+            {
+                std::unique_lock<std::shared_mutex> lock(mtx);
+                stopping = true;
+            }
+            flushWake.notify_all();
+            flusher.join();
+        }
+        flush();
+    }
+
+    ChangeFeed(const ChangeFeed&) = delete;
+    ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+    bool isFileBacked() const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return file.is_open();
+    }
+
+    std::string getError() const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return error;
+    }
+
+    // Writes the records appended so far to the segment file now, e.g.
+    // before another process reads it with readDirectory()
+    void flush() {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        if (!file.is_open()) return;
+        file.flush();
+        unflushed = false;
+    }
+
+    std::uint64_t append(ChangeEntity entity, std::string key, std::vector<std::uint8_t> payload) {
+        ChangeRecord r;
+        r.atMs = nowMs();
+        r.entity = entity;
+        r.key = std::move(key);
+        r.payload = std::move(payload);
+
+        std::uint64_t sequence;
+        {
+            std::unique_lock<std::shared_mutex> lock(mtx);
+            if (segments.back().bytes >= options.segmentBytes) {
+                startSegment();
+                enforceRetention(r.atMs);
+            }
+            sequence = r.sequence = nextSequence++;
+            if (file.is_open()) {
+                const auto bytes = encodeRecord(r);
+                file.write(reinterpret_cast<const char*>(bytes.data()),
+                           static_cast<std::streamsize>(bytes.size()));
+                if (options.flushInterval.count() > 0) unflushed = true;
+                else file.flush();
+            }
+            Segment& active = segments.back();
+            active.bytes += recordBytes(r);
+            active.newestAtMs = r.atMs;
+            totalBytes += recordBytes(r);
+            active.records.push_back(std::move(r));
+        }
+        appended.notify_all();
+        return sequence;
+    }
+
+    std::uint64_t appendTicket(const Ticket& ticket) {
+        return append(ChangeEntity::TICKET, ticket.getId(), encodeTicket(ticket));
+    }
+
+    std::uint64_t appendCustomer(const Customer& customer) {
+        return append(ChangeEntity::CUSTOMER, customer.getId(), encodeCustomer(customer));
+    }
+
+    // Tombstone: a record with no payload
+    std::uint64_t appendRemoval(ChangeEntity entity, std::string key) {
+        return append(entity, std::move(key), {});
+    }
+
+    // Up to maxRecords records starting at fromSequence. If retention already
+    // removed fromSequence, reading starts at the oldest kept record and the
+    // batch is marked truncated.
+    ChangeBatch read(std::uint64_t fromSequence, std::size_t maxRecords = 1024) const {
+        ChangeBatch batch;
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        const std::uint64_t first = segments.front().firstSequence;
+        if (fromSequence < first) {
+            batch.truncated = first > 1;
+            fromSequence = first;
+        }
+        batch.nextSequence = std::max(fromSequence, std::uint64_t{1});
+        if (fromSequence >= nextSequence) return batch;
+
+        std::size_t s = segmentFor(fromSequence);
+        std::size_t i = static_cast<std::size_t>(fromSequence - segments[s].firstSequence);
+        batch.records.reserve(std::min<std::uint64_t>(maxRecords, nextSequence - fromSequence));
+        while (batch.records.size() < maxRecords && s < segments.size()) {
+            const auto& records = segments[s].records;
+            if (i >= records.size()) {
+                ++s;
+                i = 0;
+                continue;
+            }
+            batch.records.push_back(records[i++]);
+        }
+        if (!batch.records.empty()) batch.nextSequence = batch.records.back().sequence + 1;
+        return batch;
+    }
+
+    // Blocks until `sequence` exists or the timeout passes; true if it exists
+    template <typename Rep, typename Period>
+    bool waitFor(std::uint64_t sequence, std::chrono::duration<Rep, Period> timeout) const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return appended.wait_for(lock, timeout, [&] { return sequence < nextSequence; });
+    }
+
+    // Removes segments past the retention limits now rather than on the
+    // next segment roll
+    void applyRetention() {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        enforceRetention(nowMs());
+    }
+
+    std::uint64_t lastSequence() const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return nextSequence - 1;
+    }
+
+    ChangeFeedStats getStats() const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        ChangeFeedStats s;
+        s.lastSequence = nextSequence - 1;
+        for (const auto& seg : segments) {
+            if (!seg.records.empty()) {
+                s.firstSequence = seg.firstSequence;
+                break;
+            }
+        }
+        s.segments = segments.size();
+        s.bytes = totalBytes;
+        s.removedRecords = removedRecords;
+        return s;
+    }
+
+    // Reads a feed's segment files from another process (or after this one
+    // exits), with the same semantics as read(). Records still waiting for
+    // the group commit are not seen yet.
+    static ChangeBatch readDirectory(const std::string& directory, std::uint64_t fromSequence,
+                                     std::size_t maxRecords = 1024) {
+        ChangeBatch batch;
+        batch.nextSequence = std::max(fromSequence, std::uint64_t{1});
+        const auto paths = segmentFiles(directory);
+        bool first = true;
+        for (std::size_t p = 0; p < paths.size() && batch.records.size() < maxRecords; ++p) {
+            // Skip files that end before fromSequence (the next one starts after it)
+            if (p + 1 < paths.size()) {
+                const auto next = std::stoull(std::filesystem::path(paths[p + 1]).stem().string());
+                if (next <= fromSequence) continue;
+            }
+            scanFile(paths[p], [&](ChangeRecord& r) {
+                if (first) {
+                    batch.truncated = r.sequence > std::max(fromSequence, std::uint64_t{1});
+                    first = false;
+                }
+                if (r.sequence < fromSequence) return true;
+                batch.records.push_back(std::move(r));
+                return batch.records.size() < maxRecords;
+            });
+        }
+        if (!batch.records.empty()) batch.nextSequence = batch.records.back().sequence + 1;
+        return batch;
+    }
+};
+
+} // namespace domain
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef CUSTOMER_SERVICE_HPP
 #define CUSTOMER_SERVICE_HPP
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -10,6 +12,8 @@
 #include "../interfaces/ILogger.hpp"
 #include "../interfaces/ICustomerRepository.hpp"
 #include "../factory/CustomerFactory.hpp"
+#include "../util/BloomFilter.hpp"
+#include "../util/IdNumber.hpp"
 
 namespace domain {
 
@@ -19,15 +23,27 @@ private:
     std::shared_ptr<ILogger> logger;
     std::unique_ptr<AbstractCustomerFactory> factory;
 
-    int customerCounter = 1000;
+    // Answers "definitely not registered" without a repository lookup.
+    // Customers must be registered through this service to be visible.
+    std::shared_ptr<BloomFilter> idFilter;
+
+    // Registrations can come from several threads (HTTP workers, pipelines)
+    std::atomic<int> customerCounter{1000};
 
 public:
     CustomerService(
         ICustomerRepository& r,
         std::shared_ptr<ILogger> l,
-        std::unique_ptr<AbstractCustomerFactory> f
+        std::unique_ptr<AbstractCustomerFactory> f,
+        const BloomFilterConfig& filterConfig = {}
     )
-        : repo(r), logger(l), factory(std::move(f)) {}
+        : repo(r), logger(l), factory(std::move(f))
+        , idFilter(std::make_shared<BloomFilter>(filterConfig))
+    {
+        for (const auto& c : repo.findAll()) {
+            if (c) idFilter->add(c->getId());
+        }
+    }
 
     std::string registerCustomer(
         const std::string& name,
@@ -45,6 +61,8 @@ public:
             type
         );
 
+        // Filter first, so a concurrent lookup never sees a false negative.
+        idFilter->add(id);
         repo.save(*customer);
 
         logger->log("Customer registered: " + id +
@@ -53,13 +71,54 @@ public:
         return id;
     }
 
+    // Loads existing customers (e.g. from a migration) as they are, replacing
+    // any with the same id. New registrations continue after the highest
+    // imported "CUST-<n>" id.
+    void importCustomers(const std::vector<Customer>& customers) {
+        int highest = 0;
+        for (const auto& c : customers) {
+            idFilter->add(c.getId());
+            highest = std::max(highest, idNumber(c.getId(), "CUST-"));
+        }
+        int current = customerCounter.load();
+        while (current < highest && !customerCounter.compare_exchange_weak(current, highest)) {}
+        repo.saveAll(customers);
+        logger->log("Customers imported: " + std::to_string(customers.size()));
+    }
+
+    // Undoes a registration (e.g. when the rest of an onboarding failed).
+    // The id stays in the filter, which only costs a lookup later.
+    bool removeCustomer(const std::string& id) {
+        if (!repo.remove(id)) return false;
+        logger->log("Customer removed: " + id);
+        return true;
+    }
+
     std::shared_ptr<Customer> getCustomer(const std::string& id) {
+        if (!idFilter->mightContain(id)) return nullptr;
         return repo.findById(id);
     }
 
+    bool mightExist(const std::string& id) const {
+        return idFilter->mightContain(id);
+    }
+
+    std::shared_ptr<const BloomFilter> getIdFilter() const {
+        return idFilter;
+    }
+
+    BloomFilterStats getIdFilterStats() const {
+        return idFilter->getStats();
+    }
+
     std::vector<std::shared_ptr<Customer>> getAllCustomers() {
         return repo.findAll();
     }
+
+    // Customers in id order, a page at a time (see ICustomerRepository::findPage)
+    std::vector<std::shared_ptr<Customer>> getCustomersPage(const std::string& afterId, std::size_t limit) {
+        return repo.findPage(afterId, limit);
+    }
 };
 
 } // namespace domain
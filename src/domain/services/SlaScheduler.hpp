@@ -0,0 +1,198 @@
+#ifndef SLA_SCHEDULER_HPP
+#define SLA_SCHEDULER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../models/Enums.hpp"
+#include "../util/TimingWheel.hpp"
+
+namespace domain {
+
+// How long a ticket may stay in a status, by priority. Zero means no SLA.
+struct SlaPolicy {
+    using Deadlines = std::array<std::chrono::seconds, PriorityCount>;  // LOW..CRITICAL
+
+    std::array<Deadlines, TicketStatusCount> maxTimeInStatus = {{
+        // OPEN: must be picked up (IN_PROGRESS)
+        {{std::chrono::hours(24), std::chrono::hours(4), std::chrono::hours(1), std::chrono::minutes(15)}},
+        // IN_PROGRESS: must be RESOLVED
+        {{std::chrono::hours(168), std::chrono::hours(72), std::chrono::hours(24), std::chrono::hours(4)}},
+        // RESOLVED, CLOSED: no SLA
+        {{}},
+        {{}}
+    }};
+
+    // Agent that escalated tickets are reassigned to; empty keeps the assignee
+    std::string escalationAgent;
+
+    std::chrono::seconds deadlineFor(TicketStatus status, Priority priority) const {
+        return maxTimeInStatus[static_cast<std::size_t>(status)][static_cast<std::size_t>(priority)];
+    }
+};
+
+struct SlaBreach {
+    std::string ticketId;
+    TicketStatus status;
+    Priority priority;
+    std::chrono::system_clock::time_point deadline;
+};
+
+struct SlaStats {
+    std::size_t pending = 0;
+    std::uint64_t armed = 0;
+    std::uint64_t cancelled = 0;
+    std::uint64_t breached = 0;
+};
+
+// One SLA timer per ticket, re-armed whenever the ticket's status or
+// priority changes (track()) and dropped when it leaves the SLA (untrack()).
+// Timers live on a TimingWheel with one-second ticks, so arming and
+// cancelling stay O(1) with millions of open tickets.
+//
+// Breaches are passed to the breach handler (see TicketService::escalateTicket)
+// outside the scheduler lock, on the thread calling advanceTo() or on the
+// scheduler's own thread after start().
+class SlaScheduler {
+public:
+    using Clock = std::chrono::system_clock;
+    using BreachHandler = std::function<void(const SlaBreach&)>;
+
+private:
+    struct Pending {
+        std::string ticketId;
+        TicketStatus status = TicketStatus::OPEN;
+        Priority priority = Priority::LOW;
+    };
+
+    SlaPolicy policy;
+    BreachHandler onBreach;
+
+    std::mutex mtx;
+    TimingWheel<Pending> wheel;
+    std::unordered_map<std::string, TimingWheel<Pending>::TimerId> timers;
+    SlaStats stats;
+
+    std::thread worker;
+    std::condition_variable wake;
+    bool running = false;
+
+    static std::uint64_t toTick(Clock::time_point t) {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count());
+    }
+
+public:
+    explicit SlaScheduler(SlaPolicy p = {}, Clock::time_point start = Clock::now())
+        : policy(std::move(p)), wheel(toTick(start)) {}
+
+    ~SlaScheduler() { stop(); }
+
+    SlaScheduler(const SlaScheduler&) = delete;
+    SlaScheduler& operator=(const SlaScheduler&) = delete;
+
+    void setBreachHandler(BreachHandler handler) {
+        std::lock_guard<std::mutex> lock(mtx);
+        onBreach = std::move(handler);
+    }
+
+    const SlaPolicy& getPolicy() const { return policy; }
+
+    // (Re)starts the ticket's SLA clock for its current status and priority
+    void track(const std::string& ticketId, TicketStatus status, Priority priority,
+               Clock::time_point since = Clock::now()) {
+        const auto limit = policy.deadlineFor(status, priority);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = timers.find(ticketId);
+        if (it != timers.end()) {
+            if (wheel.cancel(it->second)) ++stats.cancelled;
+            if (limit.count() <= 0) {
+                timers.erase(it);
+                return;
+            }
+        } else if (limit.count() <= 0) {
+            return;
+        }
+
+        const auto id = wheel.schedule(toTick(since + limit), Pending{ticketId, status, priority});
+        if (it != timers.end()) it->second = id;
+        else timers.emplace(ticketId, id);
+        ++stats.armed;
+    }
+
+    void untrack(const std::string& ticketId) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = timers.find(ticketId);
+        if (it == timers.end()) return;
+        if (wheel.cancel(it->second)) ++stats.cancelled;
+        timers.erase(it);
+    }
+
+    // Fires every deadline up to `now`; returns the number of breaches
+    std::size_t advanceTo(Clock::time_point now = Clock::now()) {
+        std::vector<SlaBreach> breaches;
+        BreachHandler handler;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            wheel.advanceTo(toTick(now), [&](Pending& p, std::uint64_t tick) {
+                timers.erase(p.ticketId);
+                breaches.push_back(SlaBreach{std::move(p.ticketId), p.status, p.priority,
+                                             Clock::time_point(std::chrono::seconds(tick))});
+            });
+            stats.breached += breaches.size();
+            handler = onBreach;
+        }
+        if (handler) {
+            for (const auto& b : breaches) handler(b);
+        }
+        return breaches.size();
+    }
+
+    // Advances once per second on a background thread until stop()
+    void start() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (running) return;
+        running = true;
+        worker = std::thread([this] {
+            std::unique_lock<std::mutex> lock(mtx);
+            while (running) {
+                wake.wait_for(lock, std::chrono::seconds(1));
+                if (!running) break;
+                lock.unlock();
+                advanceTo();
+                lock.lock();
+            }
+        });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!running) return;
+            running = false;
+        }
+        wake.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+    SlaStats getStats() {
+        std::lock_guard<std::mutex> lock(mtx);
+        SlaStats s = stats;
+        s.pending = wheel.size();
+        return s;
+    }
+};
+
+} // namespace domain
+
+#endif
@@ -1,17 +1,68 @@
 #ifndef SUPPORT_FACADE_HPP
 #define SUPPORT_FACADE_HPP
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "../models/Enums.hpp"
+#include "../behaviors/chain/TicketCreationRequest.hpp"
+#include "../behaviors/chain/TicketValidation.hpp"
+#include "../util/BoundedQueue.hpp"
 #include "CustomerService.hpp"
 #include "TicketService.hpp"
 #include "NotificationService.hpp"
 
 namespace domain {
 
+// One customer and their first ticket
+struct OnboardingRequest {
+    std::string name;
+    std::string email;
+    std::string phone;
+    std::string issueDescription;
+    Priority priority = Priority::MEDIUM;
+    TicketCategory category = TicketCategory::GENERAL;
+    CustomerType type = CustomerType::REGULAR;
+};
+
+// Either both ids are set, or neither and error says why
+struct OnboardingResult {
+    std::string customerId;
+    std::string ticketId;
+    std::string error;
+
+    bool succeeded() const { return !ticketId.empty(); }
+};
+
+struct OnboardingStageStats {
+    const char* name = "";
+    std::size_t items = 0;
+    double busySeconds = 0;   // time spent working, not waiting for the previous stage
+
+    double itemsPerSecond() const {
+        return busySeconds > 0 ? static_cast<double>(items) / busySeconds : 0;
+    }
+};
+
+struct BatchOnboardingOptions {
+    std::size_t chunkSize = 64;            // requests handed between stages at a time
+    std::size_t queueDepth = 8;            // chunks waiting in front of each stage
+};
+
+struct BatchOnboardingReport {
+    std::vector<OnboardingResult> results;                 // in request order
+    std::array<OnboardingStageStats, 4> stages;            // validate, register, create, notify
+    std::size_t succeeded = 0;
+    std::size_t failed = 0;
+    double seconds = 0;
+};
+
 // Facade over CustomerService, TicketService and NotificationService
 class SupportFacade {
 private:
@@ -19,6 +70,48 @@ private:
     std::shared_ptr<TicketService>   ticketService;
     NotificationService&             notifier;
 
+    // Requests [begin, end) of a batch, passed from stage to stage
+    struct Chunk {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    void sendWelcome(const std::string& name, const std::string& email, const std::string& ticketId) {
+        notifier.notify(
+            email,
+            "Hello " + name +
+            ", your support ticket " + ticketId +
+            " has been created. Our team will contact you soon."
+        );
+    }
+
+    // Creates the chunk's tickets in one batch; customers whose ticket could
+    // not be created are removed again
+    void openTickets(const std::vector<OnboardingRequest>& requests,
+                     std::vector<OnboardingResult>& results, Chunk chunk) {
+        std::vector<NewTicket> batch;
+        std::vector<std::size_t> owners;
+        for (std::size_t i = chunk.begin; i < chunk.end; ++i) {
+            if (results[i].customerId.empty()) continue;
+            const auto& r = requests[i];
+            batch.push_back({results[i].customerId, r.issueDescription, r.priority, r.category, false});
+            owners.push_back(i);
+        }
+        if (batch.empty()) return;
+
+        const auto ticketIds = ticketService->createTickets(std::move(batch));
+        for (std::size_t k = 0; k < owners.size(); ++k) {
+            OnboardingResult& result = results[owners[k]];
+            if (!ticketIds[k].empty()) {
+                result.ticketId = ticketIds[k];
+                continue;
+            }
+            customerService->removeCustomer(result.customerId);
+            result.customerId.clear();
+            result.error = "Ticket could not be created";
+        }
+    }
+
 public:
     SupportFacade(std::shared_ptr<CustomerService> cs,
                   std::shared_ptr<TicketService> ts,
@@ -27,6 +120,11 @@ public:
         , ticketService(std::move(ts))
         , notifier(n) {}
 
+    // All or nothing: if the ticket cannot be created the customer is
+    // removed again. The customer gets a single welcome message.
+    //
+    // The ticket is not validated here; check it with
+    // TicketValidation::validateForNewCustomer() first.
     std::pair<std::string, std::string> registerCustomerAndOpenTicket(
         const std::string& name,
         const std::string& email,
@@ -45,26 +143,120 @@ public:
             return {"", ""};
         }
 
-        const std::string ticketId = ticketService->createTicket(
-            customerId,
-            issueDescription,
-            priority,
-            category
-        );
+        auto ticketIds = ticketService->createTickets({{customerId, issueDescription, priority, category, false}});
+        const std::string ticketId = ticketIds.front();
 
         if (ticketId.empty()) {
-            return {customerId, ""};
+            customerService->removeCustomer(customerId);
+            return {"", ""};
         }
 
-        notifier.notify(
-            email,
-            "Hello " + name +
-            ", your support ticket " + ticketId +
-            " has been created. Our team will contact you soon."
-        );
+        sendWelcome(name, email, ticketId);
 
         return {customerId, ticketId};
     }
+
+    // Onboards many customers at once. Validation, registration, ticket
+    // creation and notification run as a pipeline, each stage on its own
+    // thread and working on chunks of requests, so e.g. registering chunk
+    // n+1 overlaps with creating the tickets of chunk n.
+    //
+    // Tickets are checked with validation.validateForNewCustomer(). Each
+    // request is all or nothing, like registerCustomerAndOpenTicket(); a
+    // failed request does not affect the others.
+    BatchOnboardingReport registerCustomersAndOpenTickets(const std::vector<OnboardingRequest>& requests,
+                                                          const behaviors::chain::TicketValidation& validation,
+                                                          const BatchOnboardingOptions& options = {}) {
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+
+        BatchOnboardingReport report;
+        report.results.resize(requests.size());
+        report.stages = {{{"validate"}, {"register"}, {"create"}, {"notify"}}};
+        auto& results = report.results;
+
+        const std::size_t chunkSize = std::max<std::size_t>(1, options.chunkSize);
+        BoundedBlockingQueue<Chunk> toRegister(options.queueDepth);
+        BoundedBlockingQueue<Chunk> toCreate(options.queueDepth);
+        BoundedBlockingQueue<Chunk> toNotify(options.queueDepth);
+
+        // Runs work(chunk) on every chunk from `in`, timing it, then passes it on
+        auto stage = [](OnboardingStageStats& stats, BoundedBlockingQueue<Chunk>& in,
+                        BoundedBlockingQueue<Chunk>* out, auto&& work) {
+            Chunk chunk;
+            while (in.pop(chunk)) {
+                const auto began = Clock::now();
+                work(chunk);
+                stats.busySeconds += std::chrono::duration<double>(Clock::now() - began).count();
+                stats.items += chunk.end - chunk.begin;
+                if (out) out->push(chunk);
+            }
+            if (out) out->close();
+        };
+
+        std::thread validator([&] {
+            auto& stats = report.stages[0];
+
+            for (std::size_t begin = 0; begin < requests.size(); begin += chunkSize) {
+                const Chunk chunk{begin, std::min(requests.size(), begin + chunkSize)};
+                const auto began = Clock::now();
+                for (std::size_t i = chunk.begin; i < chunk.end; ++i) {
+                    const auto& r = requests[i];
+                    if (r.name.empty()) {
+                        results[i].error = "Name is required";
+                        continue;
+                    }
+                    if (r.email.find('@') == std::string::npos) {
+                        results[i].error = "Invalid email: " + r.email;
+                        continue;
+                    }
+                    behaviors::chain::TicketCreationRequest ticket;
+                    ticket.description = r.issueDescription;
+                    ticket.priority = r.priority;
+                    ticket.category = r.category;
+                    if (!validation.validateForNewCustomer(ticket)) results[i].error = ticket.errorMessage;
+                }
+                stats.busySeconds += std::chrono::duration<double>(Clock::now() - began).count();
+                stats.items += chunk.end - chunk.begin;
+                toRegister.push(chunk);
+            }
+            toRegister.close();
+        });
+
+        std::thread registrar([&] {
+            stage(report.stages[1], toRegister, &toCreate, [&](Chunk chunk) {
+                for (std::size_t i = chunk.begin; i < chunk.end; ++i) {
+                    if (!results[i].error.empty()) continue;
+                    const auto& r = requests[i];
+                    results[i].customerId = customerService->registerCustomer(r.name, r.email, r.phone, r.type);
+                    if (results[i].customerId.empty()) results[i].error = "Customer could not be registered";
+                }
+            });
+        });
+
+        std::thread creator([&] {
+            stage(report.stages[2], toCreate, &toNotify, [&](Chunk chunk) {
+                openTickets(requests, results, chunk);
+            });
+        });
+
+        stage(report.stages[3], toNotify, nullptr, [&](Chunk chunk) {
+            for (std::size_t i = chunk.begin; i < chunk.end; ++i) {
+                if (results[i].succeeded()) sendWelcome(requests[i].name, requests[i].email, results[i].ticketId);
+            }
+        });
+
+        validator.join();
+        registrar.join();
+        creator.join();
+
+        for (const auto& r : results) {
+            if (r.succeeded()) ++report.succeeded;
+            else ++report.failed;
+        }
+        report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return report;
+    }
 };
 
 } // namespace domain
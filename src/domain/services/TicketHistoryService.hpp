@@ -0,0 +1,476 @@
+#ifndef TICKET_HISTORY_SERVICE_HPP
+#define TICKET_HISTORY_SERVICE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../models/Enums.hpp"
+#include "../models/Ticket.hpp"
+#include "../util/VarInt.hpp"
+
+namespace domain {
+
+enum class TicketHistoryEventType : std::uint8_t {
+    CREATED,
+    STATUS_CHANGED,
+    PRIORITY_CHANGED,
+    ASSIGNED,
+    TAG_ADDED
+};
+
+struct TicketHistoryEvent {
+    TicketHistoryEventType type;
+    std::int64_t atMs = 0;     // milliseconds since the epoch
+
+    // Set depending on type
+    TicketStatus status = TicketStatus::OPEN;
+    Priority priority = Priority::LOW;
+    TicketCategory category = TicketCategory::GENERAL;
+    std::string customerId;    // CREATED
+    std::string text;          // CREATED: description, ASSIGNED: agent, TAG_ADDED: tag
+};
+
+// A ticket as rebuilt from its history
+struct TicketSnapshot {
+    std::string id;
+    std::string customerId;
+    std::string description;
+    TicketStatus status = TicketStatus::OPEN;
+    Priority priority = Priority::LOW;
+    TicketCategory category = TicketCategory::GENERAL;
+    std::string assignedTo;
+    std::vector<std::string> tags;
+    std::int64_t createdAtMs = 0;
+    std::int64_t updatedAtMs = 0;
+    std::size_t eventCount = 0;
+
+    void apply(const TicketHistoryEvent& e) {
+        switch (e.type) {
+            case TicketHistoryEventType::CREATED:
+                customerId = e.customerId;
+                description = e.text;
+                status = e.status;
+                priority = e.priority;
+                category = e.category;
+                createdAtMs = e.atMs;
+                break;
+            case TicketHistoryEventType::STATUS_CHANGED:   status = e.status; break;
+            case TicketHistoryEventType::PRIORITY_CHANGED: priority = e.priority; break;
+            case TicketHistoryEventType::ASSIGNED:         assignedTo = e.text; break;
+            case TicketHistoryEventType::TAG_ADDED:        tags.push_back(e.text); break;
+        }
+        updatedAtMs = e.atMs;
+        ++eventCount;
+    }
+
+    std::shared_ptr<Ticket> toTicket() const {
+        auto ticket = std::make_shared<Ticket>(id, customerId, description, priority, category, status);
+        ticket->setCreatedAt(static_cast<std::time_t>(createdAtMs / 1000));
+        ticket->setAssignedTo(assignedTo);
+        for (const auto& tag : tags) ticket->addTag(tag);
+        return ticket;
+    }
+};
+
+struct TicketHistoryOptions {
+    // Store a snapshot every N events so replay decodes at most N events
+    std::size_t snapshotInterval = 64;
+};
+
+struct TicketHistoryStats {
+    std::size_t tickets = 0;
+    std::size_t events = 0;
+    std::size_t logBytes = 0;
+    std::size_t snapshots = 0;
+    std::size_t compactedTickets = 0;
+    std::size_t dictionaryStrings = 0;
+};
+
+// Append-only change log per ticket.
+//
+// Events are encoded into a byte vector per ticket: a header byte (event type
+// in the low nibble, status/priority in the high nibble), the time since the
+// ticket's previous event as a varint, then the payload. Customer ids,
+// agents and tags are stored once in a shared dictionary and referenced by
+// index; descriptions are stored inline. A typical status change takes 2-4
+// bytes.
+//
+// Each log has its own lock, so recording for different tickets does not
+// contend; the ticket map and the dictionary are read-mostly.
+class TicketHistoryService {
+private:
+    struct Snapshot {
+        std::size_t offset;       // byte offset of the next event
+        TicketSnapshot state;
+    };
+
+    struct TicketLog {
+        mutable std::mutex mtx;
+        std::vector<std::uint8_t> bytes;
+        std::int64_t lastAtMs = 0;
+        std::size_t eventCount = 0;
+        std::vector<Snapshot> snapshots;
+        TicketSnapshot current;   // state after the last event
+        bool compacted = false;
+    };
+
+    TicketHistoryOptions options;
+
+    mutable std::shared_mutex logsMtx;
+    std::unordered_map<std::string, std::unique_ptr<TicketLog>> logs;
+
+    mutable std::shared_mutex dictMtx;
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, std::uint32_t> stringIds;
+
+    static std::int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    std::uint32_t intern(const std::string& s) {
+        {
+            std::shared_lock<std::shared_mutex> lock(dictMtx);
+            auto it = stringIds.find(s);
+            if (it != stringIds.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(dictMtx);
+        auto [it, inserted] = stringIds.try_emplace(s, static_cast<std::uint32_t>(strings.size()));
+        if (inserted) strings.push_back(s);
+        return it->second;
+    }
+
+    std::string lookup(std::uint64_t index) const {
+        std::shared_lock<std::shared_mutex> lock(dictMtx);
+        return index < strings.size() ? strings[index] : std::string();
+    }
+
+    TicketLog& logFor(const std::string& ticketId) {
+        {
+            std::shared_lock<std::shared_mutex> lock(logsMtx);
+            auto it = logs.find(ticketId);
+            if (it != logs.end()) return *it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(logsMtx);
+        auto& log = logs[ticketId];
+        if (!log) {
+            log = std::make_unique<TicketLog>();
+            log->current.id = ticketId;
+        }
+        return *log;
+    }
+
+    const TicketLog* findLog(const std::string& ticketId) const {
+        std::shared_lock<std::shared_mutex> lock(logsMtx);
+        auto it = logs.find(ticketId);
+        return it == logs.end() ? nullptr : it->second.get();
+    }
+
+    void encode(TicketLog& log, const TicketHistoryEvent& e) {
+        std::uint8_t small = 0;
+        if (e.type == TicketHistoryEventType::CREATED || e.type == TicketHistoryEventType::STATUS_CHANGED)
+            small = static_cast<std::uint8_t>(e.status);
+        else if (e.type == TicketHistoryEventType::PRIORITY_CHANGED)
+            small = static_cast<std::uint8_t>(e.priority);
+
+        log.bytes.push_back(static_cast<std::uint8_t>(static_cast<std::uint8_t>(e.type) | small << 4));
+        appendVarint(log.bytes, static_cast<std::uint64_t>(e.atMs - log.lastAtMs));
+
+        switch (e.type) {
+            case TicketHistoryEventType::CREATED:
+                log.bytes.push_back(static_cast<std::uint8_t>(
+                    static_cast<std::uint8_t>(e.priority) | static_cast<std::uint8_t>(e.category) << 4));
+                appendVarint(log.bytes, intern(e.customerId));
+                appendBytes(log.bytes, e.text);
+                break;
+            case TicketHistoryEventType::ASSIGNED:
+            case TicketHistoryEventType::TAG_ADDED:
+                appendVarint(log.bytes, intern(e.text));
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Decodes one event at pos; prevAtMs is the previous event's time.
+    bool decode(const std::vector<std::uint8_t>& bytes, std::size_t& pos,
+                std::int64_t prevAtMs, TicketHistoryEvent& e) const {
+        const std::uint8_t* data = bytes.data();
+        const std::size_t size = bytes.size();
+        if (pos >= size) return false;
+
+        const std::uint8_t header = data[pos++];
+        e.type = static_cast<TicketHistoryEventType>(header & 0x0f);
+        const std::uint8_t small = header >> 4;
+
+        std::uint64_t delta = 0;
+        if (!readVarint(data, size, pos, delta)) return false;
+        e.atMs = prevAtMs + static_cast<std::int64_t>(delta);
+
+        std::uint64_t index = 0;
+        switch (e.type) {
+            case TicketHistoryEventType::CREATED: {
+                if (pos >= size) return false;
+                const std::uint8_t packed = data[pos++];
+                e.status = static_cast<TicketStatus>(small);
+                e.priority = static_cast<Priority>(packed & 0x0f);
+                e.category = static_cast<TicketCategory>(packed >> 4);
+                if (!readVarint(data, size, pos, index)) return false;
+                e.customerId = lookup(index);
+                return readBytes(data, size, pos, e.text);
+            }
+            case TicketHistoryEventType::STATUS_CHANGED:
+                e.status = static_cast<TicketStatus>(small);
+                return true;
+            case TicketHistoryEventType::PRIORITY_CHANGED:
+                e.priority = static_cast<Priority>(small);
+                return true;
+            case TicketHistoryEventType::ASSIGNED:
+            case TicketHistoryEventType::TAG_ADDED:
+                if (!readVarint(data, size, pos, index)) return false;
+                e.text = lookup(index);
+                return true;
+        }
+        return false;
+    }
+
+    void append(const std::string& ticketId, TicketHistoryEvent e) {
+        TicketLog& log = logFor(ticketId);
+        std::lock_guard<std::mutex> lock(log.mtx);
+
+        // Keep per-ticket time monotonic so deltas stay unsigned
+        e.atMs = std::max(e.atMs, log.lastAtMs);
+        encode(log, e);
+        log.lastAtMs = e.atMs;
+        log.current.apply(e);
+        ++log.eventCount;
+        log.compacted = false;
+
+        if (options.snapshotInterval > 0 && log.eventCount % options.snapshotInterval == 0)
+            log.snapshots.push_back(Snapshot{log.bytes.size(), log.current});
+    }
+
+public:
+    explicit TicketHistoryService(TicketHistoryOptions opts = {})
+        : options(opts) {}
+
+    // -------- recording --------
+    void recordCreated(const Ticket& ticket, std::int64_t atMs = nowMs()) {
+        TicketHistoryEvent e;
+        e.type = TicketHistoryEventType::CREATED;
+        e.atMs = atMs;
+        e.status = ticket.getStatus();
+        e.priority = ticket.getPriority();
+        e.category = ticket.getCategory();
+        e.customerId = ticket.getCustomerId();
+        e.text = ticket.getDescription();
+        append(ticket.getId(), std::move(e));
+    }
+
+    void recordStatusChanged(const std::string& ticketId, TicketStatus status, std::int64_t atMs = nowMs()) {
+        TicketHistoryEvent e;
+        e.type = TicketHistoryEventType::STATUS_CHANGED;
+        e.atMs = atMs;
+        e.status = status;
+        append(ticketId, std::move(e));
+    }
+
+    void recordPriorityChanged(const std::string& ticketId, Priority priority, std::int64_t atMs = nowMs()) {
+        TicketHistoryEvent e;
+        e.type = TicketHistoryEventType::PRIORITY_CHANGED;
+        e.atMs = atMs;
+        e.priority = priority;
+        append(ticketId, std::move(e));
+    }
+
+    void recordAssigned(const std::string& ticketId, const std::string& agent, std::int64_t atMs = nowMs()) {
+        TicketHistoryEvent e;
+        e.type = TicketHistoryEventType::ASSIGNED;
+        e.atMs = atMs;
+        e.text = agent;
+        append(ticketId, std::move(e));
+    }
+
+    void recordTagAdded(const std::string& ticketId, const std::string& tag, std::int64_t atMs = nowMs()) {
+        TicketHistoryEvent e;
+        e.type = TicketHistoryEventType::TAG_ADDED;
+        e.atMs = atMs;
+        e.text = tag;
+        append(ticketId, std::move(e));
+    }
+
+    // -------- reading --------
+    std::vector<TicketHistoryEvent> getEvents(const std::string& ticketId) const {
+        std::vector<TicketHistoryEvent> events;
+        const TicketLog* log = findLog(ticketId);
+        if (!log) return events;
+
+        std::lock_guard<std::mutex> lock(log->mtx);
+        std::size_t pos = 0;
+        std::int64_t at = 0;
+        TicketHistoryEvent e;
+        while (decode(log->bytes, pos, at, e)) {
+            at = e.atMs;
+            events.push_back(e);
+        }
+        return events;
+    }
+
+    // The ticket as it was at atMs: replay starts from the latest snapshot
+    // taken at or before that time.
+    std::optional<TicketSnapshot> rebuildAt(const std::string& ticketId, std::int64_t atMs) const {
+        const TicketLog* log = findLog(ticketId);
+        if (!log) return std::nullopt;
+
+        std::lock_guard<std::mutex> lock(log->mtx);
+        if (atMs >= log->lastAtMs) return log->current;
+
+        auto it = std::upper_bound(log->snapshots.begin(), log->snapshots.end(), atMs,
+            [](std::int64_t t, const Snapshot& s) { return t < s.state.updatedAtMs; });
+
+        TicketSnapshot state;
+        state.id = ticketId;
+        std::size_t pos = 0;
+        if (it != log->snapshots.begin()) {
+            state = std::prev(it)->state;
+            pos = std::prev(it)->offset;
+        }
+
+        TicketHistoryEvent e;
+        std::int64_t at = state.updatedAtMs;
+        while (decode(log->bytes, pos, at, e) && e.atMs <= atMs) {
+            at = e.atMs;
+            state.apply(e);
+        }
+        if (state.eventCount == 0) return std::nullopt;  // did not exist yet
+        return state;
+    }
+
+    std::optional<TicketSnapshot> current(const std::string& ticketId) const {
+        const TicketLog* log = findLog(ticketId);
+        if (!log) return std::nullopt;
+        std::lock_guard<std::mutex> lock(log->mtx);
+        return log->current;
+    }
+
+    // Milliseconds from creation to the first RESOLVED (or CLOSED) status
+    std::optional<std::int64_t> timeToResolution(const std::string& ticketId) const {
+        std::optional<std::int64_t> created;
+        for (const auto& e : getEvents(ticketId)) {
+            if (e.type == TicketHistoryEventType::CREATED) created = e.atMs;
+            if (e.type == TicketHistoryEventType::STATUS_CHANGED && created &&
+                (e.status == TicketStatus::RESOLVED || e.status == TicketStatus::CLOSED))
+                return e.atMs - *created;
+        }
+        return std::nullopt;
+    }
+
+    // -------- maintenance --------
+
+    // Rewrites the logs of tickets that have been CLOSED since before
+    // closedBeforeMs: creation and every status change are kept (so
+    // resolution metrics still work), while priority/assignee/tag changes
+    // are folded into their final values at the time of closing. Returns the
+    // number of bytes saved. Tickets reopened later keep appending normally.
+    std::size_t compactClosed(std::int64_t closedBeforeMs) {
+        std::vector<TicketLog*> candidates;
+        {
+            std::shared_lock<std::shared_mutex> lock(logsMtx);
+            for (auto& [id, log] : logs) candidates.push_back(log.get());
+        }
+
+        std::size_t saved = 0;
+        for (TicketLog* log : candidates) {
+            std::lock_guard<std::mutex> lock(log->mtx);
+            if (log->compacted || log->current.status != TicketStatus::CLOSED ||
+                log->lastAtMs >= closedBeforeMs)
+                continue;
+
+            std::vector<TicketHistoryEvent> kept;
+            std::size_t pos = 0;
+            std::int64_t at = 0;
+            TicketHistoryEvent e;
+            while (decode(log->bytes, pos, at, e)) {
+                at = e.atMs;
+                if (e.type == TicketHistoryEventType::CREATED ||
+                    e.type == TicketHistoryEventType::STATUS_CHANGED)
+                    kept.push_back(e);
+            }
+
+            const TicketSnapshot final = log->current;
+            const std::size_t before = log->bytes.size() +
+                                       log->snapshots.size() * sizeof(Snapshot);
+
+            log->bytes.clear();
+            log->snapshots.clear();
+            log->snapshots.shrink_to_fit();
+            log->lastAtMs = 0;
+            log->eventCount = 0;
+            log->current = TicketSnapshot{};
+            log->current.id = final.id;
+
+            auto replay = [&](const TicketHistoryEvent& ev) {
+                encode(*log, ev);
+                log->lastAtMs = ev.atMs;
+                log->current.apply(ev);
+                ++log->eventCount;
+            };
+
+            for (auto& ev : kept) {
+                // Fold the final priority into creation; assignee and tags follow
+                if (ev.type == TicketHistoryEventType::CREATED) ev.priority = final.priority;
+                replay(ev);
+            }
+            if (!final.assignedTo.empty()) {
+                TicketHistoryEvent ev;
+                ev.type = TicketHistoryEventType::ASSIGNED;
+                ev.atMs = final.updatedAtMs;
+                ev.text = final.assignedTo;
+                replay(ev);
+            }
+            for (const auto& tag : final.tags) {
+                TicketHistoryEvent ev;
+                ev.type = TicketHistoryEventType::TAG_ADDED;
+                ev.atMs = final.updatedAtMs;
+                ev.text = tag;
+                replay(ev);
+            }
+
+            log->bytes.shrink_to_fit();
+            log->compacted = true;
+            const std::size_t after = log->bytes.size();
+            if (before > after) saved += before - after;
+        }
+        return saved;
+    }
+
+    TicketHistoryStats getStats() const {
+        TicketHistoryStats stats;
+        {
+            std::shared_lock<std::shared_mutex> lock(logsMtx);
+            for (const auto& [id, log] : logs) {
+                std::lock_guard<std::mutex> logLock(log->mtx);
+                ++stats.tickets;
+                stats.events += log->eventCount;
+                stats.logBytes += log->bytes.size();
+                stats.snapshots += log->snapshots.size();
+                if (log->compacted) ++stats.compactedTickets;
+            }
+        }
+        std::shared_lock<std::shared_mutex> lock(dictMtx);
+        stats.dictionaryStrings = strings.size();
+        return stats;
+    }
+};
+
+} // namespace domain
+
+#endif
@@ -1,8 +1,16 @@
 #ifndef TICKET_SERVICE_HPP
 #define TICKET_SERVICE_HPP
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "../models/Ticket.hpp"
@@ -11,10 +19,57 @@
 #include "../interfaces/ITicketRepository.hpp"
 #include "../interfaces/ICustomerRepository.hpp"
 #include "../factory/TicketFactory.hpp"
+#include "../behaviors/state/TicketTransitions.hpp"
+#include "../behaviors/observer/TicketEventBus.hpp"
+#include "../util/Arena.hpp"
+#include "../util/BloomFilter.hpp"
+#include "../util/IdNumber.hpp"
 #include "NotificationService.hpp"
+#include "TicketHistoryService.hpp"
+#include "SlaScheduler.hpp"
+#include "AgentAssignmentService.hpp"
+#include "WorkQueueService.hpp"
 
 namespace domain {
 
+enum class StatusUpdateResult {
+    UPDATED,
+    NOT_FOUND,
+    ILLEGAL_TRANSITION,  // not allowed by the state machine from the current status
+    CONFLICT             // the status changed concurrently; re-read and decide again
+};
+
+struct BulkTransitionOptions {
+    unsigned threads = 0;                  // 0 = one per hardware thread
+    bool notifyCustomers = true;           // one notification per affected customer
+    std::size_t idsPerMessage = 20;        // ticket ids listed in a notification
+    std::size_t idsPerLogLine = 100;
+};
+
+struct BulkTransitionReport {
+    std::size_t scanned = 0;
+    std::size_t selected = 0;
+    std::size_t updated = 0;
+    std::size_t skipped = 0;        // selected, but newStatus is not reachable from their status
+    std::size_t conflicts = 0;      // compare-and-swaps lost to concurrent updates (then retried)
+    std::size_t notifications = 0;
+    std::size_t logLines = 0;
+    double seconds = 0;
+
+    double ticketsPerSecond() const {
+        return seconds > 0 ? static_cast<double>(scanned) / seconds : 0;
+    }
+};
+
+// One ticket of a TicketService::createTickets() batch
+struct NewTicket {
+    std::string customerId;
+    std::string description;
+    Priority priority = Priority::MEDIUM;
+    TicketCategory category = TicketCategory::GENERAL;
+    bool notifyCustomer = true;   // false when the caller sends its own message
+};
+
 class TicketService {
 private:
     ITicketRepository& tRepo;
@@ -24,7 +79,34 @@ private:
 
     std::unique_ptr<AbstractTicketFactory> factory;
 
-    int ticketCounter = 1000;
+    // Optional, see CustomerService::getIdFilter()
+    std::shared_ptr<const BloomFilter> customerFilter;
+
+    // Optional change log, see setHistory()
+    std::shared_ptr<TicketHistoryService> history;
+
+    // Optional SLA deadlines, see setSlaScheduler()
+    std::shared_ptr<SlaScheduler> sla;
+
+    // Optional, see setEventBus()
+    std::shared_ptr<behaviors::observer::TicketEventBus> events;
+
+    // Optional, see setAssignmentService()
+    std::shared_ptr<AgentAssignmentService> assignments;
+
+    // Optional, see setWorkQueues()
+    std::shared_ptr<WorkQueueService> queues;
+
+    std::atomic<int> ticketCounter{1000};
+
+    // A ticket's changes and the hooks that follow them (history, SLA timer,
+    // agent loads, work queues, events) run under its stripe, so the hooks
+    // see each ticket's changes in the order they were made
+    std::array<std::mutex, 64> stripes;
+
+    std::mutex& stripeFor(const std::string& id) {
+        return stripes[std::hash<std::string>{}(id) % stripes.size()];
+    }
 
 public:
     TicketService(
@@ -36,13 +118,369 @@ public:
     )
         : tRepo(t), cRepo(c), notifier(n), logger(l), factory(std::move(f)) {}
 
+    void setCustomerFilter(std::shared_ptr<const BloomFilter> filter) {
+        customerFilter = std::move(filter);
+    }
+
+    // Records creation, status, assignee and tag changes from now on
+    void setHistory(std::shared_ptr<TicketHistoryService> h) {
+        history = std::move(h);
+    }
+
+    // Arms an SLA timer on creation and on every status change. Breaches are
+    // reported to the scheduler's handler, which normally calls escalateTicket().
+    void setSlaScheduler(std::shared_ptr<SlaScheduler> scheduler) {
+        sla = std::move(scheduler);
+    }
+
+    // Publishes created, status changed and assigned events; subscribers
+    // handle them on their own threads. Events are published under the
+    // ticket's stripe, so a BLOCK subscriber must not change tickets itself.
+    void setEventBus(std::shared_ptr<behaviors::observer::TicketEventBus> bus) {
+        events = std::move(bus);
+    }
+
+    // New tickets go to the least-loaded qualified agent instead of the
+    // factory's fixed one; status changes and reassignments keep the agents'
+    // loads up to date
+    void setAssignmentService(std::shared_ptr<AgentAssignmentService> service) {
+        assignments = std::move(service);
+    }
+
+    // Keeps every OPEN ticket in its agent's (or team's) work queue, for
+    // nextTicket()
+    void setWorkQueues(std::shared_ptr<WorkQueueService> q) {
+        queues = std::move(q);
+    }
+
     std::string createTicket(
         const std::string& customerId,
-        const std::string& description,
+        std::string description,
         Priority priority,
         TicketCategory category = TicketCategory::GENERAL
     ) {
-        auto customer = cRepo.findById(customerId);
+        return create(customerId, std::move(description), priority, category, nullptr, true);
+    }
+
+    // Creates a batch of tickets, allocated together from one arena. Returns
+    // the new ids in request order, with "" where the customer was not found.
+    std::vector<std::string> createTickets(std::vector<NewTicket> requests) {
+        Arena arena(requests.size() * (sizeof(Ticket) + 64) + 1024);
+        std::vector<std::string> ids;
+        ids.reserve(requests.size());
+        for (auto& r : requests) {
+            ids.push_back(create(r.customerId, std::move(r.description), r.priority, r.category,
+                                 &arena, r.notifyCustomer));
+        }
+        return ids;
+    }
+
+    // Loads existing tickets (e.g. from a migration) as they are, replacing
+    // any with the same id. OPEN tickets join the work queues and assigned
+    // open tickets count towards their agent's load; history, SLA timers and
+    // events are not replayed. New tickets continue after the highest
+    // imported "TKT-<n>" id.
+    void importTickets(std::vector<std::shared_ptr<Ticket>> tickets) {
+        int highest = 0;
+        for (const auto& t : tickets) {
+            highest = std::max(highest, idNumber(t->getId(), "TKT-"));
+            const TicketStatus status = t->getStatus();
+            if (assignments && !t->getAssignedTo().empty())
+                assignments->transfer(t->getId(), t->getAssignedTo(), status);
+            if (queues && status == TicketStatus::OPEN)
+                queues->enqueue(t->getId(), t->getAssignedTo(), t->getCategory(), t->getPriority());
+        }
+        int current = ticketCounter.load();
+        while (current < highest && !ticketCounter.compare_exchange_weak(current, highest)) {}
+
+        const std::size_t count = tickets.size();
+        tRepo.storeAll(std::move(tickets));
+        logger->log("Tickets imported: " + std::to_string(count));
+    }
+
+    // Moves the ticket to newStatus from whatever status it has now, if the
+    // state machine allows it.
+    StatusUpdateResult updateTicketStatus(const std::string& id, TicketStatus newStatus) {
+        auto ticket = tRepo.findById(id);
+        if (!ticket) {
+            logger->log("Ticket not found: " + id);
+            return StatusUpdateResult::NOT_FOUND;
+        }
+        return transition(*ticket, ticket->getStatus(), newStatus);
+    }
+
+    // Moves the ticket from `expected` to newStatus; CONFLICT if it is no
+    // longer in `expected` (e.g. another agent got there first).
+    StatusUpdateResult updateTicketStatus(const std::string& id,
+                                          TicketStatus expected,
+                                          TicketStatus newStatus) {
+        auto ticket = tRepo.findById(id);
+        if (!ticket) {
+            logger->log("Ticket not found: " + id);
+            return StatusUpdateResult::NOT_FOUND;
+        }
+        return transition(*ticket, expected, newStatus);
+    }
+
+    bool assignTicket(const std::string& id, const std::string& agent) {
+        auto ticket = tRepo.findById(id);
+        if (!ticket) {
+            logger->log("Ticket not found: " + id);
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(stripeFor(id));
+            ticket->setAssignedTo(agent);
+            tRepo.save(*ticket);
+            onAssigned(id, agent, ticket->getStatus());
+        }
+
+        logger->log("Ticket " + id + " assigned to " + agent);
+        return true;
+    }
+
+    bool addTicketTag(const std::string& id, const std::string& tag) {
+        auto ticket = tRepo.findById(id);
+        if (!ticket) {
+            logger->log("Ticket not found: " + id);
+            return false;
+        }
+        ticket->addTag(tag);
+        tRepo.save(*ticket);
+        if (history) history->recordTagAdded(id, tag);
+        return true;
+    }
+
+    // Called when a ticket misses its SLA: raises its priority one level,
+    // reassigns it to the policy's escalation agent (if any), notifies the
+    // customer and restarts the SLA clock at the new priority. A ticket that
+    // is already CRITICAL and with the escalation agent is left alone and no
+    // longer tracked; returns false then.
+    bool escalateTicket(const std::string& id) {
+        auto ticket = tRepo.findById(id);
+        if (!ticket) {
+            logger->log("Ticket not found: " + id);
+            return false;
+        }
+
+        const std::string agent = sla ? sla->getPolicy().escalationAgent : std::string();
+        TicketStatus status;
+        Priority oldPriority;
+        Priority newPriority;
+        {
+            std::lock_guard<std::mutex> lock(stripeFor(id));
+            status = ticket->getStatus();
+            if (status == TicketStatus::RESOLVED || status == TicketStatus::CLOSED) return false;
+
+            oldPriority = ticket->getPriority();
+            newPriority = oldPriority == Priority::CRITICAL
+                ? Priority::CRITICAL
+                : static_cast<Priority>(static_cast<int>(oldPriority) + 1);
+            const bool reassign = !agent.empty() && ticket->getAssignedTo() != agent;
+
+            if (newPriority == oldPriority && !reassign) {
+                if (sla) sla->untrack(id);
+                logger->log("Ticket " + id + " missed its SLA again at " +
+                            TicketFactory::getPriorityName(oldPriority) + " priority; no longer tracked");
+                return false;
+            }
+
+            if (newPriority != oldPriority) {
+                ticket->setPriority(newPriority);
+                if (queues) queues->reprioritize(id, newPriority);
+                if (history) history->recordPriorityChanged(id, newPriority);
+            }
+            if (reassign) ticket->setAssignedTo(agent);
+            tRepo.save(*ticket);
+            if (reassign) onAssigned(id, agent, status);
+            if (sla) sla->track(id, status, newPriority);
+        }
+
+        logger->log("Ticket escalated: " + id + " (SLA missed in " +
+                    TicketFactory::getStatusName(status) + ", priority " +
+                    TicketFactory::getPriorityName(oldPriority) + " -> " +
+                    TicketFactory::getPriorityName(newPriority) + ")");
+
+        auto customer = cRepo.findById(ticket->getCustomerId());
+        if (customer) {
+            notifier.notify(
+                customer->getEmail(),
+                "Your ticket " + id + " has been escalated to " +
+                    TicketFactory::getPriorityName(newPriority) + " priority."
+            );
+        }
+        return true;
+    }
+
+    // Claims the most urgent OPEN ticket queued for the agent, or for a team
+    // they belong to (their skills; every team without an assignment
+    // service), assigns it to them and moves it to IN_PROGRESS. Returns its
+    // id, or "" if there is no work.
+    std::string nextTicket(const std::string& agent) {
+        if (!queues) return "";
+
+        std::vector<TicketCategory> teams;
+        if (assignments) teams = assignments->getSkills(agent);
+        else for (std::size_t c = 0; c < TicketCategoryCount; ++c) teams.push_back(static_cast<TicketCategory>(c));
+
+        while (auto id = queues->claim(agent, teams)) {
+            auto ticket = tRepo.findById(*id);
+            if (!ticket) continue;
+            // The claim is exclusive, but the status may have been changed
+            // directly since; such a ticket is skipped
+            if (transition(*ticket, TicketStatus::OPEN, TicketStatus::IN_PROGRESS) != StatusUpdateResult::UPDATED)
+                continue;
+            if (ticket->getAssignedTo() != agent) assignTicket(*id, agent);
+            return *id;
+        }
+        return "";
+    }
+
+    std::shared_ptr<Ticket> getTicket(const std::string& id) {
+        return tRepo.findById(id);
+    }
+
+    std::vector<std::shared_ptr<Ticket>> getAllTickets() {
+        return tRepo.findAll();
+    }
+
+    // Tickets in id order, a page at a time: pass the last id of a page to
+    // get the next one, "" for the first
+    std::vector<std::shared_ptr<Ticket>> getTicketsPage(const std::string& afterId, std::size_t limit) {
+        return tRepo.findPage(afterId, limit);
+    }
+
+    // Tickets carrying every one of `tags`, e.g. {"urgent", "finance"}
+    std::vector<std::shared_ptr<Ticket>> findTicketsByTags(const std::vector<std::string>& tags) {
+        TagSet required;
+        const auto& dictionary = TagDictionary::getInstance();
+        for (const auto& tag : tags) {
+            auto id = dictionary.find(tag);
+            if (!id) return {};   // no ticket has ever had this tag
+            required.add(*id);
+        }
+        return tRepo.findByAllTags(required);
+    }
+
+    using TicketPredicate = std::function<bool(const Ticket&)>;
+
+    // Moves every ticket matching `select` to newStatus, e.g.
+    //   transitionTickets([](const Ticket& t) { return t.getStatus() == TicketStatus::RESOLVED; },
+    //                     TicketStatus::CLOSED);
+    //
+    // Tickets are read once with findAll() and split over worker threads;
+    // each update is a compare-and-swap, re-checked against `select` if it
+    // loses a race. Instead of one log line and one notification per ticket,
+    // updated ids are logged in batches and each customer is notified once.
+    BulkTransitionReport transitionTickets(const TicketPredicate& select,
+                                           TicketStatus newStatus,
+                                           const BulkTransitionOptions& options = {}) {
+        const auto start = std::chrono::steady_clock::now();
+        BulkTransitionReport report;
+
+        const auto tickets = tRepo.findAll();
+        report.scanned = tickets.size();
+
+        struct WorkerResult {
+            std::size_t selected = 0, updated = 0, skipped = 0, conflicts = 0;
+            std::vector<const Ticket*> changed;
+        };
+
+        unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+        threads = std::max(1u, std::min<unsigned>(threads,
+                                                  static_cast<unsigned>(tickets.size() / 1024 + 1)));
+        std::vector<WorkerResult> results(threads);
+
+        auto work = [&](unsigned w) {
+            WorkerResult& r = results[w];
+            const std::size_t begin = tickets.size() * w / threads;
+            const std::size_t end = tickets.size() * (w + 1) / threads;
+
+            for (std::size_t i = begin; i < end; ++i) {
+                Ticket& ticket = *tickets[i];
+                if (!select(ticket)) continue;
+                ++r.selected;
+
+                TicketStatus current = ticket.getStatus();
+                for (;;) {
+                    if (!behaviors::state::canTransition(current, newStatus)) {
+                        ++r.skipped;
+                        break;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(stripeFor(ticket.getId()));
+                        if (tRepo.compareAndSetStatus(ticket, current, newStatus) ==
+                            ITicketRepository::CasResult::UPDATED) {
+                            onStatusChanged(ticket, current, newStatus);
+                            ++r.updated;
+                            r.changed.push_back(&ticket);
+                            break;
+                        }
+                    }
+                    ++r.conflicts;
+                    if (!select(ticket)) break;
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned w = 1; w < threads; ++w) workers.emplace_back(work, w);
+        work(0);
+        for (auto& t : workers) t.join();
+
+        std::unordered_map<std::string, std::vector<std::string>> changedByCustomer;
+        std::vector<std::string> changedIds;
+        for (const auto& r : results) {
+            report.selected += r.selected;
+            report.updated += r.updated;
+            report.skipped += r.skipped;
+            report.conflicts += r.conflicts;
+            for (const Ticket* t : r.changed) {
+                changedIds.push_back(t->getId());
+                if (options.notifyCustomers)
+                    changedByCustomer[t->getCustomerId()].push_back(changedIds.back());
+            }
+        }
+
+        const std::string statusName = TicketFactory::getStatusName(newStatus);
+        const std::size_t perLine = std::max<std::size_t>(1, options.idsPerLogLine);
+        for (std::size_t i = 0; i < changedIds.size(); i += perLine) {
+            const std::size_t end = std::min(changedIds.size(), i + perLine);
+            logger->log("Tickets updated to " + statusName + ": " + joinIds(changedIds, i, end));
+            ++report.logLines;
+        }
+
+        for (const auto& [customerId, ids] : changedByCustomer) {
+            auto customer = cRepo.findById(customerId);
+            if (!customer) continue;
+
+            const std::size_t listed = std::min(ids.size(), options.idsPerMessage);
+            std::string message = std::to_string(ids.size()) +
+                                  (ids.size() == 1 ? " ticket was" : " tickets were") +
+                                  " updated to " + statusName + ": " + joinIds(ids, 0, listed);
+            if (listed < ids.size())
+                message += " and " + std::to_string(ids.size() - listed) + " more";
+
+            notifier.notify(customer->getEmail(), message);
+            ++report.notifications;
+        }
+
+        report.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        logger->log("Bulk status update to " + statusName + ": " +
+                    std::to_string(report.updated) + " of " + std::to_string(report.selected) +
+                    " selected tickets updated");
+        ++report.logLines;
+        return report;
+    }
+
+private:
+    std::string create(const std::string& customerId, std::string description,
+                       Priority priority, TicketCategory category, Arena* arena,
+                       bool notifyCustomer) {
+        std::shared_ptr<Customer> customer;
+        if (!customerFilter || customerFilter->mightContain(customerId))
+            customer = cRepo.findById(customerId);
 
         if (!customer) {
             logger->log("Failed to create ticket: Customer not found: " + customerId);
@@ -54,36 +492,109 @@ public:
         auto ticket = factory->createTicket(
             id,
             customerId,
-            description,
+            std::move(description),
             priority,
-            category
+            category,
+            arena
         );
+        if (assignments)
+            ticket->setAssignedTo(assignments->assign(id, category, priority).value_or(std::string()));
 
-        tRepo.save(*ticket);
+        {
+            // Held from the store on, so the ticket cannot change before its hooks ran
+            std::lock_guard<std::mutex> lock(stripeFor(id));
+            tRepo.store(ticket);
+            const std::string agent = ticket->getAssignedTo();
+            if (queues) queues->enqueue(id, agent, category, priority);
+            if (history) history->recordCreated(*ticket);
+            if (sla) sla->track(id, ticket->getStatus(), priority);
+            if (events) {
+                events->publish(behaviors::observer::TicketCreated{id, customerId, priority, category});
+                if (!agent.empty()) events->publish(behaviors::observer::TicketAssigned{id, agent});
+            }
+        }
 
         logger->log("Ticket created: " + id + " ("
             + TicketFactory::getCategoryName(category) + ", "
             + TicketFactory::getPriorityName(priority) + ")");
 
-        notifier.notify(
-            customer->getEmail(),
-            "Your ticket " + id + " has been created."
-        );
+        if (notifyCustomer) {
+            notifier.notify(
+                customer->getEmail(),
+                "Your ticket " + id + " has been created."
+            );
+        }
 
         return id;
     }
 
-    bool updateTicketStatus(const std::string& id, TicketStatus newStatus) {
-        auto ticket = tRepo.findById(id);
-        if (!ticket) {
-            logger->log("Ticket not found: " + id);
-            return false;
+    // Brings the hooks up to date with a status change; called under the
+    // ticket's stripe
+    void onStatusChanged(const Ticket& ticket, TicketStatus from, TicketStatus to) {
+        const std::string& id = ticket.getId();
+        if (history) history->recordStatusChanged(id, to);
+        if (sla) sla->track(id, to, ticket.getPriority());
+        if (assignments) assignments->statusChanged(id, from, to);
+        if (queues) requeue(ticket, to);
+        if (events) events->publish(behaviors::observer::TicketStatusChanged{id, from, to});
+    }
+
+    // The same for a new assignee
+    void onAssigned(const std::string& id, const std::string& agent, TicketStatus status) {
+        if (assignments) assignments->transfer(id, agent, status);
+        if (queues) queues->reassign(id, agent);
+        if (history) history->recordAssigned(id, agent);
+        if (events) events->publish(behaviors::observer::TicketAssigned{id, agent});
+    }
+
+    void requeue(const Ticket& ticket, TicketStatus status) {
+        if (status == TicketStatus::OPEN) {
+            queues->enqueue(ticket.getId(), ticket.getAssignedTo(), ticket.getCategory(), ticket.getPriority());
+        } else {
+            queues->remove(ticket.getId());
+        }
+    }
+
+    static std::string joinIds(const std::vector<std::string>& ids, std::size_t begin, std::size_t end) {
+        std::string out;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (i > begin) out += ", ";
+            out += ids[i];
         }
+        return out;
+    }
 
-        ticket->setStatus(newStatus);
-        tRepo.save(*ticket);
+    // One compare-and-swap, no retry: a lost race is reported rather than
+    // re-applied on top of a status the caller has not seen.
+    StatusUpdateResult transition(Ticket& ticket, TicketStatus expected, TicketStatus newStatus) {
+        const std::string& id = ticket.getId();
 
-        auto customer = cRepo.findById(ticket->getCustomerId());
+        if (!behaviors::state::canTransition(expected, newStatus)) {
+            logger->log("Illegal status change for " + id + ": " +
+                        TicketFactory::getStatusName(expected) + " -> " +
+                        TicketFactory::getStatusName(newStatus));
+            return StatusUpdateResult::ILLEGAL_TRANSITION;
+        }
+
+        TicketStatus seen = expected;
+        {
+            std::lock_guard<std::mutex> lock(stripeFor(id));
+            switch (tRepo.compareAndSetStatus(ticket, seen, newStatus)) {
+                case ITicketRepository::CasResult::NOT_FOUND:
+                    logger->log("Ticket not found: " + id);
+                    return StatusUpdateResult::NOT_FOUND;
+                case ITicketRepository::CasResult::CONFLICT:
+                    logger->log("Status update conflict for " + id + ": expected " +
+                                TicketFactory::getStatusName(expected) + ", found " +
+                                TicketFactory::getStatusName(seen));
+                    return StatusUpdateResult::CONFLICT;
+                case ITicketRepository::CasResult::UPDATED:
+                    break;
+            }
+            onStatusChanged(ticket, expected, newStatus);
+        }
+
+        auto customer = cRepo.findById(ticket.getCustomerId());
         if (customer) {
             notifier.notify(
                 customer->getEmail(),
@@ -93,11 +604,7 @@ public:
         }
 
         logger->log("Ticket updated: " + id);
-        return true;
-    }
-
-    std::vector<std::shared_ptr<Ticket>> getAllTickets() {
-        return tRepo.findAll();
+        return StatusUpdateResult::UPDATED;
     }
 };
 
@@ -0,0 +1,239 @@
+#ifndef WORK_QUEUE_SERVICE_HPP
+#define WORK_QUEUE_SERVICE_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../models/Enums.hpp"
+#include "../util/IndexedHeap.hpp"
+#include "SlaScheduler.hpp"
+
+namespace domain {
+
+struct WorkQueueStats {
+    std::size_t queued = 0;
+    std::uint64_t enqueued = 0;
+    std::uint64_t claimed = 0;
+    std::uint64_t removed = 0;        // left OPEN without being claimed
+    std::uint64_t reprioritized = 0;
+    std::uint64_t reassigned = 0;
+};
+
+// OPEN tickets waiting to be picked up: one queue per agent for tickets
+// assigned to them, and one per team (category) for unassigned tickets.
+// Queues are ordered by priority, then SLA deadline for leaving OPEN, then
+// age, so claim() hands out the most urgent ticket first.
+//
+// Each queue is an IndexedHeap over its own dense slots; a ticket id maps to
+// its queue and slot, so a priority change is a decrease-key and a
+// reassignment an erase plus a push, both O(log n).
+class WorkQueueService {
+public:
+    using Clock = std::chrono::system_clock;
+
+private:
+    struct Urgency {
+        int priority = 0;               // negated: CRITICAL sorts first
+        Clock::time_point deadline;
+        Clock::time_point since;
+        std::uint64_t sequence = 0;     // FIFO among equals
+
+        bool operator<(const Urgency& o) const {
+            if (priority != o.priority) return priority < o.priority;
+            if (deadline != o.deadline) return deadline < o.deadline;
+            if (since != o.since) return since < o.since;
+            return sequence < o.sequence;
+        }
+    };
+
+    class Queue {
+    private:
+        IndexedHeap<Urgency> heap;
+        std::vector<std::string> ticketIds;   // slot -> ticket
+        std::vector<std::uint32_t> freeSlots;
+
+    public:
+        std::uint32_t push(const std::string& ticketId, const Urgency& urgency) {
+            std::uint32_t slot;
+            if (freeSlots.empty()) {
+                slot = static_cast<std::uint32_t>(ticketIds.size());
+                ticketIds.push_back(ticketId);
+            } else {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+                ticketIds[slot] = ticketId;
+            }
+            heap.push(slot, urgency);
+            return slot;
+        }
+
+        void update(std::uint32_t slot, const Urgency& urgency) { heap.update(slot, urgency); }
+
+        void erase(std::uint32_t slot) {
+            heap.erase(slot);
+            ticketIds[slot].clear();
+            freeSlots.push_back(slot);
+        }
+
+        bool empty() const { return heap.empty(); }
+        std::size_t size() const { return heap.size(); }
+        const Urgency& topUrgency() const { return heap.topPriority(); }
+        const Urgency& urgencyOf(std::uint32_t slot) const { return heap.priorityOf(slot); }
+        std::uint32_t top() const { return heap.top(); }
+        const std::string& ticketAt(std::uint32_t slot) const { return ticketIds[slot]; }
+    };
+
+    struct Location {
+        Queue* queue;                  // map nodes are stable, so are these
+        std::uint32_t slot;
+        TicketCategory category;
+    };
+
+    SlaPolicy policy;
+
+    mutable std::mutex mtx;
+    std::unordered_map<std::string, Queue> agentQueues;
+    std::array<Queue, TicketCategoryCount> teamQueues;
+    std::unordered_map<std::string, Location> queued;
+    std::uint64_t sequence = 0;
+    WorkQueueStats stats;
+
+    Queue& queueFor(const std::string& agent, TicketCategory category) {
+        if (agent.empty()) return teamQueues[static_cast<std::size_t>(category)];
+        return agentQueues[agent];
+    }
+
+    Urgency urgencyOf(Priority priority, Clock::time_point since) {
+        Urgency u;
+        u.priority = -static_cast<int>(priority);
+        const auto limit = policy.deadlineFor(TicketStatus::OPEN, priority);
+        u.deadline = limit.count() > 0 ? since + limit : Clock::time_point::max();
+        u.since = since;
+        u.sequence = ++sequence;
+        return u;
+    }
+
+    void take(std::unordered_map<std::string, Location>::iterator it) {
+        it->second.queue->erase(it->second.slot);
+        queued.erase(it);
+    }
+
+public:
+    // Deadlines come from the policy's OPEN column
+    explicit WorkQueueService(SlaPolicy p = {}) : policy(std::move(p)) {}
+
+    WorkQueueService(const WorkQueueService&) = delete;
+    WorkQueueService& operator=(const WorkQueueService&) = delete;
+
+    // Queues an OPEN ticket for its agent, or for its category's team if it
+    // has none. Re-queues it if it is already waiting.
+    void enqueue(const std::string& ticketId, const std::string& agent, TicketCategory category,
+                 Priority priority, Clock::time_point since = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = queued.find(ticketId);
+        if (it != queued.end()) take(it);
+
+        Queue& queue = queueFor(agent, category);
+        const std::uint32_t slot = queue.push(ticketId, urgencyOf(priority, since));
+        queued.emplace(ticketId, Location{&queue, slot, category});
+        ++stats.enqueued;
+    }
+
+    // New priority for a waiting ticket; its deadline moves with it. False
+    // if the ticket is not queued.
+    bool reprioritize(const std::string& ticketId, Priority priority) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = queued.find(ticketId);
+        if (it == queued.end()) return false;
+        const Location& at = it->second;
+        const Urgency current = at.queue->urgencyOf(at.slot);
+        Urgency next = urgencyOf(priority, current.since);
+        next.sequence = current.sequence;
+        at.queue->update(at.slot, next);
+        ++stats.reprioritized;
+        return true;
+    }
+
+    // Moves a waiting ticket to another agent's queue ("" = its team's),
+    // keeping its place in line by priority and age
+    bool reassign(const std::string& ticketId, const std::string& agent) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = queued.find(ticketId);
+        if (it == queued.end()) return false;
+        Location& at = it->second;
+        Queue& target = queueFor(agent, at.category);
+        if (&target == at.queue) return true;
+
+        const Urgency urgency = at.queue->urgencyOf(at.slot);
+        at.queue->erase(at.slot);
+        at.queue = &target;
+        at.slot = target.push(ticketId, urgency);
+        ++stats.reassigned;
+        return true;
+    }
+
+    // The ticket left OPEN some other way (e.g. a direct status change)
+    bool remove(const std::string& ticketId) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = queued.find(ticketId);
+        if (it == queued.end()) return false;
+        take(it);
+        ++stats.removed;
+        return true;
+    }
+
+    // Takes the most urgent ticket from the agent's queue or from any of
+    // the given teams' queues; nullopt if they are all empty. Once claimed,
+    // no other caller can get the same ticket.
+    std::optional<std::string> claim(const std::string& agent,
+                                     const std::vector<TicketCategory>& teams = {}) {
+        std::lock_guard<std::mutex> lock(mtx);
+        Queue* best = nullptr;
+        auto own = agentQueues.find(agent);
+        if (own != agentQueues.end() && !own->second.empty()) best = &own->second;
+        for (TicketCategory team : teams) {
+            Queue& q = teamQueues[static_cast<std::size_t>(team)];
+            if (!q.empty() && (!best || q.topUrgency() < best->topUrgency())) best = &q;
+        }
+        if (!best) return std::nullopt;
+
+        std::string ticketId = best->ticketAt(best->top());
+        take(queued.find(ticketId));
+        ++stats.claimed;
+        return ticketId;
+    }
+
+    std::size_t queuedFor(const std::string& agent) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = agentQueues.find(agent);
+        return it == agentQueues.end() ? 0 : it->second.size();
+    }
+
+    std::size_t queuedForTeam(TicketCategory team) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return teamQueues[static_cast<std::size_t>(team)].size();
+    }
+
+    bool isQueued(const std::string& ticketId) const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return queued.count(ticketId) != 0;
+    }
+
+    WorkQueueStats getStats() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        WorkQueueStats s = stats;
+        s.queued = queued.size();
+        return s;
+    }
+};
+
+} // namespace domain
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef AHO_CORASICK_HPP
+#define AHO_CORASICK_HPP
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace domain {
+
+// Case-insensitive multi-pattern matcher compiled to a dense DFA.
+//
+// Bytes are mapped to equivalence classes (one per byte that occurs in a
+// pattern, plus one for everything else), so the transition table is
+// states x classes instead of states x 256. Transitions store the target row
+// offset with the top bit marking states that end a pattern.
+//
+// While in the root state the scanner skips positions whose first two bytes
+// cannot start a pattern. With SSSE3 this is done 16 positions at a time using
+// nibble lookup tables with patterns spread over 8 buckets (a superset test),
+// otherwise with a scalar bitmap of valid two-byte prefixes.
+class AhoCorasick {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+    static constexpr std::uint32_t MatchBit = 0x80000000u;
+
+    std::array<std::uint8_t, 256> byteClass{};
+    std::uint32_t classCount = 1;
+
+    std::vector<std::uint32_t> delta;       // row offset per (state, class)
+    std::vector<std::uint32_t> patternAt;   // per state: pattern ending here + 1, or 0
+    std::vector<std::uint32_t> outputLink;  // per state: next suffix state with output
+    std::size_t patternCount = 0;
+
+    std::array<bool, 256> startByte{};
+    std::vector<std::uint64_t> startPair;   // 65536-bit set of folded two-byte prefixes
+#if defined(__SSSE3__)
+    alignas(16) std::uint8_t firstLo[16] = {};
+    alignas(16) std::uint8_t firstHi[16] = {};
+    alignas(16) std::uint8_t secondLo[16] = {};
+    alignas(16) std::uint8_t secondHi[16] = {};
+#endif
+
+    // ASCII case folding; other bytes match exactly
+    static unsigned char fold(unsigned char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+    }
+
+    static unsigned char unfold(unsigned char c) {
+        return (c >= 'a' && c <= 'z') ? static_cast<unsigned char>(c - ('a' - 'A')) : c;
+    }
+
+    bool isCandidate(const unsigned char* text, std::size_t i, std::size_t n) const {
+        if (!startByte[text[i]]) return false;
+        if (i + 1 >= n) return true;
+        const std::size_t pair = std::size_t{fold(text[i])} << 8 | fold(text[i + 1]);
+        return (startPair[pair >> 6] >> (pair & 63)) & 1;
+    }
+
+    std::size_t skipToCandidate(const unsigned char* text, std::size_t i, std::size_t n) const {
+#if defined(__SSSE3__)
+        const __m128i lo1 = _mm_load_si128(reinterpret_cast<const __m128i*>(firstLo));
+        const __m128i hi1 = _mm_load_si128(reinterpret_cast<const __m128i*>(firstHi));
+        const __m128i lo2 = _mm_load_si128(reinterpret_cast<const __m128i*>(secondLo));
+        const __m128i hi2 = _mm_load_si128(reinterpret_cast<const __m128i*>(secondHi));
+        const __m128i mask = _mm_set1_epi8(0x0f);
+        const __m128i zero = _mm_setzero_si128();
+
+        auto classify = [&mask](__m128i block, __m128i lo, __m128i hi) {
+            const __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(block, mask));
+            const __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(block, 4), mask));
+            return _mm_and_si128(l, h);
+        };
+
+        while (i + 17 <= n) {
+            const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+            const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + 1));
+            const __m128i both = _mm_and_si128(classify(first, lo1, hi1), classify(second, lo2, hi2));
+            unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(both, zero))) ^ 0xffffu;
+            while (bits) {
+                const std::size_t at = i + static_cast<std::size_t>(__builtin_ctz(bits));
+                if (isCandidate(text, at, n)) return at;
+                bits &= bits - 1;
+            }
+            i += 16;
+        }
+#endif
+        while (i < n && !isCandidate(text, i, n)) ++i;
+        return i;
+    }
+
+    // Registers the (case-folded) first two bytes of a pattern with the
+    // prefilters. Single-byte patterns accept any second byte.
+    void addPrefix(const std::string& p, unsigned bucket) {
+        const unsigned char a = fold(static_cast<unsigned char>(p[0]));
+        const unsigned char upperA = unfold(a);
+        startByte[a] = startByte[upperA] = true;
+
+        for (int b = 0; b < 256; ++b) {
+            const bool any = p.size() == 1;
+            if (!any && b != fold(static_cast<unsigned char>(p[1]))) continue;
+            const std::size_t pair = std::size_t{a} << 8 | static_cast<std::size_t>(b);
+            startPair[pair >> 6] |= std::uint64_t{1} << (pair & 63);
+        }
+
+#if defined(__SSSE3__)
+        const std::uint8_t bit = static_cast<std::uint8_t>(1u << bucket);
+        for (unsigned char c : {a, upperA}) {
+            firstLo[c & 0x0f] |= bit;
+            firstHi[c >> 4] |= bit;
+        }
+        if (p.size() == 1) {
+            for (int k = 0; k < 16; ++k) {
+                secondLo[k] |= bit;
+                secondHi[k] |= bit;
+            }
+        } else {
+            const unsigned char b = fold(static_cast<unsigned char>(p[1]));
+            for (unsigned char c : {b, unfold(b)}) {
+                secondLo[c & 0x0f] |= bit;
+                secondHi[c >> 4] |= bit;
+            }
+        }
+#else
+        (void)bucket;
+#endif
+    }
+
+public:
+    AhoCorasick() : delta(1, 0), patternAt(1, 0), outputLink(1, 0), startPair(65536 / 64, 0) {}
+
+    explicit AhoCorasick(const std::vector<std::string>& patterns)
+        : startPair(65536 / 64, 0)
+    {
+        // Byte classes
+        std::array<bool, 256> used{};
+        for (const auto& p : patterns)
+            for (unsigned char c : p) used[fold(c)] = true;
+        for (int b = 0; b < 256; ++b) {
+            if (used[b]) byteClass[b] = static_cast<std::uint8_t>(classCount++);
+        }
+        for (int b = 0; b < 256; ++b)
+            byteClass[b] = byteClass[fold(static_cast<unsigned char>(b))];
+
+        // Trie; 0 doubles as "no edge" since nothing points back at the root
+        std::vector<std::uint32_t> trie(classCount, 0);
+        patternAt.assign(1, 0);
+        for (std::size_t pi = 0; pi < patterns.size(); ++pi) {
+            const auto& p = patterns[pi];
+            if (p.empty()) continue;
+
+            std::uint32_t s = 0;
+            for (unsigned char c : p) {
+                std::uint32_t& next = trie[s * classCount + byteClass[c]];
+                if (next == 0) {
+                    next = static_cast<std::uint32_t>(patternAt.size());
+                    patternAt.push_back(0);
+                    trie.resize(trie.size() + classCount, 0);
+                }
+                s = trie[s * classCount + byteClass[c]];
+            }
+            if (patternAt[s] == 0) patternAt[s] = static_cast<std::uint32_t>(pi + 1);
+            addPrefix(p, static_cast<unsigned>(pi % 8));
+        }
+        patternCount = patterns.size();
+
+        // Failure links, turned into a complete DFA breadth-first
+        const std::size_t states = patternAt.size();
+        std::vector<std::uint32_t> fail(states, 0);
+        outputLink.assign(states, 0);
+        std::vector<bool> hasOutput(states, false);
+        for (std::size_t s = 0; s < states; ++s) hasOutput[s] = patternAt[s] != 0;
+
+        std::deque<std::uint32_t> queue;
+        for (std::uint32_t c = 0; c < classCount; ++c) {
+            if (trie[c] != 0) queue.push_back(trie[c]);
+        }
+        while (!queue.empty()) {
+            const std::uint32_t s = queue.front();
+            queue.pop_front();
+
+            const std::uint32_t f = fail[s];
+            outputLink[s] = hasOutput[f] ? f : outputLink[f];
+            if (!hasOutput[s] && outputLink[s] != 0) hasOutput[s] = true;
+
+            for (std::uint32_t c = 0; c < classCount; ++c) {
+                std::uint32_t& t = trie[s * classCount + c];
+                if (t != 0) {
+                    fail[t] = trie[f * classCount + c];
+                    queue.push_back(t);
+                } else {
+                    t = trie[f * classCount + c];
+                }
+            }
+        }
+
+        delta.resize(trie.size());
+        for (std::size_t i = 0; i < trie.size(); ++i) {
+            const std::uint32_t target = trie[i];
+            delta[i] = target * classCount | (hasOutput[target] ? MatchBit : 0);
+        }
+    }
+
+public:
+    // Calls fn(patternIndex, endOffset) for every match until fn returns false.
+    template <typename Fn>
+    void forEachMatch(std::string_view text, Fn&& fn) const {
+        const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+        const std::size_t n = text.size();
+
+        std::uint32_t row = 0;
+        std::size_t i = 0;
+        while (i < n) {
+            if (row == 0) {
+                i = skipToCandidate(data, i, n);
+                if (i >= n) break;
+            }
+
+            const std::uint32_t next = delta[row + byteClass[data[i]]];
+            row = next & ~MatchBit;
+            ++i;
+
+            if (next & MatchBit) {
+                for (std::uint32_t s = row / classCount; s != 0; s = outputLink[s]) {
+                    if (patternAt[s] != 0 && !fn(static_cast<std::size_t>(patternAt[s] - 1), i))
+                        return;
+                }
+            }
+        }
+    }
+
+    // Index of the pattern of the first match, or npos.
+    std::size_t findFirst(std::string_view text) const {
+        std::size_t found = npos;
+        forEachMatch(text, [&found](std::size_t pattern, std::size_t) {
+            found = pattern;
+            return false;
+        });
+        return found;
+    }
+
+    std::size_t getPatternCount() const { return patternCount; }
+    std::size_t getStateCount() const { return patternAt.size(); }
+
+    std::size_t getMemoryBytes() const {
+        return delta.size() * sizeof(std::uint32_t) +
+               patternAt.size() * sizeof(std::uint32_t) +
+               outputLink.size() * sizeof(std::uint32_t);
+    }
+};
+
+} // namespace domain
+
+#endif
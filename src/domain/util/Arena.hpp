@@ -0,0 +1,68 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace domain {
+
+// Monotonic arena for objects created in a batch. make() carves the object
+// and its shared_ptr control block out of one std::pmr::monotonic_buffer_resource
+// instead of a heap allocation each.
+//
+// Every object's allocator holds a reference to the arena, so the memory is
+// released when the Arena and the last object made from it are gone; freeing
+// single objects reclaims nothing before that. Allocation is not
+// thread-safe: one thread fills an arena at a time.
+class Arena {
+public:
+    template <typename T>
+    class Allocator {
+    private:
+        template <typename> friend class Allocator;
+        std::shared_ptr<std::pmr::memory_resource> resource;
+
+    public:
+        using value_type = T;
+
+        explicit Allocator(std::shared_ptr<std::pmr::memory_resource> r) : resource(std::move(r)) {}
+
+        template <typename U>
+        Allocator(const Allocator<U>& other) : resource(other.resource) {}
+
+        T* allocate(std::size_t n) {
+            return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) {
+            resource->deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        template <typename U>
+        bool operator==(const Allocator<U>& other) const { return resource == other.resource; }
+
+        template <typename U>
+        bool operator!=(const Allocator<U>& other) const { return resource != other.resource; }
+    };
+
+private:
+    std::shared_ptr<std::pmr::monotonic_buffer_resource> resource;
+
+public:
+    // initialBytes sizes the first block; later blocks grow geometrically
+    explicit Arena(std::size_t initialBytes = 64 * 1024)
+        : resource(std::make_shared<std::pmr::monotonic_buffer_resource>(initialBytes)) {}
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make(Args&&... args) {
+        return std::allocate_shared<T>(Allocator<T>(resource), std::forward<Args>(args)...);
+    }
+
+    std::pmr::memory_resource* memoryResource() const { return resource.get(); }
+};
+
+} // namespace domain
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef BLOOM_FILTER_HPP
+#define BLOOM_FILTER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+namespace domain {
+
+struct BloomFilterConfig {
+    std::size_t expectedItems = 100000;
+    double falsePositiveRate = 0.01;
+
+    // Upper bound on the bit array; 0 means size purely from the two values above.
+    std::size_t maxBytes = 0;
+};
+
+struct BloomFilterStats {
+    std::size_t bitCount;
+    std::size_t hashCount;
+    std::size_t memoryBytes;
+    std::size_t insertedItems;
+    double configuredFalsePositiveRate;
+    double estimatedFalsePositiveRate;
+};
+
+// Lock-free Bloom filter: add() and mightContain() can run concurrently from
+// any number of threads. A negative answer is definitive; a positive one must
+// be confirmed against the real store.
+class BloomFilter {
+private:
+    std::size_t bitCount;
+    std::size_t hashCount;
+    double configuredRate;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words;
+    std::atomic<std::size_t> inserted{0};
+
+    static std::uint64_t mix(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    template <typename Fn>
+    void forEachBit(std::string_view key, Fn&& fn) const {
+        // Double hashing: bit_i = h1 + i * h2
+        const std::uint64_t h1 = mix(std::hash<std::string_view>{}(key));
+        const std::uint64_t h2 = mix(h1) | 1;
+        for (std::size_t i = 0; i < hashCount; ++i) {
+            const std::uint64_t bit = (h1 + i * h2) % bitCount;
+            if (!fn(bit >> 6, std::uint64_t{1} << (bit & 63))) return;
+        }
+    }
+
+public:
+    explicit BloomFilter(const BloomFilterConfig& config = {})
+        : configuredRate(config.falsePositiveRate)
+    {
+        const double n = static_cast<double>(std::max<std::size_t>(config.expectedItems, 1));
+        const double p = std::clamp(config.falsePositiveRate, 1e-9, 0.5);
+        const double ln2 = std::log(2.0);
+
+        auto bits = static_cast<std::size_t>(std::ceil(-n * std::log(p) / (ln2 * ln2)));
+        if (config.maxBytes > 0) bits = std::min(bits, config.maxBytes * 8);
+        bitCount = std::max<std::size_t>((bits + 63) / 64, 1) * 64;
+
+        hashCount = static_cast<std::size_t>(
+            std::lround(static_cast<double>(bitCount) / n * ln2));
+        hashCount = std::clamp<std::size_t>(hashCount, 1, 16);
+
+        words = std::make_unique<std::atomic<std::uint64_t>[]>(bitCount / 64);
+        for (std::size_t i = 0; i < bitCount / 64; ++i)
+            words[i].store(0, std::memory_order_relaxed);
+    }
+
+    void add(std::string_view key) {
+        forEachBit(key, [this](std::size_t word, std::uint64_t mask) {
+            words[word].fetch_or(mask, std::memory_order_release);
+            return true;
+        });
+        inserted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool mightContain(std::string_view key) const {
+        bool present = true;
+        forEachBit(key, [this, &present](std::size_t word, std::uint64_t mask) {
+            present = (words[word].load(std::memory_order_acquire) & mask) != 0;
+            return present;
+        });
+        return present;
+    }
+
+    BloomFilterStats getStats() const {
+        const double m = static_cast<double>(bitCount);
+        const double k = static_cast<double>(hashCount);
+        const double n = static_cast<double>(inserted.load(std::memory_order_relaxed));
+
+        return BloomFilterStats{
+            bitCount,
+            hashCount,
+            bitCount / 8,
+            inserted.load(std::memory_order_relaxed),
+            configuredRate,
+            std::pow(1.0 - std::exp(-k * n / m), k)
+        };
+    }
+};
+
+} // namespace domain
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace domain {
+
+// Lock-free bounded queue for many producers and one consumer (Vyukov's
+// array queue). Each cell carries a sequence number telling producers and
+// the consumer whether it is free or filled for the current lap, so the only
+// shared read-modify-write is the producers' claim of the tail.
+//
+// tryPush() fails instead of waiting when the queue is full; blocking and
+// wake-ups are left to the caller.
+template <typename T>
+class BoundedMpscQueue {
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<std::size_t> tail{0};   // next position to claim (producers)
+    alignas(64) std::atomic<std::size_t> head{0};   // next position to read (consumer)
+
+    static std::size_t roundUp(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+public:
+    explicit BoundedMpscQueue(std::size_t capacity)
+        : mask(roundUp(capacity) - 1)
+        , cells(std::make_unique<Cell[]>(mask + 1))
+    {
+        for (std::size_t i = 0; i <= mask; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+    bool tryPush(T&& value) {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // full
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    bool tryPop(T& out) {
+        const std::size_t pos = head.load(std::memory_order_relaxed);
+        Cell& cell = cells[pos & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+        out = std::move(cell.value);
+        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+        head.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently with push/pop
+    std::size_t size() const {
+        const std::size_t t = tail.load(std::memory_order_acquire);
+        const std::size_t h = head.load(std::memory_order_acquire);
+        return t > h ? std::min(t - h, mask + 1) : 0;
+    }
+
+    std::size_t capacity() const { return mask + 1; }
+};
+
+// Bounded queue between pipeline stages: push() waits while the queue is
+// full, pop() while it is empty, so a slow stage holds back the ones before
+// it. close() ends the stream; pop() drains what is left and then fails.
+template <typename T>
+class BoundedBlockingQueue {
+private:
+    std::mutex mtx;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<T> items;
+    std::size_t limit;
+    bool closed = false;
+
+public:
+    explicit BoundedBlockingQueue(std::size_t capacity) : limit(std::max<std::size_t>(1, capacity)) {}
+
+    BoundedBlockingQueue(const BoundedBlockingQueue&) = delete;
+    BoundedBlockingQueue& operator=(const BoundedBlockingQueue&) = delete;
+
+    // False if the queue was closed
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mtx);
+        notFull.wait(lock, [&] { return closed || items.size() < limit; });
+        if (closed) return false;
+        items.push_back(std::move(value));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // False once the queue is closed and empty
+    bool pop(T& out) {
+        std::unique_lock<std::mutex> lock(mtx);
+        notEmpty.wait(lock, [&] { return closed || !items.empty(); });
+        if (items.empty()) return false;
+        out = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mtx);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+};
+
+} // namespace domain
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef ID_NUMBER_HPP
+#define ID_NUMBER_HPP
+
+#include <string>
+
+namespace domain {
+
+// n for a generated id "<prefix><n>" (e.g. "TKT-1042"), 0 for any other id
+inline int idNumber(const std::string& id, const std::string& prefix) {
+    if (id.size() <= prefix.size() || id.size() > prefix.size() + 9 ||
+        id.compare(0, prefix.size(), prefix) != 0) {
+        return 0;
+    }
+    int n = 0;
+    for (std::size_t i = prefix.size(); i < id.size(); ++i) {
+        if (id[i] < '0' || id[i] > '9') return 0;
+        n = n * 10 + (id[i] - '0');
+    }
+    return n;
+}
+
+} // namespace domain
+
+#endif
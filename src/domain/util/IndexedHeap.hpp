@@ -0,0 +1,141 @@
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace domain {
+
+// d-ary min-heap over small integer keys (dense ids such as agent slots),
+// with a key -> position index so a key's priority can be changed or the key
+// removed in O(log n) instead of rebuilding the heap. A wider node
+// (Arity 4 by default) makes the tree shallower and keeps children on one
+// cache line.
+//
+// Not thread-safe; the owner serializes access.
+template <typename Priority, typename Compare = std::less<Priority>, std::size_t Arity = 4>
+class IndexedHeap {
+    static_assert(Arity >= 2, "IndexedHeap needs at least two children per node");
+
+public:
+    using Key = std::uint32_t;
+
+private:
+    static constexpr std::size_t Absent = std::numeric_limits<std::size_t>::max();
+
+    std::vector<Key> heap;            // heap order
+    std::vector<std::size_t> pos;     // key -> index in heap, Absent if not queued
+    std::vector<Priority> prio;       // key -> priority (valid while queued)
+    Compare less;
+
+    bool before(std::size_t a, std::size_t b) const { return less(prio[heap[a]], prio[heap[b]]); }
+
+    void place(std::size_t i, Key key) {
+        heap[i] = key;
+        pos[key] = i;
+    }
+
+    void siftUp(std::size_t i) {
+        const Key key = heap[i];
+        while (i > 0) {
+            const std::size_t parent = (i - 1) / Arity;
+            if (!less(prio[key], prio[heap[parent]])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, key);
+    }
+
+    void siftDown(std::size_t i) {
+        const Key key = heap[i];
+        const std::size_t n = heap.size();
+        for (;;) {
+            const std::size_t first = i * Arity + 1;
+            if (first >= n) break;
+            const std::size_t last = first + Arity < n ? first + Arity : n;
+            std::size_t best = first;
+            for (std::size_t c = first + 1; c < last; ++c)
+                if (before(c, best)) best = c;
+            if (!less(prio[heap[best]], prio[key])) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, key);
+    }
+
+    void restore(std::size_t i) {
+        if (i > 0 && less(prio[heap[i]], prio[heap[(i - 1) / Arity]])) siftUp(i);
+        else siftDown(i);
+    }
+
+public:
+    explicit IndexedHeap(Compare c = Compare()) : less(std::move(c)) {}
+
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+
+    bool contains(Key key) const { return key < pos.size() && pos[key] != Absent; }
+
+    // Inserts the key, or changes its priority if it is already queued
+    void push(Key key, Priority p) {
+        if (key >= pos.size()) {
+            pos.resize(key + 1, Absent);
+            prio.resize(key + 1);
+        }
+        prio[key] = std::move(p);
+        if (pos[key] != Absent) {
+            restore(pos[key]);
+            return;
+        }
+        heap.push_back(key);
+        pos[key] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+    }
+
+    // False if the key is not queued
+    bool update(Key key, Priority p) {
+        if (!contains(key)) return false;
+        prio[key] = std::move(p);
+        restore(pos[key]);
+        return true;
+    }
+
+    bool erase(Key key) {
+        if (!contains(key)) return false;
+        const std::size_t i = pos[key];
+        pos[key] = Absent;
+        const Key moved = heap.back();
+        heap.pop_back();
+        if (i < heap.size()) {
+            place(i, moved);
+            restore(i);
+        }
+        return true;
+    }
+
+    // Smallest key; the heap must not be empty
+    Key top() const { return heap.front(); }
+    const Priority& topPriority() const { return prio[heap.front()]; }
+
+    Key pop() {
+        const Key key = heap.front();
+        erase(key);
+        return key;
+    }
+
+    // Priority of a queued key
+    const Priority& priorityOf(Key key) const { return prio[key]; }
+
+    void clear() {
+        for (Key key : heap) pos[key] = Absent;
+        heap.clear();
+    }
+};
+
+} // namespace domain
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace domain {
+
+// Non-owning view of contiguous elements; a C++17 stand-in for std::span.
+template <typename T>
+class Span {
+private:
+    T* first = nullptr;
+    std::size_t count = 0;
+
+public:
+    Span() = default;
+    Span(T* data, std::size_t size) : first(data), count(size) {}
+
+    template <typename U>
+    Span(std::vector<U>& v) : first(v.data()), count(v.size()) {}
+
+    template <typename U>
+    Span(const std::vector<U>& v) : first(v.data()), count(v.size()) {}
+
+    T* begin() const { return first; }
+    T* end() const { return first + count; }
+    T* data() const { return first; }
+    T& operator[](std::size_t i) const { return first[i]; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Span subspan(std::size_t offset, std::size_t length) const {
+        return Span(first + offset, length);
+    }
+};
+
+} // namespace domain
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef TAG_INDEX_HPP
+#define TAG_INDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../models/Tags.hpp"
+
+namespace domain {
+
+// Inverted index from tag to items (e.g. tickets). Every item gets a dense
+// slot, and every tag a bitmap over the slots, so "tagged A AND B" is a
+// word-by-word AND of two bitmaps rather than a scan over all items.
+//
+// Not thread-safe; the owning repository serializes access.
+template <typename Item>
+class TagIndex {
+private:
+    using Bitmap = std::vector<std::uint64_t>;
+
+    std::unordered_map<std::string, std::uint32_t> slots;   // key -> slot
+    std::vector<Item> items;                                  // slot -> item
+    std::vector<TagSet> tagsOf;                               // slot -> indexed tags
+    std::vector<Bitmap> postings;                             // tag id -> slots
+
+    void set(TagId tag, std::uint32_t slot, bool on) {
+        if (tag >= postings.size()) postings.resize(tag + 1);
+        Bitmap& bitmap = postings[tag];
+        const std::size_t word = slot / 64;
+        if (word >= bitmap.size()) {
+            if (!on) return;
+            bitmap.resize(word + 1, 0);
+        }
+        const std::uint64_t mask = std::uint64_t{1} << (slot % 64);
+        if (on) bitmap[word] |= mask;
+        else bitmap[word] &= ~mask;
+    }
+
+public:
+    // Adds the item or replaces it and its tags
+    void update(const std::string& key, Item item, const TagSet& tags) {
+        auto [it, inserted] = slots.emplace(key, static_cast<std::uint32_t>(items.size()));
+        const std::uint32_t slot = it->second;
+        if (inserted) {
+            items.push_back(std::move(item));
+            tagsOf.emplace_back();
+        } else {
+            items[slot] = std::move(item);
+        }
+
+        TagSet& current = tagsOf[slot];
+        if (current == tags) return;
+        current.forEach([&](TagId t) { if (!tags.contains(t)) set(t, slot, false); });
+        tags.forEach([&](TagId t) { if (!current.contains(t)) set(t, slot, true); });
+        current = tags;
+    }
+
+    // Calls fn(item) for every item that has all `required` tags
+    template <typename Fn>
+    void forEachMatch(const TagSet& required, Fn&& fn) const {
+        if (required.empty()) {
+            for (const auto& item : items) fn(item);
+            return;
+        }
+
+        std::vector<const Bitmap*> lists;
+        bool missing = false;
+        required.forEach([&](TagId t) {
+            if (t >= postings.size()) missing = true;
+            else lists.push_back(&postings[t]);
+        });
+        if (missing) return;
+
+        // Shortest bitmap first: it bounds the words worth looking at
+        std::sort(lists.begin(), lists.end(),
+                  [](const Bitmap* a, const Bitmap* b) { return a->size() < b->size(); });
+        const std::size_t words = lists.front()->size();
+        for (std::size_t w = 0; w < words; ++w) {
+            std::uint64_t bits = (*lists[0])[w];
+            for (std::size_t i = 1; i < lists.size() && bits; ++i) bits &= (*lists[i])[w];
+            for (; bits; bits &= bits - 1) {
+                const std::size_t slot = w * 64 + static_cast<std::size_t>(__builtin_ctzll(bits));
+                fn(items[slot]);
+            }
+        }
+    }
+
+    std::size_t count(const TagSet& required) const {
+        std::size_t n = 0;
+        forEachMatch(required, [&](const Item&) { ++n; });
+        return n;
+    }
+
+    std::size_t size() const { return items.size(); }
+};
+
+} // namespace domain
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace domain {
+
+// Hierarchical timing wheel: schedule() and cancel() are O(1) regardless of
+// how many timers are pending, and advancing one tick touches one slot.
+//
+// Level 0 has 256 one-tick slots; each of the three levels above has 64 slots
+// covering 64 times the span of the level below (2^26 ticks in total, about
+// 2 years at one tick per second). Timers further out wait in the last level
+// and are re-filed as they come into range. When level 0 wraps, the next slot
+// of level 1 is cascaded down, and so on.
+//
+// Timers live in a slab and are linked into slots by index. A TimerId holds
+// the slab index and a generation, so cancelling a timer that has already
+// fired (and whose entry was reused) is a harmless no-op.
+//
+// Not thread-safe; callers serialize access.
+template <typename Payload>
+class TimingWheel {
+public:
+    using TimerId = std::uint64_t;
+    static constexpr TimerId InvalidTimer = 0;
+
+private:
+    static constexpr unsigned Level0Bits = 8;
+    static constexpr unsigned LevelBits = 6;
+    static constexpr unsigned LevelCount = 4;
+    static constexpr std::uint32_t Level0Size = 1u << Level0Bits;
+    static constexpr std::uint32_t LevelSize = 1u << LevelBits;
+    static constexpr std::uint32_t SlotCount = Level0Size + (LevelCount - 1) * LevelSize;
+    static constexpr std::uint32_t Nil = ~std::uint32_t{0};
+
+    struct Node {
+        std::uint64_t expiresAt = 0;
+        std::uint32_t prev = Nil;
+        std::uint32_t next = Nil;
+        std::uint32_t slot = Nil;        // Nil when free
+        std::uint32_t generation = 1;
+        Payload payload{};
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> freeList;
+    std::array<std::uint32_t, SlotCount> heads;
+    std::uint64_t now;
+    std::size_t pending = 0;
+
+    static std::uint64_t levelSpan(unsigned level) {
+        return std::uint64_t{1} << (Level0Bits + level * LevelBits);
+    }
+
+    std::uint32_t slotFor(std::uint64_t expiresAt) const {
+        const std::uint64_t delta = expiresAt > now ? expiresAt - now : 0;
+        if (delta < Level0Size)
+            return static_cast<std::uint32_t>((delta == 0 ? now : expiresAt) & (Level0Size - 1));
+
+        for (unsigned level = 1; level < LevelCount; ++level) {
+            if (delta < levelSpan(level) || level == LevelCount - 1) {
+                // Clamp beyond the wheel's range to the furthest slot
+                const std::uint64_t at = delta < levelSpan(level) ? expiresAt
+                                                                  : now + levelSpan(level) - 1;
+                const unsigned shift = Level0Bits + (level - 1) * LevelBits;
+                return Level0Size + (level - 1) * LevelSize +
+                       static_cast<std::uint32_t>((at >> shift) & (LevelSize - 1));
+            }
+        }
+        return 0;
+    }
+
+    void link(std::uint32_t index) {
+        Node& n = nodes[index];
+        n.slot = slotFor(n.expiresAt);
+        n.prev = Nil;
+        n.next = heads[n.slot];
+        if (n.next != Nil) nodes[n.next].prev = index;
+        heads[n.slot] = index;
+    }
+
+    void unlink(std::uint32_t index) {
+        Node& n = nodes[index];
+        if (n.prev != Nil) nodes[n.prev].next = n.next;
+        else heads[n.slot] = n.next;
+        if (n.next != Nil) nodes[n.next].prev = n.prev;
+    }
+
+    void release(std::uint32_t index) {
+        Node& n = nodes[index];
+        n.slot = Nil;
+        n.payload = Payload{};
+        ++n.generation;
+        freeList.push_back(index);
+        --pending;
+    }
+
+    // Re-files every timer of a higher-level slot relative to the current tick
+    void cascade(unsigned level) {
+        const unsigned shift = Level0Bits + (level - 1) * LevelBits;
+        const std::uint32_t slot = Level0Size + (level - 1) * LevelSize +
+                                   static_cast<std::uint32_t>((now >> shift) & (LevelSize - 1));
+        std::uint32_t index = heads[slot];
+        heads[slot] = Nil;
+        while (index != Nil) {
+            const std::uint32_t next = nodes[index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+    static TimerId makeId(std::uint32_t index, std::uint32_t generation) {
+        return static_cast<TimerId>(generation) << 32 | index;
+    }
+
+public:
+    explicit TimingWheel(std::uint64_t startTick = 0) : now(startTick) {
+        heads.fill(Nil);
+    }
+
+    TimerId schedule(std::uint64_t expiresAt, Payload payload) {
+        std::uint32_t index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        Node& n = nodes[index];
+        n.expiresAt = expiresAt;
+        n.payload = std::move(payload);
+        link(index);
+        ++pending;
+        return makeId(index, n.generation);
+    }
+
+    // False if the timer already fired or was cancelled
+    bool cancel(TimerId id) {
+        const auto index = static_cast<std::uint32_t>(id);
+        const auto generation = static_cast<std::uint32_t>(id >> 32);
+        if (index >= nodes.size()) return false;
+        Node& n = nodes[index];
+        if (n.slot == Nil || n.generation != generation) return false;
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    // Fires, in tick order, every timer due up to and including `tick`,
+    // calling onExpire(payload, expiresAt). Callbacks may schedule and cancel.
+    template <typename Fn>
+    std::size_t advanceTo(std::uint64_t tick, Fn&& onExpire) {
+        std::size_t fired = 0;
+        while (now <= tick) {
+            if (pending == 0) {
+                now = tick + 1;
+                break;
+            }
+
+            const auto slot = static_cast<std::uint32_t>(now & (Level0Size - 1));
+            if (slot == 0) {
+                for (unsigned level = 1; level < LevelCount; ++level) {
+                    cascade(level);
+                    const unsigned shift = Level0Bits + (level - 1) * LevelBits;
+                    if (((now >> shift) & (LevelSize - 1)) != 0) break;
+                }
+            }
+
+            // Detach the slot first; callbacks may add already-due timers to
+            // it, which the next round picks up.
+            while (heads[slot] != Nil) {
+                std::uint32_t index = heads[slot];
+                heads[slot] = Nil;
+                while (index != Nil) {
+                    const std::uint32_t next = nodes[index].next;
+                    Node& n = nodes[index];
+                    if (n.expiresAt > now) {
+                        link(index);
+                    } else {
+                        Payload payload = std::move(n.payload);
+                        const std::uint64_t expiresAt = n.expiresAt;
+                        release(index);
+                        ++fired;
+                        onExpire(payload, expiresAt);
+                    }
+                    index = next;
+                }
+            }
+            ++now;
+        }
+        return fired;
+    }
+
+    std::uint64_t currentTick() const { return now; }
+    std::size_t size() const { return pending; }
+};
+
+} // namespace domain
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef VAR_INT_HPP
+#define VAR_INT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace domain {
+
+// LEB128-style unsigned varints: 7 bits per byte, high bit set on all but the
+// last byte. Small values (enum codes, dictionary ids, time deltas) take 1-2 bytes.
+
+inline void appendVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+// Reads a varint at pos and advances it; returns false on truncated input.
+inline bool readVarint(const std::uint8_t* data, std::size_t size, std::size_t& pos,
+                       std::uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && pos < size; shift += 7) {
+        const std::uint8_t b = data[pos++];
+        value |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+inline void appendBytes(std::vector<std::uint8_t>& out, const std::string& s) {
+    appendVarint(out, s.size());
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+inline bool readBytes(const std::uint8_t* data, std::size_t size, std::size_t& pos,
+                      std::string& s) {
+    std::uint64_t len = 0;
+    if (!readVarint(data, size, pos, len) || len > size - pos) return false;
+    s.assign(reinterpret_cast<const char*>(data + pos), static_cast<std::size_t>(len));
+    pos += static_cast<std::size_t>(len);
+    return true;
+}
+
+} // namespace domain
+
+#endif
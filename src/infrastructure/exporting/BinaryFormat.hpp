@@ -0,0 +1,229 @@
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../../domain/models/Customer.hpp"
+#include "../../domain/models/Enums.hpp"
+#include "../../domain/models/Ticket.hpp"
+
+namespace infrastructure {
+
+// Compact export format:
+//
+//   file:     "SPX1", entity (1 byte), then records
+//   record:   payload length (varint), payload
+//   customer: id, name, email, phone (strings), type (1 byte)
+//   ticket:   id, customerId, description, assignedTo (strings),
+//             status, priority, category (1 byte each),
+//             createdAt (varint, seconds since the epoch),
+//             tag count (varint), tag names (strings)
+//   string:   byte length (varint), bytes
+//
+// Varints are unsigned LEB128. The record length lets a reader skip
+// records, or fields added to the end of a payload later.
+enum class BinaryEntity : std::uint8_t { CUSTOMERS, TICKETS };
+
+namespace binary_detail {
+
+constexpr char Magic[4] = {'S', 'P', 'X', '1'};
+constexpr std::size_t HeaderSize = sizeof(Magic) + 1;
+
+inline void putVarint(std::string& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+inline void putString(std::string& out, const std::string& s) {
+    putVarint(out, s.size());
+    out += s;
+}
+
+inline bool getVarint(const char*& p, const char* end, std::uint64_t& v) {
+    v = 0;
+    for (unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        const auto byte = static_cast<unsigned char>(*p++);
+        v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) return true;
+    }
+    return false;
+}
+
+inline bool getString(const char*& p, const char* end, std::string& s) {
+    std::uint64_t n;
+    if (!getVarint(p, end, n) || n > static_cast<std::uint64_t>(end - p)) return false;
+    s.assign(p, static_cast<std::size_t>(n));
+    p += n;
+    return true;
+}
+
+// Points into the input instead of copying
+inline bool getView(const char*& p, const char* end, std::string_view& s) {
+    std::uint64_t n;
+    if (!getVarint(p, end, n) || n > static_cast<std::uint64_t>(end - p)) return false;
+    s = std::string_view(p, static_cast<std::size_t>(n));
+    p += n;
+    return true;
+}
+
+template <typename E>
+inline bool getEnum(const char*& p, const char* end, std::size_t count, E& out) {
+    if (p == end || static_cast<unsigned char>(*p) >= count) return false;
+    out = static_cast<E>(static_cast<unsigned char>(*p++));
+    return true;
+}
+
+} // namespace binary_detail
+
+inline void appendBinaryHeader(std::string& out, BinaryEntity entity) {
+    out.append(binary_detail::Magic, sizeof(binary_detail::Magic));
+    out.push_back(static_cast<char>(entity));
+}
+
+// `payload` is scratch space, reused between records
+inline void appendBinaryRecord(std::string& out, std::string& payload, const domain::Customer& c) {
+    using namespace binary_detail;
+    payload.clear();
+    putString(payload, c.getId());
+    putString(payload, c.getName());
+    putString(payload, c.getEmail());
+    putString(payload, c.getPhone());
+    payload.push_back(static_cast<char>(c.getType()));
+    putVarint(out, payload.size());
+    out += payload;
+}
+
+inline void appendBinaryRecord(std::string& out, std::string& payload, const domain::Ticket& t) {
+    using namespace binary_detail;
+    payload.clear();
+    putString(payload, t.getId());
+    putString(payload, t.getCustomerId());
+    putString(payload, t.getDescription());
+    putString(payload, t.getAssignedTo());
+    payload.push_back(static_cast<char>(t.getStatus()));
+    payload.push_back(static_cast<char>(t.getPriority()));
+    payload.push_back(static_cast<char>(t.getCategory()));
+    putVarint(payload, static_cast<std::uint64_t>(t.getCreatedAt()));
+    const auto tags = t.getTagSet();
+    const auto& dictionary = domain::TagDictionary::getInstance();
+    putVarint(payload, tags.size());
+    tags.forEach([&](domain::TagId tag) { putString(payload, dictionary.name(tag)); });
+    putVarint(out, payload.size());
+    out += payload;
+}
+
+// One record's payload, [p, end), as written by appendBinaryRecord
+inline bool decodeBinaryRecord(const char* p, const char* end, std::shared_ptr<domain::Customer>& out) {
+    using namespace binary_detail;
+    std::string id, name, email, phone;
+    domain::CustomerType type;
+    if (!getString(p, end, id) || !getString(p, end, name) || !getString(p, end, email) ||
+        !getString(p, end, phone) || !getEnum(p, end, domain::CustomerTypeCount, type))
+        return false;
+    out = std::make_shared<domain::Customer>(id, name, email, phone, type);
+    return true;
+}
+
+inline bool decodeBinaryRecord(const char* p, const char* end, std::shared_ptr<domain::Ticket>& out) {
+    using namespace binary_detail;
+    std::string id, customerId, description, assignedTo, tag;
+    domain::TicketStatus status;
+    domain::Priority priority;
+    domain::TicketCategory category;
+    std::uint64_t createdAt, tags;
+    if (!getString(p, end, id) || !getString(p, end, customerId) || !getString(p, end, description) ||
+        !getString(p, end, assignedTo) || !getEnum(p, end, domain::TicketStatusCount, status) ||
+        !getEnum(p, end, domain::PriorityCount, priority) ||
+        !getEnum(p, end, domain::TicketCategoryCount, category) || !getVarint(p, end, createdAt) ||
+        !getVarint(p, end, tags))
+        return false;
+
+    auto ticket = std::make_shared<domain::Ticket>(std::move(id), std::move(customerId), std::move(description),
+                                                   priority, category, status);
+    ticket->setAssignedTo(std::move(assignedTo));
+    ticket->setCreatedAt(static_cast<std::time_t>(createdAt));
+    for (std::uint64_t i = 0; i < tags; ++i) {
+        if (!getString(p, end, tag)) return false;
+        ticket->addTag(tag);
+    }
+    out = std::move(ticket);
+    return true;
+}
+
+// Reads back an exported file (e.g. a MappedFile's bytes) record by record
+class BinaryExportReader {
+private:
+    const char* p;
+    const char* end;
+    BinaryEntity kind = BinaryEntity::CUSTOMERS;
+    std::string failure;
+
+    // The next record's payload as [p, recordEnd), or false at the end
+    bool nextRecord(BinaryEntity expected, const char*& recordEnd) {
+        if (!failure.empty() || p == end) return false;
+        if (kind != expected) {
+            failure = "File holds other records";
+            return false;
+        }
+        std::uint64_t n;
+        if (!binary_detail::getVarint(p, end, n) || n > static_cast<std::uint64_t>(end - p)) {
+            failure = "Truncated record";
+            return false;
+        }
+        recordEnd = p + n;
+        return true;
+    }
+
+    bool fail(const char* recordEnd) {
+        failure = "Malformed record";
+        p = recordEnd;
+        return false;
+    }
+
+public:
+    BinaryExportReader(const char* data, std::size_t size) : p(data), end(data + size) {
+        using namespace binary_detail;
+        if (size < HeaderSize || std::memcmp(data, Magic, sizeof(Magic)) != 0 ||
+            static_cast<unsigned char>(data[sizeof(Magic)]) > static_cast<unsigned char>(BinaryEntity::TICKETS)) {
+            failure = "Not an export file";
+            p = end;
+            return;
+        }
+        kind = static_cast<BinaryEntity>(data[sizeof(Magic)]);
+        p += HeaderSize;
+    }
+
+    bool ok() const { return failure.empty(); }
+    const std::string& error() const { return failure; }
+    BinaryEntity entity() const { return kind; }
+
+    // False at the end of the file or on an error (see ok())
+    bool next(std::shared_ptr<domain::Customer>& out) {
+        const char* recordEnd;
+        if (!nextRecord(BinaryEntity::CUSTOMERS, recordEnd)) return false;
+        if (!decodeBinaryRecord(p, recordEnd, out)) return fail(recordEnd);
+        p = recordEnd;
+        return true;
+    }
+
+    bool next(std::shared_ptr<domain::Ticket>& out) {
+        const char* recordEnd;
+        if (!nextRecord(BinaryEntity::TICKETS, recordEnd)) return false;
+        if (!decodeBinaryRecord(p, recordEnd, out)) return fail(recordEnd);
+        p = recordEnd;
+        return true;
+    }
+};
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef BULK_EXPORTER_HPP
+#define BULK_EXPORTER_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../../domain/factory/CustomerFactory.hpp"
+#include "../../domain/factory/TicketFactory.hpp"
+#include "../../domain/models/Customer.hpp"
+#include "../../domain/models/Tags.hpp"
+#include "../../domain/models/Ticket.hpp"
+#include "../../domain/services/CustomerService.hpp"
+#include "../../domain/services/TicketService.hpp"
+#include "BinaryFormat.hpp"
+#include "JsonRecords.hpp"
+#include "OutputBuffer.hpp"
+#include "RecordWriters.hpp"
+
+namespace infrastructure {
+
+enum class ExportFormat {
+    AUTO,     // by extension: .jsonl / .ndjson / .json, .bin, otherwise CSV
+    CSV,      // header row, then one record per row (what BulkImporter reads)
+    JSONL,    // one flat JSON object per line (what BulkImporter reads)
+    BINARY    // see BinaryFormat.hpp
+};
+
+// Empty / unset fields match everything
+struct TicketFilter {
+    std::optional<domain::TicketStatus> status;
+    std::optional<domain::Priority> priority;
+    std::optional<domain::TicketCategory> category;
+    std::string customerId;
+    std::string assignedTo;
+    std::vector<std::string> tags;       // tickets must have all of them
+    std::time_t createdFrom = 0;         // inclusive, seconds since the epoch
+    std::time_t createdUntil = 0;        // exclusive
+};
+
+// A TicketFilter with its tag names looked up once
+class TicketMatcher {
+private:
+    TicketFilter filter;
+    domain::TagSet tags;
+    bool unknownTag = false;   // a tag no ticket has ever had: nothing matches
+
+public:
+    explicit TicketMatcher(TicketFilter f) : filter(std::move(f)) {
+        const auto& dictionary = domain::TagDictionary::getInstance();
+        for (const auto& tag : filter.tags) {
+            auto id = dictionary.find(tag);
+            if (id) tags.add(*id);
+            else unknownTag = true;
+        }
+    }
+
+    bool operator()(const domain::Ticket& t) const {
+        if (unknownTag) return false;
+        if (filter.status && t.getStatus() != *filter.status) return false;
+        if (filter.priority && t.getPriority() != *filter.priority) return false;
+        if (filter.category && t.getCategory() != *filter.category) return false;
+        if (!filter.customerId.empty() && t.getCustomerId() != filter.customerId) return false;
+        if (!filter.assignedTo.empty() && t.getAssignedTo() != filter.assignedTo) return false;
+        if (filter.createdFrom && t.getCreatedAt() < filter.createdFrom) return false;
+        if (filter.createdUntil && t.getCreatedAt() >= filter.createdUntil) return false;
+        return t.hasAllTags(tags);
+    }
+};
+
+struct CustomerFilter {
+    std::optional<domain::CustomerType> type;
+};
+
+struct ExportOptions {
+    ExportFormat format = ExportFormat::AUTO;
+    unsigned files = 1;                 // > 1: split over that many files written in parallel,
+                                        // "tickets.csv" -> "tickets.000.csv", "tickets.001.csv", ...
+    std::size_t pageSize = 4096;        // records read from the repository at a time
+    std::size_t bufferSize = 1 << 20;   // bytes collected per file before each write
+};
+
+struct ExportReport {
+    std::string error;                  // set if any file could not be written
+    std::vector<std::string> files;
+    std::size_t scanned = 0;
+    std::size_t exported = 0;
+    std::size_t bytes = 0;
+    double seconds = 0;
+
+    bool ok() const { return error.empty(); }
+
+    double recordsPerSecond() const {
+        return seconds > 0 ? static_cast<double>(exported) / seconds : 0;
+    }
+};
+
+// Writes customers and tickets out in the columns BulkImporter reads, with
+// enums as their CustomerFactory / TicketFactory names.
+//
+// Records are read from the repository a page at a time in id order and
+// formatted straight into a large output buffer, so neither the full result
+// nor a repository lock is held while writing. When split over several
+// files, each file has its own writer thread; the threads take turns
+// fetching the next page, then filter and format it independently. Every
+// file is complete on its own (with its own header).
+class BulkExporter {
+private:
+    std::shared_ptr<domain::CustomerService> customerService;
+    std::shared_ptr<domain::TicketService> ticketService;
+
+    using Clock = std::chrono::steady_clock;
+
+    // -------- per-entity schemas --------
+
+    struct CustomerRecords {
+        using Item = domain::Customer;
+        static constexpr BinaryEntity entity = BinaryEntity::CUSTOMERS;
+
+        domain::CustomerService& service;
+        const CustomerFilter& filter;
+
+        std::vector<std::shared_ptr<Item>> fetch(const std::string& after, std::size_t limit) const {
+            return service.getCustomersPage(after, limit);
+        }
+
+        bool matches(const Item& c) const {
+            return !filter.type || c.getType() == *filter.type;
+        }
+
+        static const char* csvHeader() { return "id,name,email,phone,type\n"; }
+
+        static void writeCsv(std::string& out, const Item& c) {
+            appendCsvField(out, c.getId());
+            out.push_back(',');
+            appendCsvField(out, c.getName());
+            out.push_back(',');
+            appendCsvField(out, c.getEmail());
+            out.push_back(',');
+            appendCsvField(out, c.getPhone());
+            out.push_back(',');
+            out += domain::CustomerFactory::getTypeName(c.getType());
+            out.push_back('\n');
+        }
+    };
+
+    struct TicketRecords {
+        using Item = domain::Ticket;
+        static constexpr BinaryEntity entity = BinaryEntity::TICKETS;
+
+        domain::TicketService& service;
+        TicketMatcher matcher;
+
+        std::vector<std::shared_ptr<Item>> fetch(const std::string& after, std::size_t limit) const {
+            return service.getTicketsPage(after, limit);
+        }
+
+        bool matches(const Item& t) const { return matcher(t); }
+
+        static const char* csvHeader() {
+            return "id,customerId,description,status,priority,category,assignedTo,createdAt,tags\n";
+        }
+
+        static void writeCsv(std::string& out, const Item& t) {
+            using domain::TicketFactory;
+            appendCsvField(out, t.getId());
+            out.push_back(',');
+            appendCsvField(out, t.getCustomerId());
+            out.push_back(',');
+            appendCsvField(out, t.getDescription());
+            out.push_back(',');
+            out += TicketFactory::getStatusName(t.getStatus());
+            out.push_back(',');
+            out += TicketFactory::getPriorityName(t.getPriority());
+            out.push_back(',');
+            out += TicketFactory::getCategoryName(t.getCategory());
+            out.push_back(',');
+            appendCsvField(out, t.getAssignedTo());
+            out.push_back(',');
+            appendNumber(out, static_cast<long long>(t.getCreatedAt()));
+            out.push_back(',');
+
+            std::string tags;
+            const auto& dictionary = domain::TagDictionary::getInstance();
+            t.getTagSet().forEach([&](domain::TagId tag) {
+                if (!tags.empty()) tags.push_back('|');
+                tags += dictionary.name(tag);
+            });
+            appendCsvField(out, tags);
+            out.push_back('\n');
+        }
+    };
+
+    static ExportFormat formatFor(const std::string& path, ExportFormat format) {
+        if (format != ExportFormat::AUTO) return format;
+        const auto dot = path.rfind('.');
+        std::string ext = dot == std::string::npos ? "" : path.substr(dot + 1);
+        for (auto& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (ext == "jsonl" || ext == "ndjson" || ext == "json") return ExportFormat::JSONL;
+        if (ext == "bin") return ExportFormat::BINARY;
+        return ExportFormat::CSV;
+    }
+
+    // "dir/tickets.csv", part 3 of 8 -> "dir/tickets.003.csv"
+    static std::string partPath(const std::string& path, unsigned part, unsigned parts) {
+        if (parts == 1) return path;
+        char number[16];
+        std::snprintf(number, sizeof(number), ".%03u", part);
+        const auto slash = path.find_last_of("/\\");
+        const auto dot = path.rfind('.');
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return path + number;
+        return path.substr(0, dot) + number + path.substr(dot);
+    }
+
+    template <typename Fn>
+    static void parallelFor(std::size_t n, Fn&& fn) {
+        std::vector<std::thread> threads;
+        for (std::size_t k = 1; k < n; ++k) threads.emplace_back(fn, k);
+        if (n > 0) fn(0);
+        for (auto& t : threads) t.join();
+    }
+
+    template <typename Records>
+    static ExportReport run(const std::string& path, const ExportOptions& options, const Records& records) {
+        const auto started = Clock::now();
+        ExportReport report;
+
+        const ExportFormat format = formatFor(path, options.format);
+        const unsigned parts = std::max(1u, options.files);
+        const std::size_t pageSize = std::max<std::size_t>(1, options.pageSize);
+        for (unsigned k = 0; k < parts; ++k) report.files.push_back(partPath(path, k, parts));
+
+        // Shared position in the repository
+        std::mutex cursorMutex;
+        std::string cursor;
+        bool exhausted = false;
+
+        std::mutex reportMutex;
+        parallelFor(parts, [&](std::size_t k) {
+            OutputBuffer out(report.files[k], options.bufferSize);
+            std::size_t scanned = 0, exported = 0;
+            std::string payload;
+
+            if (out.isOpen()) {
+                if (format == ExportFormat::CSV) out.data() += Records::csvHeader();
+                else if (format == ExportFormat::BINARY) appendBinaryHeader(out.data(), Records::entity);
+
+                for (;;) {
+                    std::vector<std::shared_ptr<typename Records::Item>> page;
+                    {
+                        std::lock_guard<std::mutex> lock(cursorMutex);
+                        if (exhausted) break;
+                        page = records.fetch(cursor, pageSize);
+                        if (page.size() < pageSize) exhausted = true;
+                        if (!page.empty()) cursor = page.back()->getId();
+                    }
+
+                    scanned += page.size();
+                    for (const auto& item : page) {
+                        if (!records.matches(*item)) continue;
+                        ++exported;
+                        switch (format) {
+                            case ExportFormat::JSONL:
+                                appendJsonRecord(out.data(), *item);
+                                out.data().push_back('\n');
+                                break;
+                            case ExportFormat::BINARY: appendBinaryRecord(out.data(), payload, *item); break;
+                            default:                   Records::writeCsv(out.data(), *item); break;
+                        }
+                        out.commit();
+                    }
+                }
+            }
+            out.close();
+
+            std::lock_guard<std::mutex> lock(reportMutex);
+            report.scanned += scanned;
+            report.exported += exported;
+            report.bytes += out.bytesWritten();
+            if (!out.error().empty() && report.error.empty()) report.error = out.error();
+        });
+
+        report.seconds = std::chrono::duration<double>(Clock::now() - started).count();
+        return report;
+    }
+
+public:
+    BulkExporter(std::shared_ptr<domain::CustomerService> customers,
+                 std::shared_ptr<domain::TicketService> tickets)
+        : customerService(std::move(customers)), ticketService(std::move(tickets)) {}
+
+    ExportReport exportCustomers(const std::string& path, const ExportOptions& options = {},
+                                 const CustomerFilter& filter = {}) {
+        return run(path, options, CustomerRecords{*customerService, filter});
+    }
+
+    ExportReport exportTickets(const std::string& path, const ExportOptions& options = {},
+                               const TicketFilter& filter = {}) {
+        return run(path, options, TicketRecords{*ticketService, TicketMatcher(filter)});
+    }
+};
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef JSON_RECORDS_HPP
+#define JSON_RECORDS_HPP
+
+#include <string>
+
+#include "../../domain/factory/CustomerFactory.hpp"
+#include "../../domain/factory/TicketFactory.hpp"
+#include "../../domain/models/Customer.hpp"
+#include "../../domain/models/Tags.hpp"
+#include "../../domain/models/Ticket.hpp"
+#include "RecordWriters.hpp"
+
+namespace infrastructure {
+
+// Customers and tickets as JSON objects, with the field names BulkImporter
+// reads and enums as their factory names
+
+inline void appendJsonRecord(std::string& out, const domain::Customer& c) {
+    out += "{\"id\":";
+    appendJsonString(out, c.getId());
+    out += ",\"name\":";
+    appendJsonString(out, c.getName());
+    out += ",\"email\":";
+    appendJsonString(out, c.getEmail());
+    out += ",\"phone\":";
+    appendJsonString(out, c.getPhone());
+    out += ",\"type\":";
+    appendJsonString(out, domain::CustomerFactory::getTypeName(c.getType()));
+    out += "}";
+}
+
+inline void appendJsonRecord(std::string& out, const domain::Ticket& t) {
+    using domain::TicketFactory;
+    out += "{\"id\":";
+    appendJsonString(out, t.getId());
+    out += ",\"customerId\":";
+    appendJsonString(out, t.getCustomerId());
+    out += ",\"description\":";
+    appendJsonString(out, t.getDescription());
+    out += ",\"status\":\"";
+    out += TicketFactory::getStatusName(t.getStatus());
+    out += "\",\"priority\":\"";
+    out += TicketFactory::getPriorityName(t.getPriority());
+    out += "\",\"category\":\"";
+    out += TicketFactory::getCategoryName(t.getCategory());
+    out += "\",\"assignedTo\":";
+    appendJsonString(out, t.getAssignedTo());
+    out += ",\"createdAt\":";
+    appendNumber(out, static_cast<long long>(t.getCreatedAt()));
+    out += ",\"tags\":[";
+
+    bool first = true;
+    const auto& dictionary = domain::TagDictionary::getInstance();
+    t.getTagSet().forEach([&](domain::TagId tag) {
+        if (!first) out.push_back(',');
+        appendJsonString(out, dictionary.name(tag));
+        first = false;
+    });
+    out += "]}";
+}
+
+} // namespace infrastructure
+
+#endif
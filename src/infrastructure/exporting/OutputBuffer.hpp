@@ -0,0 +1,82 @@
+#ifndef OUTPUT_BUFFER_HPP
+#define OUTPUT_BUFFER_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace infrastructure {
+
+// Collects formatted records in memory and writes them out in large blocks,
+// one write per `capacity` bytes instead of one per field. The file itself
+// is unbuffered, so each flush is a single write call.
+class OutputBuffer {
+private:
+    std::FILE* file = nullptr;
+    bool owned = false;
+    std::string buffer;
+    std::size_t capacity;
+    std::size_t written = 0;
+    std::string failure;
+
+public:
+    OutputBuffer(const std::string& path, std::size_t capacity)
+        : file(std::fopen(path.c_str(), "wb")), owned(true), capacity(capacity) {
+        if (!file) {
+            failure = "Cannot create " + path + ": " + std::strerror(errno);
+            return;
+        }
+        std::setvbuf(file, nullptr, _IONBF, 0);
+        buffer.reserve(capacity + capacity / 8);
+    }
+
+    // Writes to an already open stream such as stdout, which stays open
+    OutputBuffer(std::FILE* stream, std::size_t capacity) : file(stream), capacity(capacity) {
+        buffer.reserve(capacity + capacity / 8);
+    }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    ~OutputBuffer() { close(); }
+
+    bool isOpen() const { return file != nullptr; }
+    const std::string& error() const { return failure; }
+
+    // Records are appended here directly; call commit() after each one
+    std::string& data() { return buffer; }
+
+    void commit() {
+        if (buffer.size() >= capacity) flush();
+    }
+
+    bool flush() {
+        if (!file || buffer.empty()) return failure.empty();
+        if (failure.empty() && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+            failure = std::string("Write failed: ") + std::strerror(errno);
+        written += buffer.size();
+        buffer.clear();
+        return failure.empty();
+    }
+
+    // Flushes and closes; false if anything could not be written
+    bool close() {
+        flush();
+        if (file) {
+            if (owned && std::fclose(file) != 0 && failure.empty())
+                failure = std::string("Close failed: ") + std::strerror(errno);
+            else if (!owned)
+                std::fflush(file);
+            file = nullptr;
+        }
+        return failure.empty();
+    }
+
+    std::size_t bytesWritten() const { return written + buffer.size(); }
+};
+
+} // namespace infrastructure
+
+#endif
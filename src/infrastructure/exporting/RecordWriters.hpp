@@ -0,0 +1,64 @@
+#ifndef RECORD_WRITERS_HPP
+#define RECORD_WRITERS_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+
+namespace infrastructure {
+
+inline void appendNumber(std::string& out, long long value) {
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+// Writes value as a CSV field, quoted only when it contains a comma, a
+// quote or a line break (the form readCsvRecord() reads back)
+inline void appendCsvField(std::string& out, const std::string& value) {
+    if (value.find_first_of(",\"\r\n") == std::string::npos) {
+        out += value;
+        return;
+    }
+    out.push_back('"');
+    std::size_t begin = 0;
+    for (std::size_t q = value.find('"'); q != std::string::npos; q = value.find('"', begin)) {
+        out.append(value, begin, q + 1 - begin);
+        out.push_back('"');
+        begin = q + 1;
+    }
+    out.append(value, begin, std::string::npos);
+    out.push_back('"');
+}
+
+// Writes value as a quoted JSON string. Bytes >= 0x80 are passed through,
+// so UTF-8 text stays as it is.
+inline void appendJsonString(std::string& out, const std::string& value) {
+    static const char hex[] = "0123456789abcdef";
+    out.push_back('"');
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        const auto c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out.append(value, begin, i - begin);
+        begin = i + 1;
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out.push_back(hex[c >> 4]);
+                out.push_back(hex[c & 0xF]);
+        }
+    }
+    out.append(value, begin, std::string::npos);
+    out.push_back('"');
+}
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef HTTP_MESSAGE_HPP
+#define HTTP_MESSAGE_HPP
+
+#include <cctype>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace infrastructure {
+
+inline bool equalsIgnoreCase(const std::string& a, const char* b) {
+    const std::size_t n = std::strlen(b);
+    if (a.size() != n) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+            return false;
+    }
+    return true;
+}
+
+struct HttpRequest {
+    std::string method;
+    std::string path;       // percent-decoded, without the query
+    std::string query;      // raw text after '?'
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string body;
+    bool keepAlive = true;
+
+    // Case-insensitive; "" if absent
+    const std::string& header(const char* name) const {
+        static const std::string none;
+        for (const auto& h : headers) {
+            if (equalsIgnoreCase(h.first, name)) return h.second;
+        }
+        return none;
+    }
+};
+
+struct HttpResponse {
+    int status = 200;
+    std::string contentType = "application/json";
+    std::string body;
+};
+
+inline const char* httpReason(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 411: return "Length Required";
+        case 413: return "Payload Too Large";
+        case 422: return "Unprocessable Entity";
+        case 429: return "Too Many Requests";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+    }
+    return "Unknown";
+}
+
+// Status line, headers and body, ready to send
+inline void appendHttpResponse(std::string& out, const HttpResponse& r, bool keepAlive) {
+    out += "HTTP/1.1 ";
+    out += std::to_string(r.status);
+    out.push_back(' ');
+    out += httpReason(r.status);
+    out += "\r\nContent-Type: ";
+    out += r.contentType;
+    out += "\r\nContent-Length: ";
+    out += std::to_string(r.body.size());
+    out += keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+    out += r.body;
+}
+
+// "%2F" -> "/", and '+' -> ' ' when decoding a query value
+inline std::string percentDecode(const char* p, const char* end, bool plusIsSpace) {
+    auto hex = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+    std::string out;
+    out.reserve(static_cast<std::size_t>(end - p));
+    for (; p < end; ++p) {
+        if (*p == '%' && end - p >= 3 && hex(p[1]) >= 0 && hex(p[2]) >= 0) {
+            out.push_back(static_cast<char>(hex(p[1]) * 16 + hex(p[2])));
+            p += 2;
+        } else if (*p == '+' && plusIsSpace) {
+            out.push_back(' ');
+        } else {
+            out.push_back(*p);
+        }
+    }
+    return out;
+}
+
+// "a=1&b=x%20y" -> {{"a", "1"}, {"b", "x y"}}
+inline std::vector<std::pair<std::string, std::string>> parseQuery(const std::string& query) {
+    std::vector<std::pair<std::string, std::string>> params;
+    const char* p = query.data();
+    const char* end = p + query.size();
+    while (p < end) {
+        const char* amp = static_cast<const char*>(std::memchr(p, '&', static_cast<std::size_t>(end - p)));
+        if (!amp) amp = end;
+        const char* eq = static_cast<const char*>(std::memchr(p, '=', static_cast<std::size_t>(amp - p)));
+        if (amp > p) {
+            if (eq) params.emplace_back(percentDecode(p, eq, true), percentDecode(eq + 1, amp, true));
+            else params.emplace_back(percentDecode(p, amp, true), std::string());
+        }
+        p = amp + 1;
+    }
+    return params;
+}
+
+enum class HttpParseResult { INCOMPLETE, COMPLETE, FAILED };
+
+struct HttpLimits {
+    std::size_t maxHeaderBytes = 16 * 1024;
+    std::size_t maxBodyBytes = 1 << 20;
+};
+
+// Parses one request from the start of [data, data + size). On COMPLETE,
+// `consumed` is its length, so pipelined requests can be parsed one after
+// another from the same buffer. On FAILED, `errorStatus` is the status to
+// answer with before closing the connection. Bodies need a Content-Length;
+// chunked uploads are refused.
+inline HttpParseResult parseHttpRequest(const char* data, std::size_t size, const HttpLimits& limits,
+                                        HttpRequest& request, std::size_t& consumed, int& errorStatus) {
+    // Leading blank lines are allowed between pipelined requests
+    std::size_t start = 0;
+    while (start < size && (data[start] == '\r' || data[start] == '\n')) ++start;
+
+    const char* begin = data + start;
+    const char* end = data + size;
+    const char* headEnd = nullptr;
+    for (const char* p = begin; (p = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p))));) {
+        if (p + 1 < end && p[1] == '\n') {
+            headEnd = p + 2;
+            break;
+        }
+        if (p + 2 < end && p[1] == '\r' && p[2] == '\n') {
+            headEnd = p + 3;
+            break;
+        }
+        ++p;
+    }
+    if (!headEnd) {
+        if (static_cast<std::size_t>(end - begin) > limits.maxHeaderBytes) {
+            errorStatus = 431;
+            return HttpParseResult::FAILED;
+        }
+        return HttpParseResult::INCOMPLETE;
+    }
+    if (static_cast<std::size_t>(headEnd - begin) > limits.maxHeaderBytes) {
+        errorStatus = 431;
+        return HttpParseResult::FAILED;
+    }
+
+    auto lineEnd = [&](const char* p) {
+        return static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(headEnd - p)));
+    };
+    auto trimmed = [](const char* p, const char* e) {
+        while (p < e && (*p == ' ' || *p == '\t')) ++p;
+        while (e > p && (e[-1] == ' ' || e[-1] == '\t' || e[-1] == '\r')) --e;
+        return std::string(p, e);
+    };
+
+    request = HttpRequest();
+    errorStatus = 400;
+
+    // Request line: METHOD SP target SP HTTP/1.x
+    const char* nl = lineEnd(begin);
+    const char* lineStop = nl > begin && nl[-1] == '\r' ? nl - 1 : nl;
+    const char* sp1 = static_cast<const char*>(std::memchr(begin, ' ', static_cast<std::size_t>(lineStop - begin)));
+    if (!sp1) return HttpParseResult::FAILED;
+    const char* sp2 = static_cast<const char*>(std::memchr(sp1 + 1, ' ', static_cast<std::size_t>(lineStop - sp1 - 1)));
+    if (!sp2 || lineStop - sp2 != 9 || std::memcmp(sp2 + 1, "HTTP/1.", 7) != 0) return HttpParseResult::FAILED;
+    const char minor = sp2[8];
+    if (minor != '0' && minor != '1') return HttpParseResult::FAILED;
+
+    request.method.assign(begin, sp1);
+    const char* target = sp1 + 1;
+    const char* question = static_cast<const char*>(std::memchr(target, '?', static_cast<std::size_t>(sp2 - target)));
+    request.path = percentDecode(target, question ? question : sp2, false);
+    if (question) request.query.assign(question + 1, sp2);
+    if (request.method.empty() || request.path.empty() || request.path[0] != '/') return HttpParseResult::FAILED;
+    request.keepAlive = minor == '1';
+
+    // Headers
+    std::size_t contentLength = 0;
+    for (const char* p = nl + 1; p < headEnd; ) {
+        const char* e = lineEnd(p);
+        if (e == p || (e == p + 1 && *p == '\r')) break;
+        const char* colon = static_cast<const char*>(std::memchr(p, ':', static_cast<std::size_t>(e - p)));
+        if (!colon || colon == p) return HttpParseResult::FAILED;
+        request.headers.emplace_back(std::string(p, colon), trimmed(colon + 1, e));
+        const auto& [name, value] = request.headers.back();
+
+        if (equalsIgnoreCase(name, "Content-Length")) {
+            char* stop = nullptr;
+            const unsigned long long n = std::strtoull(value.c_str(), &stop, 10);
+            if (value.empty() || *stop != '\0' || !std::isdigit(static_cast<unsigned char>(value[0])))
+                return HttpParseResult::FAILED;
+            if (n > limits.maxBodyBytes) {
+                errorStatus = 413;
+                return HttpParseResult::FAILED;
+            }
+            contentLength = static_cast<std::size_t>(n);
+        } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+            errorStatus = 501;
+            return HttpParseResult::FAILED;
+        } else if (equalsIgnoreCase(name, "Connection")) {
+            if (equalsIgnoreCase(value, "close")) request.keepAlive = false;
+            else if (equalsIgnoreCase(value, "keep-alive")) request.keepAlive = true;
+        }
+        p = e + 1;
+    }
+
+    if (static_cast<std::size_t>(end - headEnd) < contentLength) return HttpParseResult::INCOMPLETE;
+    request.body.assign(headEnd, contentLength);
+    consumed = static_cast<std::size_t>(headEnd - data) + contentLength;
+    return HttpParseResult::COMPLETE;
+}
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef HTTP_SERVER_HPP
+#define HTTP_SERVER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../net/StreamServer.hpp"
+#include "HttpMessage.hpp"
+
+namespace infrastructure {
+
+using HttpHandler = std::function<HttpResponse(const HttpRequest&)>;
+
+struct HttpServerOptions {
+    std::string host = "127.0.0.1";
+    std::uint16_t port = 8080;       // 0 = any free port, see HttpServer::port()
+    unsigned workers = 0;            // handler threads; 0 = one per hardware thread
+    std::size_t maxPipelined = 64;   // requests queued per connection before it is no longer read
+    HttpLimits limits;
+};
+
+using HttpServerStats = StreamServerStats;
+
+#if defined(__linux__)
+
+// HTTP/1.1 server on a StreamServer: keep-alive connections that may
+// pipeline requests. The requests a connection has queued go to one worker
+// together and are answered in order; after a "Connection: close" request
+// nothing more is answered.
+class HttpServer {
+private:
+    struct Protocol {
+        struct State {
+            std::deque<HttpRequest> pending;   // parsed, not yet handed to a worker
+            int failedStatus = 0;              // unparseable input: answer this after `pending`
+        };
+
+        using Job = std::vector<HttpRequest>;
+
+        HttpHandler handler;
+        HttpServerOptions options;
+
+        bool parse(std::string& in, State& state) const {
+            std::size_t offset = 0;
+            bool ok = true;
+            while (offset < in.size()) {
+                HttpRequest request;
+                std::size_t consumed = 0;
+                int status = 0;
+                const auto result = parseHttpRequest(in.data() + offset, in.size() - offset, options.limits,
+                                                     request, consumed, status);
+                if (result == HttpParseResult::INCOMPLETE) break;
+                if (result == HttpParseResult::FAILED) {
+                    state.failedStatus = status;
+                    ok = false;
+                    break;
+                }
+                offset += consumed;
+                state.pending.push_back(std::move(request));
+            }
+            in.erase(0, offset);
+            return ok;
+        }
+
+        bool ready(const State& state) const { return !state.pending.empty(); }
+
+        bool accepting(const State& state) const { return state.pending.size() < options.maxPipelined; }
+
+        Job take(State& state) const {
+            Job job;
+            while (!state.pending.empty()) {
+                job.push_back(std::move(state.pending.front()));
+                state.pending.pop_front();
+                if (!job.back().keepAlive) break;
+            }
+            return job;
+        }
+
+        bool finish(State& state, std::string& out) const {
+            if (!state.failedStatus) return false;
+            HttpResponse error;
+            error.status = state.failedStatus;
+            error.body = "{\"error\":\"" + std::string(httpReason(state.failedStatus)) + "\"}";
+            appendHttpResponse(out, error, false);
+            state.failedStatus = 0;
+            return true;
+        }
+
+        std::size_t run(Job& job, std::string& out, bool& close) const {
+            for (const auto& request : job) {
+                HttpResponse response;
+                try {
+                    response = handler(request);
+                } catch (const std::exception&) {
+                    response.status = 500;
+                    response.body = "{\"error\":\"Internal error\"}";
+                }
+                appendHttpResponse(out, response, request.keepAlive);
+                if (!request.keepAlive) close = true;
+            }
+            return job.size();
+        }
+    };
+
+    Protocol protocol;
+    StreamServer<Protocol> server;
+    std::string failure;
+    std::uint16_t boundPort = 0;
+
+public:
+    HttpServer(HttpHandler handler, HttpServerOptions options = {})
+        : protocol{std::move(handler), std::move(options)}
+        , server(protocol, protocol.options.workers) {}
+
+    // Binds and starts serving; false with error() set if the address
+    // cannot be used
+    bool start() {
+        if (server.isRunning()) return true;
+        const int fd = listenTcp(protocol.options.host, protocol.options.port, boundPort, failure);
+        return fd >= 0 && server.start(fd, failure);
+    }
+
+    // Closes every connection; requests in progress are finished first
+    void stop() { server.stop(); }
+
+    bool isRunning() const { return server.isRunning(); }
+    const std::string& error() const { return failure; }
+    std::uint16_t port() const { return boundPort; }
+    HttpServerStats getStats() const { return server.getStats(); }
+};
+
+#else
+
+// Needs epoll; elsewhere start() fails
+class HttpServer {
+private:
+    std::string failure = "The HTTP server needs Linux (epoll)";
+
+public:
+    HttpServer(HttpHandler, HttpServerOptions = {}) {}
+
+    bool start() { return false; }
+    void stop() {}
+    bool isRunning() const { return false; }
+    const std::string& error() const { return failure; }
+    std::uint16_t port() const { return 0; }
+    HttpServerStats getStats() const { return {}; }
+};
+
+#endif
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,346 @@
+#ifndef SUPPORT_HTTP_API_HPP
+#define SUPPORT_HTTP_API_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../domain/behaviors/chain/TicketCreationRequest.hpp"
+#include "../../domain/behaviors/chain/TicketValidation.hpp"
+#include "../../domain/factory/EnumNames.hpp"
+#include "../../domain/services/CustomerService.hpp"
+#include "../../domain/services/SupportFacade.hpp"
+#include "../../domain/services/TicketService.hpp"
+#include "../exporting/BulkExporter.hpp"
+#include "../exporting/JsonRecords.hpp"
+#include "../exporting/RecordWriters.hpp"
+#include "../importing/RecordReaders.hpp"
+#include "HttpMessage.hpp"
+
+namespace infrastructure {
+
+// JSON endpoints over CustomerService, TicketService and SupportFacade, for
+// use as an HttpServer handler:
+//
+//   GET   /health
+//   POST  /customers         {"name", "email", "phone", "type"?}
+//   GET   /customers/{id}
+//   POST  /tickets           {"customerId", "description", "priority"?, "category"?}
+//   GET   /tickets/{id}
+//   PATCH /tickets/{id}      {"status"?, "assignedTo"?}
+//   GET   /tickets?status=&priority=&category=&customer=&agent=&tag=&limit=&after=
+//                            -> {"tickets": [...], "next": id or null}
+//   POST  /onboarding        {"name", "email", "phone", "description", "priority"?, "category"?}
+//
+// Records use the field names and enum names of the JSONL export. Errors are
+// {"error": "..."}: 400 for malformed requests, 404 for unknown ids, 409 for
+// status changes the state machine refuses, 422 for tickets that fail
+// validation (the shared TicketValidation, as in the CLI) and 429 for those
+// refused by its rate limits. handle() may be called from many threads at
+// once.
+class SupportHttpApi {
+private:
+    using Members = std::vector<std::pair<std::string, std::string>>;
+
+    std::shared_ptr<domain::CustomerService> customerService;
+    std::shared_ptr<domain::TicketService> ticketService;
+    domain::SupportFacade& facade;
+    const domain::behaviors::chain::TicketValidation& validation;
+
+    static constexpr std::size_t DefaultPageLimit = 50;
+    static constexpr std::size_t MaxPageLimit = 1000;
+
+    static HttpResponse error(int status, const std::string& message) {
+        HttpResponse r;
+        r.status = status;
+        r.body = "{\"error\":";
+        appendJsonString(r.body, message);
+        r.body += "}";
+        return r;
+    }
+
+    template <typename Record>
+    static HttpResponse record(int status, const Record& value) {
+        HttpResponse r;
+        r.status = status;
+        appendJsonRecord(r.body, value);
+        return r;
+    }
+
+    static const std::string* member(const Members& members, const char* name) {
+        for (const auto& m : members) {
+            if (m.first == name) return &m.second;
+        }
+        return nullptr;
+    }
+
+    // False with `response` set if the body is not a JSON object
+    static bool readBody(const HttpRequest& request, Members& members, HttpResponse& response) {
+        std::string reason;
+        const char* p = request.body.data();
+        if (readJsonObject(p, p + request.body.size(), members, reason)) return true;
+        response = error(400, reason);
+        return false;
+    }
+
+    // "/tickets/TKT-1" -> {"tickets", "TKT-1"}
+    static std::vector<std::string> segments(const std::string& path) {
+        std::vector<std::string> parts;
+        std::size_t begin = 1;
+        while (begin <= path.size()) {
+            std::size_t end = path.find('/', begin);
+            if (end == std::string::npos) end = path.size();
+            if (end > begin) parts.push_back(path.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        return parts;
+    }
+
+    // -------- customers --------
+
+    HttpResponse createCustomer(const HttpRequest& request) {
+        Members body;
+        HttpResponse response;
+        if (!readBody(request, body, response)) return response;
+
+        const auto* name = member(body, "name");
+        const auto* email = member(body, "email");
+        const auto* phone = member(body, "phone");
+        const auto* typeName = member(body, "type");
+        if (!name || name->empty()) return error(400, "Name is required");
+        if (!email || email->find('@') == std::string::npos) return error(400, "Invalid email");
+        domain::CustomerType type = domain::CustomerType::REGULAR;
+        if (typeName && !domain::parseCustomerType(*typeName, type))
+            return error(400, "Unknown customer type: " + *typeName);
+
+        const auto id = customerService->registerCustomer(*name, *email, phone ? *phone : "", type);
+        auto customer = customerService->getCustomer(id);
+        if (!customer) return error(500, "Customer could not be registered");
+        return record(201, *customer);
+    }
+
+    HttpResponse getCustomer(const std::string& id) {
+        auto customer = customerService->getCustomer(id);
+        if (!customer) return error(404, "Unknown customer: " + id);
+        return record(200, *customer);
+    }
+
+    // -------- tickets --------
+
+    HttpResponse createTicket(const HttpRequest& request) {
+        Members body;
+        HttpResponse response;
+        if (!readBody(request, body, response)) return response;
+
+        domain::behaviors::chain::TicketCreationRequest req;
+        const auto* customerId = member(body, "customerId");
+        const auto* description = member(body, "description");
+        const auto* priority = member(body, "priority");
+        const auto* category = member(body, "category");
+        if (!customerId || !description) return error(400, "customerId and description are required");
+        req.customerId = *customerId;
+        req.description = *description;
+        if (priority && !domain::parsePriority(*priority, req.priority))
+            return error(400, "Unknown priority: " + *priority);
+        if (category && !domain::parseTicketCategory(*category, req.category))
+            return error(400, "Unknown category: " + *category);
+
+        if (!validation.validate(req))
+            return error(domain::behaviors::chain::ThrottleRule::rejected(req) ? 429 : 422, req.errorMessage);
+        const auto id = ticketService->createTicket(req.customerId, req.description, req.priority, req.category);
+        auto ticket = id.empty() ? nullptr : ticketService->getTicket(id);
+        if (!ticket) return error(422, "Ticket could not be created");
+        return record(201, *ticket);
+    }
+
+    HttpResponse getTicket(const std::string& id) {
+        auto ticket = ticketService->getTicket(id);
+        if (!ticket) return error(404, "Unknown ticket: " + id);
+        return record(200, *ticket);
+    }
+
+    HttpResponse updateTicket(const std::string& id, const HttpRequest& request) {
+        Members body;
+        HttpResponse response;
+        if (!readBody(request, body, response)) return response;
+
+        const auto* statusName = member(body, "status");
+        const auto* agent = member(body, "assignedTo");
+        domain::TicketStatus status;
+        if (statusName && !domain::parseTicketStatus(*statusName, status))
+            return error(400, "Unknown status: " + *statusName);
+        if (!ticketService->getTicket(id)) return error(404, "Unknown ticket: " + id);
+
+        // Status first, so a rejected transition leaves the assignee unchanged
+        if (statusName) {
+            switch (ticketService->updateTicketStatus(id, status)) {
+                case domain::StatusUpdateResult::UPDATED:
+                    break;
+                case domain::StatusUpdateResult::NOT_FOUND:
+                    return error(404, "Unknown ticket: " + id);
+                case domain::StatusUpdateResult::ILLEGAL_TRANSITION:
+                    return error(409, "Not allowed: " + id + " -> " +
+                                          domain::TicketFactory::getStatusName(status));
+                case domain::StatusUpdateResult::CONFLICT:
+                    return error(409, "Changed concurrently: " + id);
+            }
+        }
+        if (agent && !ticketService->assignTicket(id, *agent)) return error(404, "Unknown ticket: " + id);
+        return getTicket(id);
+    }
+
+    HttpResponse queryTickets(const HttpRequest& request) {
+        TicketFilter filter;
+        std::size_t limit = DefaultPageLimit;
+        std::string after;
+        for (const auto& [key, value] : parseQuery(request.query)) {
+            bool valid = true;
+            if (key == "status") {
+                filter.status.emplace();
+                valid = domain::parseTicketStatus(value, *filter.status);
+            } else if (key == "priority") {
+                filter.priority.emplace();
+                valid = domain::parsePriority(value, *filter.priority);
+            } else if (key == "category") {
+                filter.category.emplace();
+                valid = domain::parseTicketCategory(value, *filter.category);
+            } else if (key == "customer") {
+                filter.customerId = value;
+            } else if (key == "agent") {
+                filter.assignedTo = value;
+            } else if (key == "tag") {
+                filter.tags.push_back(value);
+            } else if (key == "after") {
+                after = value;
+            } else if (key == "limit") {
+                char* stop = nullptr;
+                limit = static_cast<std::size_t>(std::strtoul(value.c_str(), &stop, 10));
+                valid = !value.empty() && *stop == '\0' && limit > 0;
+                limit = std::min(limit, MaxPageLimit);
+            } else {
+                valid = false;
+            }
+            if (!valid) return error(400, "Bad query parameter: " + key + "=" + value);
+        }
+
+        // Scans in id order from `after` and stops at `limit` matches; "next"
+        // is the cursor for the following page
+        const TicketMatcher matches(std::move(filter));
+        const std::size_t pageSize = 1024;
+        HttpResponse response;
+        auto& out = response.body;
+        out = "{\"tickets\":[";
+        std::size_t found = 0;
+        std::string next;
+        while (next.empty()) {
+            const auto page = ticketService->getTicketsPage(after, pageSize);
+            for (const auto& t : page) {
+                if (!matches(*t)) continue;
+                if (found++) out.push_back(',');
+                appendJsonRecord(out, *t);
+                if (found == limit) {
+                    next = t->getId();
+                    break;
+                }
+            }
+            if (page.size() < pageSize) break;
+            after = page.back()->getId();
+        }
+        out += "],\"next\":";
+        if (next.empty()) out += "null";
+        else appendJsonString(out, next);
+        out += "}";
+        return response;
+    }
+
+    // -------- onboarding --------
+
+    HttpResponse onboard(const HttpRequest& request) {
+        Members body;
+        HttpResponse response;
+        if (!readBody(request, body, response)) return response;
+
+        domain::OnboardingRequest r;
+        const auto* name = member(body, "name");
+        const auto* email = member(body, "email");
+        const auto* phone = member(body, "phone");
+        const auto* description = member(body, "description");
+        const auto* priority = member(body, "priority");
+        const auto* category = member(body, "category");
+        if (!name || name->empty()) return error(400, "Name is required");
+        if (!email || email->find('@') == std::string::npos) return error(400, "Invalid email");
+        if (!description) return error(400, "description is required");
+        if (priority && !domain::parsePriority(*priority, r.priority))
+            return error(400, "Unknown priority: " + *priority);
+        if (category && !domain::parseTicketCategory(*category, r.category))
+            return error(400, "Unknown category: " + *category);
+
+        // The facade does not validate; the customer is new, so only the rules and content apply
+        domain::behaviors::chain::TicketCreationRequest ticket;
+        ticket.description = *description;
+        ticket.priority = r.priority;
+        ticket.category = r.category;
+        if (!validation.validateForNewCustomer(ticket)) return error(422, ticket.errorMessage);
+
+        const auto [customerId, ticketId] = facade.registerCustomerAndOpenTicket(
+            *name, *email, phone ? *phone : "", *description, r.priority, r.category);
+        if (ticketId.empty()) return error(422, "Ticket could not be created");
+
+        response.status = 201;
+        response.body = "{\"customerId\":";
+        appendJsonString(response.body, customerId);
+        response.body += ",\"ticketId\":";
+        appendJsonString(response.body, ticketId);
+        response.body += "}";
+        return response;
+    }
+
+public:
+    SupportHttpApi(std::shared_ptr<domain::CustomerService> customers,
+                   std::shared_ptr<domain::TicketService> tickets,
+                   domain::SupportFacade& facade,
+                   const domain::behaviors::chain::TicketValidation& validation)
+        : customerService(std::move(customers))
+        , ticketService(std::move(tickets))
+        , facade(facade)
+        , validation(validation) {}
+
+    HttpResponse handle(const HttpRequest& request) {
+        const auto parts = segments(request.path);
+        const std::string& m = request.method;
+
+        if (parts.size() == 1 && parts[0] == "health") {
+            if (m != "GET") return error(405, "Use GET");
+            HttpResponse r;
+            r.body = "{\"status\":\"ok\"}";
+            return r;
+        }
+        if (!parts.empty() && parts[0] == "customers") {
+            if (parts.size() == 1) return m == "POST" ? createCustomer(request) : error(405, "Use POST");
+            if (parts.size() == 2) return m == "GET" ? getCustomer(parts[1]) : error(405, "Use GET");
+        }
+        if (!parts.empty() && parts[0] == "tickets") {
+            if (parts.size() == 1) {
+                if (m == "POST") return createTicket(request);
+                if (m == "GET") return queryTickets(request);
+                return error(405, "Use GET or POST");
+            }
+            if (parts.size() == 2) {
+                if (m == "GET") return getTicket(parts[1]);
+                if (m == "PATCH") return updateTicket(parts[1], request);
+                return error(405, "Use GET or PATCH");
+            }
+        }
+        if (parts.size() == 1 && parts[0] == "onboarding") {
+            return m == "POST" ? onboard(request) : error(405, "Use POST");
+        }
+        return error(404, "No such resource: " + request.path);
+    }
+};
+
+} // namespace infrastructure
+
+#endif
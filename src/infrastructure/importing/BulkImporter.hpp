@@ -0,0 +1,449 @@
+#ifndef BULK_IMPORTER_HPP
+#define BULK_IMPORTER_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../../domain/factory/EnumNames.hpp"
+#include "../../domain/models/Customer.hpp"
+#include "../../domain/models/Ticket.hpp"
+#include "../../domain/services/CustomerService.hpp"
+#include "../../domain/services/TicketService.hpp"
+#include "MappedFile.hpp"
+#include "RecordReaders.hpp"
+#include "TextScan.hpp"
+
+namespace infrastructure {
+
+enum class ImportFormat {
+    AUTO,    // JSONL for .jsonl / .ndjson / .json files, CSV otherwise
+    CSV,     // header row with column names, then one record per row
+    JSONL    // one flat JSON object per line
+};
+
+struct ImportOptions {
+    ImportFormat format = ImportFormat::AUTO;
+    unsigned threads = 0;                 // parser threads; 0 = one per hardware thread
+    std::string errorFile;                // rejected rows; empty = "<input>.rejected"
+    bool requireKnownCustomers = true;    // tickets: reject rows whose customer does not exist
+};
+
+struct ImportReport {
+    std::string error;          // set if the file could not be imported at all
+    std::size_t bytes = 0;
+    std::size_t rows = 0;
+    std::size_t imported = 0;
+    std::size_t rejected = 0;
+    std::string errorFile;      // written when rows were rejected
+    unsigned threads = 0;
+    double parseSeconds = 0;
+    double loadSeconds = 0;
+    double seconds = 0;
+
+    bool ok() const { return error.empty(); }
+
+    double rowsPerSecond() const {
+        return seconds > 0 ? static_cast<double>(rows) / seconds : 0;
+    }
+};
+
+// Loads customers and tickets exported from another system.
+//
+//   customers: id, name, email, phone, type
+//   tickets:   id, customerId, description, status, priority, category,
+//              assignedTo, createdAt (seconds since the epoch), tags ('|'-separated)
+//
+// Enum columns take the TicketFactory / CustomerFactory names in any case
+// ("In Progress", "IN_PROGRESS", "in progress") or their numeric values.
+//
+// The file is memory-mapped and cut into one chunk per thread at record
+// boundaries; for CSV the boundaries come from a parallel count of quote
+// characters, so quoted fields may span lines. Threads parse their chunks
+// into objects, which are then bulk-loaded through
+// CustomerService::importCustomers() / TicketService::importTickets() in
+// file order. Rows that fail to parse or validate are written, with the
+// reason, to the error file.
+class BulkImporter {
+private:
+    std::shared_ptr<domain::CustomerService> customerService;
+    std::shared_ptr<domain::TicketService> ticketService;
+
+    using Clock = std::chrono::steady_clock;
+
+    // One row's values by schema column
+    struct Record {
+        std::vector<std::string> values;
+        std::vector<bool> present;
+
+        void reset(std::size_t columns) {
+            values.resize(columns);
+            present.assign(columns, false);
+        }
+        void set(std::size_t column, std::string value) {
+            values[column] = std::move(value);
+            present[column] = true;
+        }
+        bool has(std::size_t column) const { return present[column] && !values[column].empty(); }
+        const std::string& operator[](std::size_t column) const { return values[column]; }
+    };
+
+    struct Rejected {
+        std::size_t row;        // within its chunk
+        std::string reason;
+        std::string text;
+    };
+
+    template <typename Item>
+    struct ChunkResult {
+        std::vector<Item> items;
+        std::vector<Rejected> rejected;
+        std::size_t rows = 0;
+    };
+
+    // -------- per-entity schemas --------
+
+    struct CustomerRows {
+        using Item = domain::Customer;
+        enum Column { ID, NAME, EMAIL, PHONE, TYPE };
+
+        static const std::vector<std::string>& columns() {
+            static const std::vector<std::string> names = {"id", "name", "email", "phone", "type"};
+            return names;
+        }
+        static const std::vector<std::size_t>& required() {
+            static const std::vector<std::size_t> cols = {ID, NAME, EMAIL};
+            return cols;
+        }
+
+        bool build(const Record& r, std::vector<Item>& out, std::string& reason) const {
+            if (r[EMAIL].find('@') == std::string::npos) {
+                reason = "Invalid email: " + r[EMAIL];
+                return false;
+            }
+            domain::CustomerType type = domain::CustomerType::REGULAR;
+            if (r.has(TYPE) && !domain::parseCustomerType(r[TYPE], type)) {
+                reason = "Unknown customer type: " + r[TYPE];
+                return false;
+            }
+            out.emplace_back(r[ID], r[NAME], r[EMAIL], r[PHONE], type);
+            return true;
+        }
+    };
+
+    struct TicketRows {
+        using Item = std::shared_ptr<domain::Ticket>;
+        enum Column { ID, CUSTOMER_ID, DESCRIPTION, STATUS, PRIORITY, CATEGORY, ASSIGNED_TO, CREATED_AT, TAGS };
+
+        domain::CustomerService* customers;   // null: customer ids are not checked
+        std::time_t now;
+
+        static const std::vector<std::string>& columns() {
+            static const std::vector<std::string> names = {
+                "id", "customerId", "description", "status", "priority",
+                "category", "assignedTo", "createdAt", "tags"};
+            return names;
+        }
+        static const std::vector<std::size_t>& required() {
+            static const std::vector<std::size_t> cols = {ID, CUSTOMER_ID, DESCRIPTION, PRIORITY, CATEGORY};
+            return cols;
+        }
+
+        bool build(const Record& r, std::vector<Item>& out, std::string& reason) const {
+            domain::TicketStatus status = domain::TicketStatus::OPEN;
+            domain::Priority priority;
+            domain::TicketCategory category;
+            if (r.has(STATUS) && !domain::parseTicketStatus(r[STATUS], status)) {
+                reason = "Unknown status: " + r[STATUS];
+                return false;
+            }
+            if (!domain::parsePriority(r[PRIORITY], priority)) {
+                reason = "Unknown priority: " + r[PRIORITY];
+                return false;
+            }
+            if (!domain::parseTicketCategory(r[CATEGORY], category)) {
+                reason = "Unknown category: " + r[CATEGORY];
+                return false;
+            }
+
+            std::time_t createdAt = now;
+            if (r.has(CREATED_AT)) {
+                char* endp = nullptr;
+                const long long t = std::strtoll(r[CREATED_AT].c_str(), &endp, 10);
+                if (*endp != '\0' || t < 0) {
+                    reason = "Bad createdAt: " + r[CREATED_AT];
+                    return false;
+                }
+                createdAt = static_cast<std::time_t>(t);
+            }
+
+            if (customers && !customers->getCustomer(r[CUSTOMER_ID])) {
+                reason = "Unknown customer: " + r[CUSTOMER_ID];
+                return false;
+            }
+
+            auto ticket = std::make_shared<domain::Ticket>(r[ID], r[CUSTOMER_ID], r[DESCRIPTION],
+                                                           priority, category, status);
+            if (r.has(ASSIGNED_TO)) ticket->setAssignedTo(r[ASSIGNED_TO]);
+            ticket->setCreatedAt(createdAt);
+            if (r.has(TAGS)) {
+                const std::string& tags = r[TAGS];
+                std::size_t begin = 0;
+                while (begin <= tags.size()) {
+                    std::size_t end = tags.find('|', begin);
+                    if (end == std::string::npos) end = tags.size();
+                    if (end > begin) ticket->addTag(tags.substr(begin, end - begin));
+                    begin = end + 1;
+                }
+            }
+            out.push_back(std::move(ticket));
+            return true;
+        }
+    };
+
+    static ImportFormat formatFor(const std::string& path, ImportFormat format) {
+        if (format != ImportFormat::AUTO) return format;
+        const auto dot = path.rfind('.');
+        std::string ext = dot == std::string::npos ? "" : path.substr(dot + 1);
+        for (auto& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return (ext == "jsonl" || ext == "ndjson" || ext == "json") ? ImportFormat::JSONL : ImportFormat::CSV;
+    }
+
+    template <typename Fn>
+    static void parallelFor(std::size_t n, Fn&& fn) {
+        std::vector<std::thread> threads;
+        for (std::size_t k = 1; k < n; ++k) threads.emplace_back(fn, k);
+        if (n > 0) fn(0);
+        for (auto& t : threads) t.join();
+    }
+
+    // Chunk starts at record boundaries: starts[k]..starts[k+1] is chunk k
+    static std::vector<const char*> split(const char* begin, const char* end, std::size_t chunks, bool csv) {
+        std::vector<const char*> raw(chunks + 1);
+        for (std::size_t k = 0; k <= chunks; ++k)
+            raw[k] = begin + static_cast<std::size_t>(end - begin) * k / chunks;
+
+        // Whether each raw offset falls inside a quoted CSV field: the parity
+        // of the quotes before it, counted per chunk in parallel
+        std::vector<bool> inQuotes(chunks, false);
+        if (csv) {
+            std::vector<std::size_t> quotes(chunks);
+            parallelFor(chunks, [&](std::size_t k) { quotes[k] = countByte(raw[k], raw[k + 1], '"'); });
+            std::size_t total = 0;
+            for (std::size_t k = 0; k < chunks; ++k) {
+                inQuotes[k] = total % 2 == 1;
+                total += quotes[k];
+            }
+        }
+
+        std::vector<const char*> starts(chunks + 1);
+        starts[0] = begin;
+        starts[chunks] = end;
+        for (std::size_t k = 1; k < chunks; ++k) {
+            const char* p = raw[k];
+            bool quoted = inQuotes[k];
+            for (;;) {
+                p = csv ? findFirstOf(p, end, '"', '\n', '\n') : findByte(p, end, '\n');
+                if (p == end) break;
+                if (*p == '"') {
+                    quoted = !quoted;
+                    ++p;
+                    continue;
+                }
+                ++p;
+                if (!quoted) break;
+            }
+            starts[k] = std::max(p, starts[k - 1]);
+        }
+        return starts;
+    }
+
+    static bool blank(const char* p, const char* end) {
+        for (; p < end; ++p) {
+            if (*p != ' ' && *p != '\t' && *p != '\r') return false;
+        }
+        return true;
+    }
+
+    static std::string trimmedText(const char* p, const char* end) {
+        while (end > p && (end[-1] == '\n' || end[-1] == '\r')) --end;
+        return std::string(p, end);
+    }
+
+    template <typename Rows>
+    static void buildRow(const Rows& rows, const Record& record, const char* start, const char* end,
+                         ChunkResult<typename Rows::Item>& result) {
+        const std::size_t row = result.rows++;
+        std::string reason;
+        for (std::size_t column : Rows::required()) {
+            if (!record.has(column)) {
+                result.rejected.push_back({row, "Missing " + Rows::columns()[column], trimmedText(start, end)});
+                return;
+            }
+        }
+        if (!rows.build(record, result.items, reason))
+            result.rejected.push_back({row, std::move(reason), trimmedText(start, end)});
+    }
+
+    template <typename Rows>
+    static void parseCsv(const Rows& rows, const std::vector<int>& columnOf, const char* p, const char* end,
+                         ChunkResult<typename Rows::Item>& result) {
+        std::vector<std::string> fields;
+        Record record;
+        bool malformed = false;
+        while (p < end) {
+            const char* start = p;
+            p = readCsvRecord(p, end, fields, malformed);
+            if (fields.size() == 1 && blank(fields[0].data(), fields[0].data() + fields[0].size())) continue;
+
+            if (malformed || fields.size() != columnOf.size()) {
+                const std::size_t row = result.rows++;
+                result.rejected.push_back({row, malformed ? std::string("Malformed quoted field")
+                                                          : "Expected " + std::to_string(columnOf.size()) +
+                                                                " fields, found " + std::to_string(fields.size()),
+                                           trimmedText(start, p)});
+                continue;
+            }
+            record.reset(Rows::columns().size());
+            for (std::size_t i = 0; i < fields.size(); ++i) {
+                if (columnOf[i] >= 0) record.set(static_cast<std::size_t>(columnOf[i]), std::move(fields[i]));
+            }
+            buildRow(rows, record, start, p, result);
+        }
+    }
+
+    template <typename Rows>
+    static void parseJsonl(const Rows& rows, const char* p, const char* end,
+                           ChunkResult<typename Rows::Item>& result) {
+        const auto& names = Rows::columns();
+        std::vector<std::pair<std::string, std::string>> members;
+        std::string error;
+        Record record;
+        while (p < end) {
+            const char* start = p;
+            const char* lineEnd = findByte(p, end, '\n');
+            p = lineEnd < end ? lineEnd + 1 : end;
+            if (blank(start, lineEnd)) continue;
+
+            if (!readJsonObject(start, lineEnd, members, error)) {
+                result.rejected.push_back({result.rows++, error, trimmedText(start, lineEnd)});
+                continue;
+            }
+            record.reset(names.size());
+            for (auto& [key, value] : members) {
+                auto it = std::find(names.begin(), names.end(), key);
+                if (it != names.end()) record.set(static_cast<std::size_t>(it - names.begin()), std::move(value));
+            }
+            buildRow(rows, record, start, lineEnd, result);
+        }
+    }
+
+    template <typename Rows, typename Load>
+    ImportReport run(const std::string& path, const ImportOptions& options, const Rows& rows, Load&& load) {
+        using Item = typename Rows::Item;
+        const auto started = Clock::now();
+        ImportReport report;
+
+        MappedFile file(path);
+        if (!file.isOpen()) {
+            report.error = file.error();
+            return report;
+        }
+        report.bytes = file.size();
+
+        const char* begin = file.data();
+        const char* end = begin + file.size();
+        if (end - begin >= 3 && std::equal(begin, begin + 3, "\xEF\xBB\xBF")) begin += 3;   // UTF-8 BOM
+
+        const bool csv = formatFor(path, options.format) == ImportFormat::CSV;
+
+        // CSV: the header names the columns; unknown ones are ignored
+        std::vector<int> columnOf;
+        if (csv) {
+            std::vector<std::string> header;
+            bool malformed = false;
+            begin = readCsvRecord(begin, end, header, malformed);
+            const auto& names = Rows::columns();
+            for (const auto& h : header) {
+                auto it = std::find(names.begin(), names.end(), h);
+                columnOf.push_back(it == names.end() ? -1 : static_cast<int>(it - names.begin()));
+            }
+            for (std::size_t column : Rows::required()) {
+                if (std::find(columnOf.begin(), columnOf.end(), static_cast<int>(column)) == columnOf.end()) {
+                    report.error = "Missing column in header: " + names[column];
+                    return report;
+                }
+            }
+        }
+
+        unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+        const std::size_t minChunk = 256 * 1024;
+        threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(
+            std::max(1u, threads), static_cast<std::size_t>(end - begin) / minChunk + 1)));
+        report.threads = threads;
+
+        const auto starts = split(begin, end, threads, csv);
+        std::vector<ChunkResult<Item>> chunks(threads);
+        parallelFor(threads, [&](std::size_t k) {
+            if (csv) parseCsv(rows, columnOf, starts[k], starts[k + 1], chunks[k]);
+            else parseJsonl(rows, starts[k], starts[k + 1], chunks[k]);
+        });
+        report.parseSeconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+        const auto loadStart = Clock::now();
+        std::ofstream errors;
+        std::size_t rowsBefore = 0;
+        for (auto& chunk : chunks) {
+            report.rows += chunk.rows;
+            report.imported += chunk.items.size();
+            report.rejected += chunk.rejected.size();
+            if (!chunk.items.empty()) load(std::move(chunk.items));
+
+            if (!chunk.rejected.empty()) {
+                if (!errors.is_open()) {
+                    report.errorFile = options.errorFile.empty() ? path + ".rejected" : options.errorFile;
+                    errors.open(report.errorFile, std::ios::trunc);
+                }
+                for (const auto& r : chunk.rejected)
+                    errors << "row " << (rowsBefore + r.row + 1) << ": " << r.reason << " | " << r.text << '\n';
+            }
+            rowsBefore += chunk.rows;
+            chunk = ChunkResult<Item>();
+        }
+        report.loadSeconds = std::chrono::duration<double>(Clock::now() - loadStart).count();
+        report.seconds = std::chrono::duration<double>(Clock::now() - started).count();
+        return report;
+    }
+
+public:
+    BulkImporter(std::shared_ptr<domain::CustomerService> customers,
+                 std::shared_ptr<domain::TicketService> tickets)
+        : customerService(std::move(customers)), ticketService(std::move(tickets)) {}
+
+    ImportReport importCustomers(const std::string& path, const ImportOptions& options = {}) {
+        return run(path, options, CustomerRows{}, [&](std::vector<domain::Customer> batch) {
+            customerService->importCustomers(batch);
+        });
+    }
+
+    // Import customers first: with requireKnownCustomers, tickets of unknown
+    // customers are rejected
+    ImportReport importTickets(const std::string& path, const ImportOptions& options = {}) {
+        TicketRows rows{options.requireKnownCustomers ? customerService.get() : nullptr, std::time(nullptr)};
+        return run(path, options, rows, [&](std::vector<std::shared_ptr<domain::Ticket>> batch) {
+            ticketService->importTickets(std::move(batch));
+        });
+    }
+};
+
+} // namespace infrastructure
+
+#endif
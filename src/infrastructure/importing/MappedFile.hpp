@@ -0,0 +1,92 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace infrastructure {
+
+// Read-only view of a whole file. On POSIX systems the file is mapped, so
+// pages are read on demand and shared by every parser thread without a
+// copy; elsewhere it is read into memory.
+class MappedFile {
+private:
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+    std::string failure;
+
+#if !defined(_WIN32)
+    void* mapping = nullptr;
+#else
+    std::string buffer;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path) {
+#if !defined(_WIN32)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            failure = "Cannot open " + path + ": " + std::strerror(errno);
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            failure = "Cannot stat " + path + ": " + std::strerror(errno);
+            ::close(fd);
+            return;
+        }
+        length = static_cast<std::size_t>(st.st_size);
+        if (length > 0) {
+            mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                length = 0;
+                failure = "Cannot map " + path + ": " + std::strerror(errno);
+            } else {
+                ::madvise(mapping, length, MADV_SEQUENTIAL);
+                bytes = static_cast<const char*>(mapping);
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            failure = "Cannot open " + path;
+            return;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        bytes = buffer.data();
+        length = buffer.size();
+#endif
+    }
+
+    ~MappedFile() {
+#if !defined(_WIN32)
+        if (mapping) ::munmap(mapping, length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return failure.empty(); }
+    const std::string& error() const { return failure; }
+
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+};
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef RECORD_READERS_HPP
+#define RECORD_READERS_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "TextScan.hpp"
+
+namespace infrastructure {
+
+// Reads one CSV record (RFC 4180) starting at p into fields and returns the
+// position after its line break. Quoted fields may contain commas, line
+// breaks and doubled quotes; a quote inside an unquoted field is kept as
+// text. Sets malformed for an unterminated quoted field or text after a
+// closing quote.
+inline const char* readCsvRecord(const char* p, const char* end,
+                                 std::vector<std::string>& fields, bool& malformed) {
+    fields.clear();
+    malformed = false;
+    std::string field;
+
+    for (;;) {
+        field.clear();
+        if (p < end && *p == '"') {
+            ++p;
+            for (;;) {
+                const char* q = findByte(p, end, '"');
+                field.append(p, q);
+                if (q == end) {
+                    malformed = true;
+                    p = end;
+                    break;
+                }
+                if (q + 1 < end && q[1] == '"') {
+                    field.push_back('"');
+                    p = q + 2;
+                    continue;
+                }
+                p = q + 1;
+                break;
+            }
+            if (p < end && *p != ',' && *p != '\n' && *p != '\r') {
+                malformed = true;
+                p = findFirstOf(p, end, ',', '\n', '\n');
+            }
+            if (p < end && *p == '\r') ++p;
+        } else {
+            const char* q = findFirstOf(p, end, ',', '\n', '"');
+            while (q < end && *q == '"') q = findFirstOf(q + 1, end, ',', '\n', '"');
+            field.append(p, q);
+            p = q;
+            if (!field.empty() && field.back() == '\r') field.pop_back();
+        }
+
+        fields.push_back(field);
+        if (p < end && *p == ',') {
+            ++p;
+            continue;
+        }
+        if (p < end && *p == '\n') ++p;
+        return p;
+    }
+}
+
+namespace json_detail {
+
+inline void skipSpace(const char*& p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+}
+
+inline void appendUtf8(std::string& out, std::uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+inline bool readHex4(const char*& p, const char* end, std::uint32_t& out) {
+    if (end - p < 4) return false;
+    out = 0;
+    for (int i = 0; i < 4; ++i, ++p) {
+        const char c = *p;
+        out <<= 4;
+        if (c >= '0' && c <= '9') out |= static_cast<std::uint32_t>(c - '0');
+        else if (c >= 'a' && c <= 'f') out |= static_cast<std::uint32_t>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') out |= static_cast<std::uint32_t>(c - 'A' + 10);
+        else return false;
+    }
+    return true;
+}
+
+// p is on the opening quote
+inline bool readString(const char*& p, const char* end, std::string& out) {
+    ++p;
+    out.clear();
+    for (;;) {
+        const char* q = findFirstOf(p, end, '"', '\\', '\n');
+        out.append(p, q);
+        if (q == end || *q == '\n') return false;
+        p = q + 1;
+        if (*q == '"') return true;
+
+        if (p == end) return false;
+        const char e = *p++;
+        switch (e) {
+            case '"':  out.push_back('"'); break;
+            case '\\': out.push_back('\\'); break;
+            case '/':  out.push_back('/'); break;
+            case 'b':  out.push_back('\b'); break;
+            case 'f':  out.push_back('\f'); break;
+            case 'n':  out.push_back('\n'); break;
+            case 'r':  out.push_back('\r'); break;
+            case 't':  out.push_back('\t'); break;
+            case 'u': {
+                std::uint32_t cp;
+                if (!readHex4(p, end, cp)) return false;
+                if (cp >= 0xD800 && cp < 0xDC00) {
+                    std::uint32_t low;
+                    if (end - p < 6 || p[0] != '\\' || p[1] != 'u') return false;
+                    p += 2;
+                    if (!readHex4(p, end, low) || low < 0xDC00 || low >= 0xE000) return false;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, cp);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+}
+
+} // namespace json_detail
+
+// Parses one flat JSON object, {"key": value, ...}, as found on a JSONL
+// line. Values may be strings, numbers, booleans (kept as their text), null
+// (member skipped) or arrays of strings (joined with '|'). Returns false
+// with a reason for anything else, including nested objects.
+inline bool readJsonObject(const char* p, const char* end,
+                           std::vector<std::pair<std::string, std::string>>& members,
+                           std::string& error) {
+    using namespace json_detail;
+    members.clear();
+
+    skipSpace(p, end);
+    if (p == end || *p != '{') {
+        error = "Expected a JSON object";
+        return false;
+    }
+    ++p;
+    skipSpace(p, end);
+    if (p < end && *p == '}') return true;
+
+    std::string key, value, item;
+    for (;;) {
+        skipSpace(p, end);
+        if (p == end || *p != '"' || !readString(p, end, key)) {
+            error = "Expected a member name";
+            return false;
+        }
+        skipSpace(p, end);
+        if (p == end || *p != ':') {
+            error = "Expected ':' after \"" + key + "\"";
+            return false;
+        }
+        ++p;
+        skipSpace(p, end);
+        if (p == end) {
+            error = "Missing value for \"" + key + "\"";
+            return false;
+        }
+
+        bool isNull = false;
+        if (*p == '"') {
+            if (!readString(p, end, value)) {
+                error = "Bad string for \"" + key + "\"";
+                return false;
+            }
+        } else if (*p == '[') {
+            ++p;
+            value.clear();
+            skipSpace(p, end);
+            bool first = true;
+            while (p < end && *p != ']') {
+                if (!first) {
+                    if (*p != ',') break;
+                    ++p;
+                    skipSpace(p, end);
+                }
+                if (p == end || *p != '"' || !readString(p, end, item)) {
+                    error = "\"" + key + "\" must be an array of strings";
+                    return false;
+                }
+                if (!first) value.push_back('|');
+                value += item;
+                first = false;
+                skipSpace(p, end);
+            }
+            if (p == end || *p != ']') {
+                error = "Unterminated array for \"" + key + "\"";
+                return false;
+            }
+            ++p;
+        } else if (*p == '{') {
+            error = "Nested object for \"" + key + "\"";
+            return false;
+        } else {
+            const char* start = p;
+            while (p < end && *p != ',' && *p != '}' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') ++p;
+            value.assign(start, p);
+            if (value == "null") isNull = true;
+            else if (value.empty()) {
+                error = "Missing value for \"" + key + "\"";
+                return false;
+            }
+        }
+        if (!isNull) members.emplace_back(key, value);
+
+        skipSpace(p, end);
+        if (p < end && *p == ',') {
+            ++p;
+            continue;
+        }
+        if (p < end && *p == '}') {
+            ++p;
+            skipSpace(p, end);
+            if (p != end) {
+                error = "Text after the object";
+                return false;
+            }
+            return true;
+        }
+        error = "Expected ',' or '}'";
+        return false;
+    }
+}
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef TEXT_SCAN_HPP
+#define TEXT_SCAN_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace infrastructure {
+
+// Byte scans used by the importers. With SSE2 they compare 16 bytes per
+// step; the scalar loops handle the tail and other targets.
+
+inline std::size_t countByte(const char* p, const char* end, char c) {
+    std::size_t n = 0;
+#if defined(__SSE2__)
+    const __m128i target = _mm_set1_epi8(c);
+    for (; end - p >= 16; p += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        n += static_cast<std::size_t>(__builtin_popcount(
+            static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)))));
+    }
+#endif
+    for (; p < end; ++p) n += *p == c;
+    return n;
+}
+
+// First of a, b or c in [p, end); end if there is none
+inline const char* findFirstOf(const char* p, const char* end, char a, char b, char c) {
+#if defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+    for (; end - p >= 16; p += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, va), _mm_cmpeq_epi8(block, vb)),
+                                          _mm_cmpeq_epi8(block, vc));
+        const int mask = _mm_movemask_epi8(hits);
+        if (mask) return p + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == a || *p == b || *p == c) return p;
+    }
+    return end;
+}
+
+inline const char* findByte(const char* p, const char* end, char c) {
+    const void* hit = p < end ? std::memchr(p, c, static_cast<std::size_t>(end - p)) : nullptr;
+    return hit ? static_cast<const char*>(hit) : end;
+}
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,416 @@
+#ifndef FILE_LOGGER_HPP
+#define FILE_LOGGER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "../../domain/interfaces/ILogger.hpp"
+#include "TimestampCache.hpp"
+
+namespace infrastructure {
+
+struct FileLoggerOptions {
+    std::string path = "support.log";
+
+    // Records are accumulated into buffers of this size before being written.
+    std::size_t bufferSize = 1 << 20;
+    std::size_t maxPendingBuffers = 16;
+    std::chrono::milliseconds flushInterval{200};
+
+    // Rotation: whichever limit is hit first. Zero disables the limit.
+    std::size_t maxFileBytes = 64u << 20;
+    std::chrono::seconds maxFileAge{24 * 3600};
+    // Rotated files ("<path>.<timestamp>", plus anything the compression
+    // hook appends) beyond this many are deleted, oldest first.
+    std::size_t maxRotatedFiles = 8;
+
+    // Invoked on a background thread with the path of every rotated file.
+    std::function<void(const std::string&)> compressRotated;
+};
+
+// Buffered file sink: log() only copies the record into an in-memory buffer;
+// a writer thread submits full buffers with a single writev() and handles
+// rotation, and rotated files are compressed on a separate thread.
+class FileLogger : public domain::ILogger {
+private:
+    static constexpr std::size_t BufferAlignment = 4096;
+    static constexpr std::size_t MaxIovecs = 1024;
+
+    struct Buffer {
+        char* data = nullptr;
+        std::size_t capacity = 0;
+        std::size_t size = 0;
+
+        explicit Buffer(std::size_t cap)
+            : data(static_cast<char*>(::operator new(cap, std::align_val_t{BufferAlignment})))
+            , capacity(cap) {}
+
+        ~Buffer() {
+            ::operator delete(data, std::align_val_t{BufferAlignment});
+        }
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        std::size_t available() const { return capacity - size; }
+    };
+
+    FileLoggerOptions options;
+
+    std::mutex mtx;
+    std::condition_variable writerWake;
+    std::condition_variable producerWake;
+    std::unique_ptr<Buffer> active;
+    std::vector<std::unique_ptr<Buffer>> pending;
+    std::vector<std::unique_ptr<Buffer>> spare;
+    bool stopping = false;
+
+    std::mutex compressMtx;
+    std::condition_variable compressWake;
+    std::deque<std::string> toCompress;
+    bool compressStopping = false;
+
+    // Owned by the writer thread
+#if defined(_WIN32)
+    std::FILE* file = nullptr;
+#else
+    int fd = -1;
+#endif
+    std::size_t fileBytes = 0;
+    std::chrono::system_clock::time_point fileOpenedAt;
+
+    std::thread writer;
+    std::thread compressor;
+
+public:
+    explicit FileLogger(FileLoggerOptions opts)
+        : options(std::move(opts))
+        , active(std::make_unique<Buffer>(options.bufferSize))
+    {
+        openFile();
+        writer = std::thread([this] { writerLoop(); });
+        compressor = std::thread([this] { compressorLoop(); });
+    }
+
+    explicit FileLogger(const std::string& path)
+        : FileLogger(optionsForPath(path)) {}
+
+    FileLogger(const FileLogger&) = delete;
+    FileLogger& operator=(const FileLogger&) = delete;
+
+    ~FileLogger() override {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        writerWake.notify_one();
+        writer.join();
+        closeFile();
+
+        {
+            std::lock_guard<std::mutex> lock(compressMtx);
+            compressStopping = true;
+        }
+        compressWake.notify_one();
+        compressor.join();
+    }
+
+    void log(const std::string& message) override {
+        const std::size_t recordSize = TimestampCache::Length + message.size() + 1;
+        const char* stamp = TimestampCache::current();
+
+        std::unique_lock<std::mutex> lock(mtx);
+        if (active->available() < recordSize) {
+            producerWake.wait(lock, [this] {
+                return pending.size() < options.maxPendingBuffers || stopping;
+            });
+            if (active->size > 0) {
+                pending.push_back(std::move(active));
+                active = takeBuffer(recordSize);
+                writerWake.notify_one();
+            } else if (active->capacity < recordSize) {
+                active = std::make_unique<Buffer>(recordSize);
+            }
+        }
+
+        char* out = active->data + active->size;
+        std::memcpy(out, stamp, TimestampCache::Length);
+        std::memcpy(out + TimestampCache::Length, message.data(), message.size());
+        out[recordSize - 1] = '\n';
+        active->size += recordSize;
+    }
+
+    // Hands the current buffer to the writer without waiting for it to fill.
+    void flush() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (active->size > 0) {
+            pending.push_back(std::move(active));
+            active = takeBuffer(0);
+        }
+        writerWake.notify_one();
+    }
+
+private:
+    static FileLoggerOptions optionsForPath(const std::string& path) {
+        FileLoggerOptions opts;
+        opts.path = path;
+        return opts;
+    }
+
+    // Caller holds mtx
+    std::unique_ptr<Buffer> takeBuffer(std::size_t minSize) {
+        if (minSize <= options.bufferSize && !spare.empty()) {
+            auto b = std::move(spare.back());
+            spare.pop_back();
+            b->size = 0;
+            return b;
+        }
+        return std::make_unique<Buffer>(std::max(minSize, options.bufferSize));
+    }
+
+    void writerLoop() {
+        std::vector<std::unique_ptr<Buffer>> batch;
+
+        std::unique_lock<std::mutex> lock(mtx);
+        for (;;) {
+            writerWake.wait_for(lock, options.flushInterval, [this] {
+                return !pending.empty() || stopping;
+            });
+
+            // Interval elapsed: also drain the partially filled buffer.
+            if (active->size > 0 && (pending.empty() || stopping)) {
+                pending.push_back(std::move(active));
+                active = takeBuffer(0);
+            }
+
+            batch.swap(pending);
+            const bool exiting = stopping;
+            producerWake.notify_all();
+
+            if (!batch.empty()) {
+                lock.unlock();
+                writeBatch(batch);
+                lock.lock();
+
+                for (auto& b : batch) {
+                    if (b->capacity == options.bufferSize && spare.size() < options.maxPendingBuffers)
+                        spare.push_back(std::move(b));
+                }
+                batch.clear();
+            }
+
+            if (exiting && pending.empty() && active->size == 0) break;
+        }
+    }
+
+    void writeBatch(const std::vector<std::unique_ptr<Buffer>>& batch) {
+        std::size_t total = 0;
+        for (const auto& b : batch) total += b->size;
+
+        if (shouldRotate(total)) rotate();
+
+#if defined(_WIN32)
+        if (!file) return;
+        for (const auto& b : batch)
+            std::fwrite(b->data, 1, b->size, file);
+        std::fflush(file);
+#else
+        if (fd < 0) return;
+
+        std::vector<iovec> iov;
+        iov.reserve(batch.size());
+        for (const auto& b : batch)
+            iov.push_back(iovec{b->data, b->size});
+
+        std::size_t first = 0;
+        while (first < iov.size()) {
+            const int count = static_cast<int>(std::min(iov.size() - first, MaxIovecs));
+            ssize_t written = ::writev(fd, iov.data() + first, count);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+
+            // Skip fully written segments and trim a partially written one.
+            auto remaining = static_cast<std::size_t>(written);
+            while (first < iov.size() && remaining >= iov[first].iov_len) {
+                remaining -= iov[first].iov_len;
+                ++first;
+            }
+            if (first < iov.size() && remaining > 0) {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + remaining;
+                iov[first].iov_len -= remaining;
+            }
+        }
+#endif
+        fileBytes += total;
+    }
+
+    bool shouldRotate(std::size_t incoming) const {
+        if (fileBytes == 0) return false;
+        if (options.maxFileBytes > 0 && fileBytes + incoming > options.maxFileBytes)
+            return true;
+        if (options.maxFileAge.count() > 0 &&
+            std::chrono::system_clock::now() - fileOpenedAt >= options.maxFileAge)
+            return true;
+        return false;
+    }
+
+    void rotate() {
+        closeFile();
+
+        std::string stamp = TimestampCache::current();
+        std::string suffix;
+        for (char c : stamp) {
+            if (c >= '0' && c <= '9') suffix.push_back(c);
+        }
+        // Checked against every rotation on disk, so a name the hook has
+        // since renamed (e.g. to .gz) is not used again
+        std::string rotated = options.path + "." + suffix;
+        bool taken = false;
+        unsigned long next = 1;
+        for (const auto& [key, files] : rotationsOnDisk()) {
+            if (key.first != suffix) continue;
+            taken = true;
+            next = std::max(next, key.second + 1);
+        }
+        if (taken) rotated += "-" + std::to_string(next);
+
+        std::rename(options.path.c_str(), rotated.c_str());
+
+        // With a compression hook, pruning waits until it is done with the file
+        if (options.compressRotated) {
+            {
+                std::lock_guard<std::mutex> lock(compressMtx);
+                toCompress.push_back(rotated);
+            }
+            compressWake.notify_one();
+        } else {
+            pruneRotated();
+        }
+
+        openFile();
+    }
+
+    // (timestamp, -n) -> files of that rotation, i.e. "<log>.<timestamp>[-n]"
+    // and whatever the compression hook renamed them to; timestamps are
+    // fixed-width digits
+    using Rotations = std::map<std::pair<std::string, unsigned long>, std::vector<std::filesystem::path>>;
+
+    Rotations rotationsOnDisk() const {
+        namespace fs = std::filesystem;
+        const fs::path base(options.path);
+        const std::string prefix = base.filename().string() + ".";
+        const fs::path directory = base.has_parent_path() ? base.parent_path() : fs::path(".");
+
+        Rotations rotations;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(directory, ec)) {
+            const std::string name = entry.path().filename().string();
+            if (name.compare(0, prefix.size(), prefix) != 0) continue;
+            std::size_t end = prefix.size();
+            while (end < name.size() && name[end] >= '0' && name[end] <= '9') ++end;
+            if (end == prefix.size()) continue;
+            unsigned long n = 0;
+            if (end < name.size() && name[end] == '-') n = std::strtoul(name.c_str() + end + 1, nullptr, 10);
+            rotations[{name.substr(prefix.size(), end - prefix.size()), n}].push_back(entry.path());
+        }
+        return rotations;
+    }
+
+    // Deletes the oldest rotated files on disk, including those of earlier
+    // runs, but none still queued for compression. Without a hook: writer
+    // thread; with one: compressor thread, holding compressMtx.
+    void pruneRotated() {
+        namespace fs = std::filesystem;
+        if (options.maxRotatedFiles == 0) return;
+
+        auto rotations = rotationsOnDisk();
+        std::error_code ec;
+        while (rotations.size() > options.maxRotatedFiles) {
+            const auto& files = rotations.begin()->second;
+            for (const auto& queued : toCompress) {
+                for (const auto& f : files) {
+                    if (fs::path(queued).filename() == f.filename()) return;
+                }
+            }
+            for (const auto& f : files) fs::remove(f, ec);
+            rotations.erase(rotations.begin());
+        }
+    }
+
+    void compressorLoop() {
+        std::unique_lock<std::mutex> lock(compressMtx);
+        for (;;) {
+            compressWake.wait(lock, [this] { return !toCompress.empty() || compressStopping; });
+            if (toCompress.empty()) break;
+
+            std::string path = std::move(toCompress.front());
+            toCompress.pop_front();
+
+            lock.unlock();
+            options.compressRotated(path);
+            lock.lock();
+            pruneRotated();
+        }
+    }
+
+    void openFile() {
+#if defined(_WIN32)
+        file = std::fopen(options.path.c_str(), "ab");
+        fileBytes = 0;
+        if (file) {
+            std::fseek(file, 0, SEEK_END);
+            fileBytes = static_cast<std::size_t>(std::ftell(file));
+        }
+#else
+        fd = ::open(options.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        fileBytes = 0;
+        struct stat st{};
+        if (fd >= 0 && ::fstat(fd, &st) == 0)
+            fileBytes = static_cast<std::size_t>(st.st_size);
+#endif
+        fileOpenedAt = std::chrono::system_clock::now();
+    }
+
+    void closeFile() {
+#if defined(_WIN32)
+        if (file) {
+            std::fclose(file);
+            file = nullptr;
+        }
+#else
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+#endif
+    }
+};
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef TIMESTAMP_CACHE_HPP
+#define TIMESTAMP_CACHE_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+namespace infrastructure {
+
+// Formats "[YYYY-MM-DD HH:MM:SS] " at most once per second per thread.
+class TimestampCache {
+public:
+    static constexpr std::size_t Length = 22;
+
+    static const char* current() {
+        thread_local std::time_t cachedSecond = -1;
+        thread_local char text[80] = {};
+
+        std::time_t t = std::chrono::system_clock::to_time_t(
+            std::chrono::system_clock::now());
+        if (t != cachedSecond) {
+            std::tm tmVal{};
+#if defined(_WIN32)
+            localtime_s(&tmVal, &t);
+#else
+            localtime_r(&t, &tmVal);
+#endif
+            std::snprintf(text, sizeof(text), "[%04d-%02d-%02d %02d:%02d:%02d] ",
+                          tmVal.tm_year + 1900, tmVal.tm_mon + 1, tmVal.tm_mday,
+                          tmVal.tm_hour, tmVal.tm_min, tmVal.tm_sec);
+            cachedSecond = t;
+        }
+        return text;
+    }
+};
+
+} // namespace infrastructure
+
+#endif
@@ -1,13 +1,10 @@
 #ifndef TIMESTAMP_LOGGER_HPP
 #define TIMESTAMP_LOGGER_HPP
 
-#include <chrono>
-#include <ctime>
-#include <iomanip>
-#include <sstream>
 #include <string>
 
 #include "LoggerDecorator.hpp"
+#include "TimestampCache.hpp"
 
 namespace infrastructure {
 
@@ -17,22 +14,13 @@ public:
         : LoggerDecorator(std::move(logger)) {}
 
     void log(const std::string& message) override {
-        auto now   = std::chrono::system_clock::now();
-        std::time_t t = std::chrono::system_clock::to_time_t(now);
-        std::tm tmVal{};
-
-#if defined(_WIN32)
-        localtime_s(&tmVal, &t);
-#else
-        localtime_r(&t, &tmVal);
-#endif
-
-        std::ostringstream oss;
-        oss << "[" << std::put_time(&tmVal, "%Y-%m-%d %H:%M:%S") << "] ";
+        if (!inner) return;
 
-        if (inner) {
-            inner->log(oss.str() + message);
-        }
+        std::string line;
+        line.reserve(TimestampCache::Length + message.size());
+        line.append(TimestampCache::current(), TimestampCache::Length);
+        line.append(message);
+        inner->log(line);
     }
 };
 
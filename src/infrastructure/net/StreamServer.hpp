@@ -0,0 +1,458 @@
+#ifndef STREAM_SERVER_HPP
+#define STREAM_SERVER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace infrastructure {
+
+struct StreamServerStats {
+    std::uint64_t connections = 0;   // accepted so far
+    std::uint64_t requests = 0;
+    std::uint64_t badRequests = 0;   // connections dropped for unparseable input
+};
+
+#if defined(__linux__)
+
+// Listening sockets for StreamServer::start(); -1 with `error` set on failure
+
+inline int listenTcp(const std::string& host, std::uint16_t port, std::uint16_t& boundPort, std::string& error) {
+    auto fail = [&](int fd, const std::string& what) {
+        error = what + ": " + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return -1;
+    };
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return fail(fd, "socket");
+    const int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (::inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+        errno = EINVAL;
+        return fail(fd, "Bad address " + host);
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        return fail(fd, "Cannot bind " + host + ":" + std::to_string(port));
+    if (::listen(fd, 1024) != 0) return fail(fd, "listen");
+    socklen_t len = sizeof(addr);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    boundPort = ntohs(addr.sin_port);
+    return fd;
+}
+
+// Replaces a stale socket file left by an earlier run
+inline int listenUnix(const std::string& path, std::string& error) {
+    auto fail = [&](int fd, const std::string& what) {
+        error = what + ": " + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return -1;
+    };
+    sockaddr_un addr{};
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        errno = ENAMETOOLONG;
+        return fail(-1, "Bad socket path " + path);
+    }
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return fail(fd, "socket");
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        return fail(fd, "Cannot bind " + path);
+    if (::listen(fd, 1024) != 0) return fail(fd, "listen");
+    return fd;
+}
+
+// Connection handling shared by the network front ends: one thread runs a
+// non-blocking epoll loop that accepts, reads and writes; requests run on a
+// pool of worker threads.
+//
+// What a request is comes from Protocol:
+//
+//   struct Protocol {
+//       struct State;   // per connection, used by the loop thread only
+//       struct Job;     // requests handed to a worker at once
+//
+//       // Loop thread. Moves complete requests from the front of `in` into
+//       // `state`; false if the input cannot be parsed (no further reads).
+//       bool parse(std::string& in, State& state) const;
+//       bool ready(const State&) const;      // requests waiting
+//       bool accepting(const State&) const;  // false stops reading, e.g. too much queued
+//       Job take(State& state) const;        // called when ready()
+//       // Called once nothing is queued or running: true to close the
+//       // connection after sending what it appended to `out`
+//       bool finish(State& state, std::string& out) const;
+//
+//       // Worker threads. Appends the responses to `out`, sets `close` to
+//       // end the connection after them; returns the number of requests.
+//       std::size_t run(Job& job, std::string& out, bool& close) const;
+//   };
+//
+// A connection has at most one job at a worker, which answers its requests
+// in order into one buffer: responses keep the request order and a burst of
+// pipelined requests costs one hand-off and usually one write.
+template <typename Protocol>
+class StreamServer {
+private:
+    using State = typename Protocol::State;
+    using Job = typename Protocol::Job;
+
+    static constexpr std::uint64_t ListenerId = 0;
+    static constexpr std::uint64_t WakeId = 1;
+
+    // Owned by the loop thread
+    struct Connection {
+        int fd = -1;
+        std::string in;                      // received, not yet parsed
+        State state;
+        std::string out;                     // responses not yet sent
+        std::size_t sent = 0;                // of `out`
+        std::uint32_t events = 0;            // registered with epoll
+        bool busy = false;                   // a job is with a worker
+        bool closing = false;                // close once `out` is sent
+        bool peerClosed = false;
+        bool broken = false;                 // unparseable input
+    };
+
+    struct Task {
+        std::uint64_t connection;
+        Job job;
+    };
+
+    struct Done {
+        std::uint64_t connection;
+        std::string bytes;
+        bool close;
+    };
+
+    const Protocol& protocol;
+    unsigned workerCount;
+
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;
+    bool tcp = false;
+
+    std::thread loopThread;
+    std::vector<std::thread> workers;
+    std::atomic<bool> running{false};
+
+    std::mutex taskMutex;
+    std::condition_variable taskReady;
+    std::deque<Task> tasks;
+    bool stopping = false;
+
+    std::mutex doneMutex;
+    std::vector<Done> done;
+
+    std::unordered_map<std::uint64_t, std::unique_ptr<Connection>> connections;
+    std::uint64_t nextId = 2;
+
+    std::atomic<std::uint64_t> accepted{0};
+    std::atomic<std::uint64_t> served{0};
+    std::atomic<std::uint64_t> rejected{0};
+
+    void closeFds() {
+        for (int* fd : {&listenFd, &epollFd, &wakeFd}) {
+            if (*fd >= 0) ::close(*fd);
+            *fd = -1;
+        }
+    }
+
+    void wake() {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] auto n = ::write(wakeFd, &one, sizeof(one));
+    }
+
+    // -------- worker threads --------
+
+    void workerLoop() {
+        for (;;) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(taskMutex);
+                taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            Done result{task.connection, {}, false};
+            served += protocol.run(task.job, result.bytes, result.close);
+            {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                done.push_back(std::move(result));
+            }
+            wake();
+        }
+    }
+
+    // -------- loop thread --------
+
+    void acceptAll() {
+        for (;;) {
+            const int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;   // EAGAIN, or a connection that went away; try again on the next event
+            if (tcp) {
+                const int on = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            }
+
+            const std::uint64_t id = nextId++;
+            auto c = std::make_unique<Connection>();
+            c->fd = fd;
+            c->events = EPOLLIN;
+            epoll_event ev{};
+            ev.events = c->events;
+            ev.data.u64 = id;
+            if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+                ::close(fd);
+                continue;
+            }
+            connections.emplace(id, std::move(c));
+            ++accepted;
+        }
+    }
+
+    // False if the connection failed and must be closed
+    bool readFrom(Connection& c) {
+        char buffer[64 * 1024];
+        for (;;) {
+            const ssize_t n = ::recv(c.fd, buffer, sizeof(buffer), 0);
+            if (n > 0) {
+                c.in.append(buffer, static_cast<std::size_t>(n));
+                if (static_cast<std::size_t>(n) < sizeof(buffer)) break;
+                continue;
+            }
+            if (n == 0) {
+                c.peerClosed = true;
+                break;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        if (!c.broken && !protocol.parse(c.in, c.state)) {
+            c.broken = true;
+            ++rejected;
+        }
+        return true;
+    }
+
+    // False if the connection failed and must be closed
+    bool writeTo(Connection& c) {
+        while (c.sent < c.out.size()) {
+            const ssize_t n = ::send(c.fd, c.out.data() + c.sent, c.out.size() - c.sent, MSG_NOSIGNAL);
+            if (n > 0) {
+                c.sent += static_cast<std::size_t>(n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+            return false;
+        }
+        c.out.clear();
+        c.sent = 0;
+        return true;
+    }
+
+    void closeConnection(std::uint64_t id) {
+        auto it = connections.find(id);
+        if (it == connections.end()) return;
+        ::epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second->fd, nullptr);
+        ::close(it->second->fd);
+        connections.erase(it);
+    }
+
+    // Hands out work, sends what is ready, then closes the connection or
+    // updates what it waits for
+    void settle(std::uint64_t id, Connection& c) {
+        if (!c.busy && !c.closing && protocol.ready(c.state)) {
+            {
+                std::lock_guard<std::mutex> lock(taskMutex);
+                tasks.push_back({id, protocol.take(c.state)});
+            }
+            c.busy = true;
+            taskReady.notify_one();
+        }
+
+        const bool idle = !c.busy && (c.closing || !protocol.ready(c.state));
+        if (idle && !c.closing && protocol.finish(c.state, c.out)) c.closing = true;
+        if (!writeTo(c)) {
+            closeConnection(id);
+            return;
+        }
+        if (idle && c.out.empty() && (c.closing || c.peerClosed)) {
+            closeConnection(id);
+            return;
+        }
+
+        std::uint32_t wanted = 0;
+        if (!c.out.empty()) wanted |= EPOLLOUT;
+        if (!c.peerClosed && !c.closing && !c.broken && protocol.accepting(c.state)) wanted |= EPOLLIN;
+        if (wanted != c.events) {
+            epoll_event ev{};
+            ev.events = wanted;
+            ev.data.u64 = id;
+            ::epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+            c.events = wanted;
+        }
+    }
+
+    void collectDone() {
+        std::uint64_t count;
+        [[maybe_unused]] auto n = ::read(wakeFd, &count, sizeof(count));
+
+        std::vector<Done> finished;
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            finished.swap(done);
+        }
+        for (auto& d : finished) {
+            auto it = connections.find(d.connection);
+            if (it == connections.end()) continue;   // closed meanwhile
+            Connection& c = *it->second;
+            c.busy = false;
+            if (c.out.empty()) c.out.swap(d.bytes);
+            else c.out += d.bytes;
+            if (d.close) c.closing = true;
+            settle(d.connection, c);
+        }
+    }
+
+    void loop() {
+        std::vector<epoll_event> events(256);
+        while (running) {
+            const int n = ::epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            for (int i = 0; i < n && running; ++i) {
+                const std::uint64_t id = events[i].data.u64;
+                if (id == ListenerId) {
+                    acceptAll();
+                    continue;
+                }
+                if (id == WakeId) {
+                    collectDone();
+                    continue;
+                }
+
+                auto it = connections.find(id);
+                if (it == connections.end()) continue;
+                Connection& c = *it->second;
+                const std::uint32_t e = events[i].events;
+                if ((e & (EPOLLERR | EPOLLHUP)) && !(e & EPOLLIN)) {
+                    closeConnection(id);
+                    continue;
+                }
+                if ((e & EPOLLIN) && !readFrom(c)) {
+                    closeConnection(id);
+                    continue;
+                }
+                settle(id, c);
+            }
+        }
+    }
+
+public:
+    // `protocol` must outlive the server and be usable from several threads
+    // at once; `workers` = 0 means one per hardware thread
+    StreamServer(const Protocol& protocol, unsigned workers)
+        : protocol(protocol)
+        , workerCount(workers ? workers : std::max(1u, std::thread::hardware_concurrency())) {}
+
+    StreamServer(const StreamServer&) = delete;
+    StreamServer& operator=(const StreamServer&) = delete;
+
+    ~StreamServer() { stop(); }
+
+    // Takes ownership of a listening socket (see listenTcp / listenUnix)
+    bool start(int listener, std::string& error) {
+        if (running) return true;
+        listenFd = listener;
+        sockaddr_storage addr{};
+        socklen_t len = sizeof(addr);
+        ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+        tcp = addr.ss_family == AF_INET || addr.ss_family == AF_INET6;
+
+        epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollFd < 0 || wakeFd < 0) {
+            error = std::string("epoll: ") + std::strerror(errno);
+            closeFds();
+            return false;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = ListenerId;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+        ev.data.u64 = WakeId;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+
+        stopping = false;
+        running = true;
+        for (unsigned i = 0; i < workerCount; ++i) workers.emplace_back([this] { workerLoop(); });
+        loopThread = std::thread([this] { loop(); });
+        return true;
+    }
+
+    // Closes every connection; requests at a worker are finished first
+    void stop() {
+        if (!running.exchange(false)) return;
+        wake();
+        loopThread.join();
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            stopping = true;
+        }
+        taskReady.notify_all();
+        for (auto& w : workers) w.join();
+        workers.clear();
+
+        for (auto& entry : connections) ::close(entry.second->fd);
+        connections.clear();
+        tasks.clear();
+        done.clear();
+        closeFds();
+    }
+
+    bool isRunning() const { return running; }
+
+    StreamServerStats getStats() const {
+        return {accepted.load(), served.load(), rejected.load()};
+    }
+};
+
+#endif
+
+} // namespace infrastructure
+
+#endif
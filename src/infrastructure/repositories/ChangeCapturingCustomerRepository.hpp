@@ -0,0 +1,70 @@
+#ifndef CHANGE_CAPTURING_CUSTOMER_REPOSITORY_HPP
+#define CHANGE_CAPTURING_CUSTOMER_REPOSITORY_HPP
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../../domain/interfaces/ICustomerRepository.hpp"
+#include "../../domain/models/Customer.hpp"
+#include "../../domain/services/ChangeFeed.hpp"
+
+namespace infrastructure {
+
+// Decorator that appends every saved customer to a ChangeFeed, in the order
+// the saves were applied (see ChangeCapturingTicketRepository).
+class ChangeCapturingCustomerRepository : public domain::ICustomerRepository {
+private:
+    domain::ICustomerRepository& inner;
+    std::shared_ptr<domain::ChangeFeed> feed;
+    std::array<std::mutex, 64> stripes;
+
+    std::mutex& stripeFor(const std::string& id) {
+        return stripes[std::hash<std::string>{}(id) % stripes.size()];
+    }
+
+public:
+    ChangeCapturingCustomerRepository(domain::ICustomerRepository& repo,
+                                      std::shared_ptr<domain::ChangeFeed> changes)
+        : inner(repo), feed(std::move(changes)) {}
+
+    void save(const domain::Customer& customer) override {
+        std::lock_guard<std::mutex> lock(stripeFor(customer.getId()));
+        inner.save(customer);
+        feed->appendCustomer(customer);
+    }
+
+    // Holds every stripe, so no single-customer save interleaves with the batch
+    void saveAll(const std::vector<domain::Customer>& customers) override {
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(stripes.size());
+        for (auto& stripe : stripes) locks.emplace_back(stripe);
+        inner.saveAll(customers);
+        for (const auto& c : customers) feed->appendCustomer(c);
+    }
+
+    std::shared_ptr<domain::Customer> findById(const std::string& id) override {
+        return inner.findById(id);
+    }
+
+    std::vector<std::shared_ptr<domain::Customer>> findAll() override {
+        return inner.findAll();
+    }
+
+    std::vector<std::shared_ptr<domain::Customer>> findPage(const std::string& afterId, std::size_t limit) override {
+        return inner.findPage(afterId, limit);
+    }
+
+    bool remove(const std::string& id) override {
+        std::lock_guard<std::mutex> lock(stripeFor(id));
+        if (!inner.remove(id)) return false;
+        feed->appendRemoval(domain::ChangeEntity::CUSTOMER, id);
+        return true;
+    }
+};
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef CHANGE_CAPTURING_TICKET_REPOSITORY_HPP
+#define CHANGE_CAPTURING_TICKET_REPOSITORY_HPP
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../../domain/interfaces/ITicketRepository.hpp"
+#include "../../domain/models/Ticket.hpp"
+#include "../../domain/services/ChangeFeed.hpp"
+
+namespace infrastructure {
+
+// Decorator that appends every saved ticket (and every successful status
+// compare-and-swap) to a ChangeFeed.
+//
+// The write and the append happen under a lock striped by ticket id, so the
+// feed has each ticket's changes in the order they were applied.
+class ChangeCapturingTicketRepository : public domain::ITicketRepository {
+private:
+    domain::ITicketRepository& inner;
+    std::shared_ptr<domain::ChangeFeed> feed;
+    std::array<std::mutex, 64> stripes;
+
+    std::mutex& stripeFor(const std::string& id) {
+        return stripes[std::hash<std::string>{}(id) % stripes.size()];
+    }
+
+public:
+    ChangeCapturingTicketRepository(domain::ITicketRepository& repo,
+                                    std::shared_ptr<domain::ChangeFeed> changes)
+        : inner(repo), feed(std::move(changes)) {}
+
+    void save(const domain::Ticket& ticket) override {
+        std::lock_guard<std::mutex> lock(stripeFor(ticket.getId()));
+        inner.save(ticket);
+        feed->appendTicket(ticket);
+    }
+
+    void store(std::shared_ptr<domain::Ticket> ticket) override {
+        std::lock_guard<std::mutex> lock(stripeFor(ticket->getId()));
+        inner.store(ticket);
+        feed->appendTicket(*ticket);
+    }
+
+    // Holds every stripe, so no single-ticket save interleaves with the batch
+    void storeAll(std::vector<std::shared_ptr<domain::Ticket>> tickets) override {
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(stripes.size());
+        for (auto& stripe : stripes) locks.emplace_back(stripe);
+        inner.storeAll(tickets);
+        for (const auto& t : tickets) feed->appendTicket(*t);
+    }
+
+    std::shared_ptr<domain::Ticket> findById(const std::string& id) override {
+        return inner.findById(id);
+    }
+
+    std::vector<std::shared_ptr<domain::Ticket>> findAll() override {
+        return inner.findAll();
+    }
+
+    std::vector<std::shared_ptr<domain::Ticket>> findPage(const std::string& afterId, std::size_t limit) override {
+        return inner.findPage(afterId, limit);
+    }
+
+    std::vector<std::shared_ptr<domain::Ticket>> findByAllTags(const domain::TagSet& tags) override {
+        return inner.findByAllTags(tags);
+    }
+
+    using domain::ITicketRepository::compareAndSetStatus;
+
+    CasResult compareAndSetStatus(domain::Ticket& ticket,
+                                  domain::TicketStatus& expected,
+                                  domain::TicketStatus desired) override {
+        std::lock_guard<std::mutex> lock(stripeFor(ticket.getId()));
+        const CasResult result = inner.compareAndSetStatus(ticket, expected, desired);
+        if (result == CasResult::UPDATED) feed->appendTicket(ticket);
+        return result;
+    }
+};
+
+} // namespace infrastructure
+
+#endif
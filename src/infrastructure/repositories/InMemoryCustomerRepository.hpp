@@ -1,8 +1,11 @@
 #ifndef INMEMORY_CUSTOMER_REPOSITORY_HPP
 #define INMEMORY_CUSTOMER_REPOSITORY_HPP
 
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 #include "../../domain/interfaces/ICustomerRepository.hpp"
@@ -13,6 +16,7 @@ namespace infrastructure {
 class InMemoryCustomerRepository : public domain::ICustomerRepository {
 private:
     std::map<std::string, std::shared_ptr<domain::Customer>> customers;
+    mutable std::shared_mutex mtx;
 
     InMemoryCustomerRepository() = default;
     InMemoryCustomerRepository(const InMemoryCustomerRepository&) = delete;
@@ -25,11 +29,21 @@ public:
     }
 
     void save(const domain::Customer& customer) override {
-        customers[customer.getId()] =
-            std::make_shared<domain::Customer>(customer);
+        auto copy = std::make_shared<domain::Customer>(customer);
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        customers[customer.getId()] = std::move(copy);
+    }
+
+    void saveAll(const std::vector<domain::Customer>& batch) override {
+        std::vector<std::shared_ptr<domain::Customer>> copies;
+        copies.reserve(batch.size());
+        for (const auto& c : batch) copies.push_back(std::make_shared<domain::Customer>(c));
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        for (auto& c : copies) customers[c->getId()] = std::move(c);
     }
 
     std::shared_ptr<domain::Customer> findById(const std::string& id) override {
+        std::shared_lock<std::shared_mutex> lock(mtx);
         auto it = customers.find(id);
         if (it != customers.end()) {
             return it->second;
@@ -39,11 +53,27 @@ public:
 
     std::vector<std::shared_ptr<domain::Customer>> findAll() override {
         std::vector<std::shared_ptr<domain::Customer>> list;
+        std::shared_lock<std::shared_mutex> lock(mtx);
         for (auto& pair : customers) {
             list.push_back(pair.second);
         }
         return list;
     }
+
+    std::vector<std::shared_ptr<domain::Customer>> findPage(const std::string& afterId, std::size_t limit) override {
+        std::vector<std::shared_ptr<domain::Customer>> list;
+        list.reserve(std::min<std::size_t>(limit, 4096));
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        for (auto it = customers.upper_bound(afterId); it != customers.end() && list.size() < limit; ++it) {
+            list.push_back(it->second);
+        }
+        return list;
+    }
+
+    bool remove(const std::string& id) override {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        return customers.erase(id) != 0;
+    }
 };
 
 } // namespace infrastructure
@@ -1,23 +1,35 @@
 #ifndef INMEMORY_TICKET_REPOSITORY_HPP
 #define INMEMORY_TICKET_REPOSITORY_HPP
 
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 #include "../../domain/interfaces/ITicketRepository.hpp"
 #include "../../domain/models/Ticket.hpp"
+#include "../../domain/util/TagIndex.hpp"
 
 namespace infrastructure {
 
 class InMemoryTicketRepository : public domain::ITicketRepository {
 private:
     std::map<std::string, std::shared_ptr<domain::Ticket>> tickets;
+    domain::TagIndex<std::shared_ptr<domain::Ticket>> tagIndex;
+    mutable std::shared_mutex mtx;
 
     InMemoryTicketRepository() = default;
     InMemoryTicketRepository(const InMemoryTicketRepository&) = delete;
     InMemoryTicketRepository& operator=(const InMemoryTicketRepository&) = delete;
 
+    // Whether `ticket` is the stored object; call with mtx held
+    bool holds(const domain::Ticket& ticket) const {
+        auto it = tickets.find(ticket.getId());
+        return it != tickets.end() && it->second.get() == &ticket;
+    }
+
 public:
     static InMemoryTicketRepository& getInstance() {
         static InMemoryTicketRepository instance;
@@ -25,11 +37,40 @@ public:
     }
 
     void save(const domain::Ticket& ticket) override {
-        tickets[ticket.getId()] =
-            std::make_shared<domain::Ticket>(ticket);
+        // Saving the stored object itself (changed in place through
+        // findById) must not replace it: concurrent status CAS on it would
+        // be lost. Only its tags are re-indexed.
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        if (!holds(ticket)) {
+            // Copied outside the lock; store() may have put this very
+            // object in meanwhile
+            lock.unlock();
+            auto copy = std::make_shared<domain::Ticket>(ticket);
+            lock.lock();
+            if (!holds(ticket)) tickets[ticket.getId()] = std::move(copy);
+        }
+        const auto& slot = tickets[ticket.getId()];
+        tagIndex.update(ticket.getId(), slot, slot->getTagSet());
+    }
+
+    void store(std::shared_ptr<domain::Ticket> ticket) override {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        auto& slot = tickets[ticket->getId()];
+        slot = std::move(ticket);
+        tagIndex.update(slot->getId(), slot, slot->getTagSet());
+    }
+
+    void storeAll(std::vector<std::shared_ptr<domain::Ticket>> batch) override {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        for (auto& ticket : batch) {
+            auto& slot = tickets[ticket->getId()];
+            slot = std::move(ticket);
+            tagIndex.update(slot->getId(), slot, slot->getTagSet());
+        }
     }
 
     std::shared_ptr<domain::Ticket> findById(const std::string& id) override {
+        std::shared_lock<std::shared_mutex> lock(mtx);
         auto it = tickets.find(id);
         if (it != tickets.end()) {
             return it->second;
@@ -39,11 +80,40 @@ public:
 
     std::vector<std::shared_ptr<domain::Ticket>> findAll() override {
         std::vector<std::shared_ptr<domain::Ticket>> list;
+        std::shared_lock<std::shared_mutex> lock(mtx);
         for (auto& pair : tickets) {
             list.push_back(pair.second);
         }
         return list;
     }
+
+    std::vector<std::shared_ptr<domain::Ticket>> findPage(const std::string& afterId, std::size_t limit) override {
+        std::vector<std::shared_ptr<domain::Ticket>> list;
+        list.reserve(std::min<std::size_t>(limit, 4096));
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        for (auto it = tickets.upper_bound(afterId); it != tickets.end() && list.size() < limit; ++it) {
+            list.push_back(it->second);
+        }
+        return list;
+    }
+
+    std::vector<std::shared_ptr<domain::Ticket>> findByAllTags(const domain::TagSet& tags) override {
+        std::vector<std::shared_ptr<domain::Ticket>> list;
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        tagIndex.forEachMatch(tags, [&](const std::shared_ptr<domain::Ticket>& t) { list.push_back(t); });
+        return list;
+    }
+
+    using domain::ITicketRepository::compareAndSetStatus;
+
+    // The stored ticket is shared with readers, so its status is swapped in
+    // place; save() is not needed and would race with other updates.
+    CasResult compareAndSetStatus(domain::Ticket& ticket,
+                                  domain::TicketStatus& expected,
+                                  domain::TicketStatus desired) override {
+        return ticket.compareAndSetStatus(expected, desired) ? CasResult::UPDATED
+                                                             : CasResult::CONFLICT;
+    }
 };
 
 } // namespace infrastructure
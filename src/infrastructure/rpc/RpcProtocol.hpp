@@ -0,0 +1,162 @@
+#ifndef RPC_PROTOCOL_HPP
+#define RPC_PROTOCOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <string_view>
+
+#include "../../domain/models/Enums.hpp"
+#include "../exporting/BinaryFormat.hpp"
+#include "../exporting/BulkExporter.hpp"
+
+namespace infrastructure {
+
+// Binary request/response protocol for local clients (see RpcServer):
+//
+//   frame:     length (u32, of what follows), then the body
+//   request:   id (u32), operation (1 byte), arguments
+//   response:  id (u32, of the request), RpcStatus (1 byte), result;
+//              for any status but OK the result is an error message
+//
+// Integers in frame and message headers are little-endian; strings,
+// varints, enums and records are encoded as in BinaryFormat.hpp. A client
+// may send any number of requests without waiting; they are answered in
+// the order they were sent, each response carrying its request's id.
+//
+//   operation           arguments                           result
+//   PING                -                                   -
+//   REGISTER_CUSTOMER   name, email, phone, CustomerType    customer id
+//   GET_CUSTOMER        customer id                         customer record
+//   CREATE_TICKET       customer id, description,           ticket id
+//                       Priority, TicketCategory
+//   GET_TICKET          ticket id                           ticket record
+//   UPDATE_STATUS       ticket id, TicketStatus             -
+//   ASSIGN_TICKET       ticket id, agent                    -
+//   QUERY_TICKETS       query (see appendRpcQuery)          count (u32), ticket records,
+//                                                           next cursor ("" at the end)
+//   NEXT_TICKET         agent                               ticket id, "" if none waits
+enum class RpcOperation : std::uint8_t {
+    PING,
+    REGISTER_CUSTOMER,
+    GET_CUSTOMER,
+    CREATE_TICKET,
+    GET_TICKET,
+    UPDATE_STATUS,
+    ASSIGN_TICKET,
+    QUERY_TICKETS,
+    NEXT_TICKET
+};
+constexpr std::size_t RpcOperationCount = 9;
+
+enum class RpcStatus : std::uint8_t {
+    OK,
+    BAD_REQUEST,         // arguments could not be decoded
+    NOT_FOUND,
+    INVALID,             // the ticket failed validation
+    NOT_ALLOWED,         // the state machine refused the status change
+    CONFLICT,            // the status changed concurrently
+    UNKNOWN_OPERATION,
+    INTERNAL_ERROR,
+    THROTTLED            // the ticket was refused by the rate limits; try again later
+};
+
+constexpr std::size_t RpcLengthSize = 4;
+constexpr std::size_t RpcHeaderSize = 5;   // id, operation or status
+
+namespace rpc_detail {
+
+inline void putU32(std::string& out, std::uint32_t v) {
+    const char bytes[4] = {static_cast<char>(v), static_cast<char>(v >> 8), static_cast<char>(v >> 16),
+                           static_cast<char>(v >> 24)};
+    out.append(bytes, 4);
+}
+
+inline void setU32(char* at, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) at[i] = static_cast<char>(v >> (8 * i));
+}
+
+inline std::uint32_t getU32(const char* at) {
+    const auto* b = reinterpret_cast<const unsigned char*>(at);
+    return static_cast<std::uint32_t>(b[0]) | static_cast<std::uint32_t>(b[1]) << 8 |
+           static_cast<std::uint32_t>(b[2]) << 16 | static_cast<std::uint32_t>(b[3]) << 24;
+}
+
+// Enum fields of a query: this value means "any"
+constexpr unsigned char AnyValue = 0xFF;
+
+} // namespace rpc_detail
+
+// Starts a frame with a placeholder length; returns where it starts
+inline std::size_t beginRpcFrame(std::string& out, std::uint32_t id, std::uint8_t code) {
+    const std::size_t start = out.size();
+    rpc_detail::putU32(out, 0);
+    rpc_detail::putU32(out, id);
+    out.push_back(static_cast<char>(code));
+    return start;
+}
+
+inline void endRpcFrame(std::string& out, std::size_t start) {
+    rpc_detail::setU32(&out[start], static_cast<std::uint32_t>(out.size() - start - RpcLengthSize));
+}
+
+// A page of tickets matching `filter`, in id order after `after`
+struct RpcTicketQuery {
+    TicketFilter filter;
+    std::string after;
+    std::uint32_t limit = 50;
+};
+
+// status, priority, category (1 byte each, 0xFF = any), customer id, agent,
+// tag count (varint), tags, createdFrom, createdUntil (varints), after
+// (string), limit (varint)
+inline void appendRpcQuery(std::string& out, const RpcTicketQuery& query) {
+    using namespace binary_detail;
+    const auto& f = query.filter;
+    out.push_back(static_cast<char>(f.status ? static_cast<unsigned char>(*f.status) : rpc_detail::AnyValue));
+    out.push_back(static_cast<char>(f.priority ? static_cast<unsigned char>(*f.priority) : rpc_detail::AnyValue));
+    out.push_back(static_cast<char>(f.category ? static_cast<unsigned char>(*f.category) : rpc_detail::AnyValue));
+    putString(out, f.customerId);
+    putString(out, f.assignedTo);
+    putVarint(out, f.tags.size());
+    for (const auto& tag : f.tags) putString(out, tag);
+    putVarint(out, static_cast<std::uint64_t>(f.createdFrom));
+    putVarint(out, static_cast<std::uint64_t>(f.createdUntil));
+    putString(out, query.after);
+    putVarint(out, query.limit);
+}
+
+inline bool readRpcQuery(const char*& p, const char* end, RpcTicketQuery& query) {
+    using namespace binary_detail;
+    auto& f = query.filter;
+    auto optionalEnum = [&](auto& field, std::size_t count) {
+        if (p == end) return false;
+        if (static_cast<unsigned char>(*p) == rpc_detail::AnyValue) {
+            ++p;
+            return true;
+        }
+        field.emplace();
+        return getEnum(p, end, count, *field);
+    };
+    std::uint64_t tags, from, until, limit;
+    if (!optionalEnum(f.status, domain::TicketStatusCount) || !optionalEnum(f.priority, domain::PriorityCount) ||
+        !optionalEnum(f.category, domain::TicketCategoryCount) || !getString(p, end, f.customerId) ||
+        !getString(p, end, f.assignedTo) || !getVarint(p, end, tags) || tags > static_cast<std::uint64_t>(end - p))
+        return false;
+    f.tags.resize(static_cast<std::size_t>(tags));
+    for (auto& tag : f.tags) {
+        if (!getString(p, end, tag)) return false;
+    }
+    if (!getVarint(p, end, from) || !getVarint(p, end, until) || !getString(p, end, query.after) ||
+        !getVarint(p, end, limit))
+        return false;
+    f.createdFrom = static_cast<std::time_t>(from);
+    f.createdUntil = static_cast<std::time_t>(until);
+    query.limit = static_cast<std::uint32_t>(limit);
+    return true;
+}
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef RPC_SERVER_HPP
+#define RPC_SERVER_HPP
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <utility>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "../net/StreamServer.hpp"
+#include "RpcProtocol.hpp"
+
+namespace infrastructure {
+
+// Answers one request: appends the result for OK, otherwise an error
+// message (see RpcProtocol.hpp). [payload, end) points into the receive
+// buffer and is only valid during the call.
+using RpcHandler = std::function<RpcStatus(RpcOperation operation, const char* payload, const char* end,
+                                           std::string& out)>;
+
+struct RpcServerOptions {
+    std::string path = "support.sock";      // Unix domain socket
+    unsigned workers = 0;                   // handler threads; 0 = one per hardware thread
+    std::size_t maxFrameBytes = 1 << 20;    // larger frames end the connection
+    std::size_t maxQueuedBytes = 4 << 20;   // requests buffered per connection before it is no longer read
+};
+
+using RpcServerStats = StreamServerStats;
+
+#if defined(__linux__)
+
+// RpcProtocol server on a StreamServer, listening on a Unix domain socket.
+//
+// The loop thread only finds frame boundaries. Complete frames stay in the
+// buffer they were received into, which is moved (not copied) to a worker;
+// the worker decodes each request in place and hands the handler pointers
+// into that buffer. All responses to one batch are written into one buffer
+// and sent together.
+class RpcServer {
+private:
+    struct Protocol {
+        struct State {
+            std::string frames;      // complete requests, not yet handed to a worker
+            std::size_t count = 0;   // in `frames`
+            bool broken = false;
+        };
+
+        struct Job {
+            std::string frames;
+            std::size_t count = 0;
+        };
+
+        RpcHandler handler;
+        RpcServerOptions options;
+
+        bool parse(std::string& in, State& state) const {
+            std::size_t offset = 0, count = 0;
+            while (in.size() - offset >= RpcLengthSize) {
+                const std::size_t length = rpc_detail::getU32(in.data() + offset);
+                if (length < RpcHeaderSize || length > options.maxFrameBytes) {
+                    state.broken = true;
+                    break;
+                }
+                if (in.size() - offset - RpcLengthSize < length) break;
+                offset += RpcLengthSize + length;
+                ++count;
+            }
+            if (count) {
+                if (state.frames.empty() && offset == in.size()) {
+                    state.frames.swap(in);
+                } else {
+                    state.frames.append(in, 0, offset);
+                    in.erase(0, offset);
+                }
+                state.count += count;
+            }
+            return !state.broken;
+        }
+
+        bool ready(const State& state) const { return state.count > 0; }
+
+        bool accepting(const State& state) const { return state.frames.size() < options.maxQueuedBytes; }
+
+        Job take(State& state) const {
+            Job job{std::move(state.frames), state.count};
+            state.frames.clear();
+            state.count = 0;
+            return job;
+        }
+
+        bool finish(State& state, std::string&) const { return state.broken; }
+
+        std::size_t run(Job& job, std::string& out, bool&) const {
+            out.reserve(job.frames.size());
+            const char* p = job.frames.data();
+            for (std::size_t i = 0; i < job.count; ++i) {
+                const char* end = p + RpcLengthSize + rpc_detail::getU32(p);
+                const std::uint32_t id = rpc_detail::getU32(p + RpcLengthSize);
+                const auto operation = static_cast<unsigned char>(p[RpcLengthSize + 4]);
+                const char* payload = p + RpcLengthSize + RpcHeaderSize;
+
+                const std::size_t frame = beginRpcFrame(out, id, 0);
+                const std::size_t mark = out.size();
+                RpcStatus status;
+                if (operation >= RpcOperationCount) {
+                    status = RpcStatus::UNKNOWN_OPERATION;
+                    binary_detail::putString(out, "Unknown operation " + std::to_string(operation));
+                } else {
+                    try {
+                        status = handler(static_cast<RpcOperation>(operation), payload, end, out);
+                    } catch (const std::exception&) {
+                        out.resize(mark);
+                        status = RpcStatus::INTERNAL_ERROR;
+                        binary_detail::putString(out, "Internal error");
+                    }
+                }
+                out[frame + RpcLengthSize + 4] = static_cast<char>(status);
+                endRpcFrame(out, frame);
+                p = end;
+            }
+            return job.count;
+        }
+    };
+
+    Protocol protocol;
+    StreamServer<Protocol> server;
+    std::string failure;
+
+public:
+    RpcServer(RpcHandler handler, RpcServerOptions options = {})
+        : protocol{std::move(handler), std::move(options)}
+        , server(protocol, protocol.options.workers) {}
+
+    ~RpcServer() { stop(); }
+
+    // Creates the socket (replacing a stale one) and starts serving; false
+    // with error() set if it cannot be created
+    bool start() {
+        if (server.isRunning()) return true;
+        const int fd = listenUnix(protocol.options.path, failure);
+        return fd >= 0 && server.start(fd, failure);
+    }
+
+    // Closes every connection and removes the socket file; requests in
+    // progress are finished first
+    void stop() {
+        if (!server.isRunning()) return;
+        server.stop();
+        ::unlink(protocol.options.path.c_str());
+    }
+
+    bool isRunning() const { return server.isRunning(); }
+    const std::string& error() const { return failure; }
+    const std::string& path() const { return protocol.options.path; }
+    RpcServerStats getStats() const { return server.getStats(); }
+};
+
+#else
+
+// Needs epoll; elsewhere start() fails
+class RpcServer {
+private:
+    std::string failure = "The RPC server needs Linux (epoll)";
+    std::string socketPath;
+
+public:
+    RpcServer(RpcHandler, RpcServerOptions options = {}) : socketPath(std::move(options.path)) {}
+
+    bool start() { return false; }
+    void stop() {}
+    bool isRunning() const { return false; }
+    const std::string& error() const { return failure; }
+    const std::string& path() const { return socketPath; }
+    RpcServerStats getStats() const { return {}; }
+};
+
+#endif
+
+} // namespace infrastructure
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef SUPPORT_RPC_API_HPP
+#define SUPPORT_RPC_API_HPP
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../../domain/behaviors/chain/TicketCreationRequest.hpp"
+#include "../../domain/behaviors/chain/TicketValidation.hpp"
+#include "../../domain/factory/TicketFactory.hpp"
+#include "../../domain/services/CustomerService.hpp"
+#include "../../domain/services/TicketService.hpp"
+#include "../exporting/BinaryFormat.hpp"
+#include "../exporting/BulkExporter.hpp"
+#include "RpcProtocol.hpp"
+
+namespace infrastructure {
+
+// The RpcProtocol operations over CustomerService and TicketService, for
+// use as an RpcServer handler. Tickets are validated with the shared
+// TicketValidation, like POST /tickets of SupportHttpApi. handle() may be
+// called from many threads at once.
+class SupportRpcApi {
+private:
+    std::shared_ptr<domain::CustomerService> customerService;
+    std::shared_ptr<domain::TicketService> ticketService;
+    const domain::behaviors::chain::TicketValidation& validation;
+
+    static constexpr std::uint32_t MaxPageLimit = 1000;
+
+    static RpcStatus fail(std::string& out, std::size_t mark, RpcStatus status, const std::string& message) {
+        out.resize(mark);
+        binary_detail::putString(out, message);
+        return status;
+    }
+
+    template <typename Record>
+    static void appendRecord(std::string& out, const Record& record) {
+        thread_local std::string payload;
+        appendBinaryRecord(out, payload, record);
+    }
+
+    RpcStatus query(const char* p, const char* end, std::string& out, std::size_t mark) {
+        RpcTicketQuery q;
+        if (!readRpcQuery(p, end, q)) return fail(out, mark, RpcStatus::BAD_REQUEST, "Malformed query");
+        const std::uint32_t limit = std::min(std::max<std::uint32_t>(q.limit, 1), MaxPageLimit);
+
+        const TicketMatcher matches(std::move(q.filter));
+        const std::size_t pageSize = 1024;
+        const std::size_t countAt = out.size();
+        rpc_detail::putU32(out, 0);
+        std::uint32_t found = 0;
+        std::string next;
+        while (next.empty()) {
+            const auto page = ticketService->getTicketsPage(q.after, pageSize);
+            for (const auto& t : page) {
+                if (!matches(*t)) continue;
+                appendRecord(out, *t);
+                if (++found == limit) {
+                    next = t->getId();
+                    break;
+                }
+            }
+            if (page.size() < pageSize) break;
+            q.after = page.back()->getId();
+        }
+        rpc_detail::setU32(&out[countAt], found);
+        binary_detail::putString(out, next);
+        return RpcStatus::OK;
+    }
+
+public:
+    SupportRpcApi(std::shared_ptr<domain::CustomerService> customers,
+                  std::shared_ptr<domain::TicketService> tickets,
+                  const domain::behaviors::chain::TicketValidation& validation)
+        : customerService(std::move(customers))
+        , ticketService(std::move(tickets))
+        , validation(validation) {}
+
+    // Arguments are read in place from [p, end); only what the services
+    // keep is copied out
+    RpcStatus handle(RpcOperation operation, const char* p, const char* end, std::string& out) {
+        using namespace binary_detail;
+        const std::size_t mark = out.size();
+        auto malformed = [&] { return fail(out, mark, RpcStatus::BAD_REQUEST, "Malformed arguments"); };
+        std::string_view a, b, c;
+
+        switch (operation) {
+            case RpcOperation::PING:
+                return RpcStatus::OK;
+
+            case RpcOperation::REGISTER_CUSTOMER: {
+                domain::CustomerType type;
+                if (!getView(p, end, a) || !getView(p, end, b) || !getView(p, end, c) ||
+                    !getEnum(p, end, domain::CustomerTypeCount, type))
+                    return malformed();
+                if (a.empty()) return fail(out, mark, RpcStatus::INVALID, "Name is required");
+                if (b.find('@') == std::string_view::npos)
+                    return fail(out, mark, RpcStatus::INVALID, "Invalid email: " + std::string(b));
+                putString(out, customerService->registerCustomer(std::string(a), std::string(b), std::string(c), type));
+                return RpcStatus::OK;
+            }
+
+            case RpcOperation::GET_CUSTOMER: {
+                if (!getView(p, end, a)) return malformed();
+                const std::string id(a);
+                auto customer = customerService->getCustomer(id);
+                if (!customer) return fail(out, mark, RpcStatus::NOT_FOUND, "Unknown customer: " + id);
+                appendRecord(out, *customer);
+                return RpcStatus::OK;
+            }
+
+            case RpcOperation::CREATE_TICKET: {
+                domain::behaviors::chain::TicketCreationRequest req;
+                if (!getView(p, end, a) || !getView(p, end, b) ||
+                    !getEnum(p, end, domain::PriorityCount, req.priority) ||
+                    !getEnum(p, end, domain::TicketCategoryCount, req.category))
+                    return malformed();
+                req.customerId.assign(a);
+                req.description.assign(b);
+                if (!validation.validate(req)) {
+                    return fail(out, mark,
+                                domain::behaviors::chain::ThrottleRule::rejected(req) ? RpcStatus::THROTTLED
+                                                                                      : RpcStatus::INVALID,
+                                req.errorMessage);
+                }
+                const auto id = ticketService->createTicket(req.customerId, std::move(req.description),
+                                                            req.priority, req.category);
+                if (id.empty()) return fail(out, mark, RpcStatus::INVALID, "Ticket could not be created");
+                putString(out, id);
+                return RpcStatus::OK;
+            }
+
+            case RpcOperation::GET_TICKET: {
+                if (!getView(p, end, a)) return malformed();
+                const std::string id(a);
+                auto ticket = ticketService->getTicket(id);
+                if (!ticket) return fail(out, mark, RpcStatus::NOT_FOUND, "Unknown ticket: " + id);
+                appendRecord(out, *ticket);
+                return RpcStatus::OK;
+            }
+
+            case RpcOperation::UPDATE_STATUS: {
+                domain::TicketStatus status;
+                if (!getView(p, end, a) || !getEnum(p, end, domain::TicketStatusCount, status)) return malformed();
+                const std::string id(a);
+                switch (ticketService->updateTicketStatus(id, status)) {
+                    case domain::StatusUpdateResult::UPDATED:
+                        return RpcStatus::OK;
+                    case domain::StatusUpdateResult::NOT_FOUND:
+                        return fail(out, mark, RpcStatus::NOT_FOUND, "Unknown ticket: " + id);
+                    case domain::StatusUpdateResult::ILLEGAL_TRANSITION:
+                        return fail(out, mark, RpcStatus::NOT_ALLOWED,
+                                    "Not allowed: " + id + " -> " + domain::TicketFactory::getStatusName(status));
+                    case domain::StatusUpdateResult::CONFLICT:
+                        return fail(out, mark, RpcStatus::CONFLICT, "Changed concurrently: " + id);
+                }
+                return fail(out, mark, RpcStatus::INTERNAL_ERROR, "Unexpected update result");
+            }
+
+            case RpcOperation::ASSIGN_TICKET: {
+                if (!getView(p, end, a) || !getView(p, end, b)) return malformed();
+                const std::string id(a);
+                if (!ticketService->assignTicket(id, std::string(b)))
+                    return fail(out, mark, RpcStatus::NOT_FOUND, "Unknown ticket: " + id);
+                return RpcStatus::OK;
+            }
+
+            case RpcOperation::QUERY_TICKETS:
+                return query(p, end, out, mark);
+
+            case RpcOperation::NEXT_TICKET:
+                if (!getView(p, end, a)) return malformed();
+                putString(out, ticketService->nextTicket(std::string(a)));
+                return RpcStatus::OK;
+        }
+        return fail(out, mark, RpcStatus::UNKNOWN_OPERATION, "Unknown operation");
+    }
+};
+
+} // namespace infrastructure
+
+#endif
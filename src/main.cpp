@@ -1,4 +1,15 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <string>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <pthread.h>
+#endif
 
 // CLIENT
 #include "client/CLI.hpp"
@@ -6,8 +17,18 @@
 // DOMAIN SERVICES
 #include "domain/services/CustomerService.hpp"
 #include "domain/services/TicketService.hpp"
+#include "domain/services/TicketHistoryService.hpp"
+#include "domain/services/SlaScheduler.hpp"
 #include "domain/services/NotificationService.hpp"
 #include "domain/services/SupportFacade.hpp"
+#include "domain/services/ChangeFeed.hpp"
+#include "domain/services/AgentAssignmentService.hpp"
+#include "domain/services/WorkQueueService.hpp"
+
+// OBSERVERS
+#include "domain/behaviors/chain/TicketValidation.hpp"
+#include "domain/behaviors/observer/TicketEventBus.hpp"
+#include "domain/behaviors/observer/TicketNotificationObserver.hpp"
 
 // FACTORIES
 #include "domain/factory/CustomerFactory.hpp"
@@ -15,51 +36,239 @@
 
 // INFRASTRUCTURE
 #include "infrastructure/logging/ConsoleLogger.hpp"
+#include "infrastructure/logging/FileLogger.hpp"
 #include "infrastructure/logging/TimestampLogger.hpp"
 #include "infrastructure/repositories/InMemoryCustomerRepository.hpp"
 #include "infrastructure/repositories/InMemoryTicketRepository.hpp"
+#include "infrastructure/repositories/ChangeCapturingCustomerRepository.hpp"
+#include "infrastructure/repositories/ChangeCapturingTicketRepository.hpp"
 #include "infrastructure/notifications/EmailNotification.hpp"
 #include "infrastructure/notifications/SMSNotification.hpp"
 #include "infrastructure/notifications/PushNotification.hpp"
 #include "infrastructure/notifications/ChatNotificationAdapter.hpp"
+#include "infrastructure/http/HttpServer.hpp"
+#include "infrastructure/http/SupportHttpApi.hpp"
+#include "infrastructure/rpc/RpcServer.hpp"
+#include "infrastructure/rpc/SupportRpcApi.hpp"
+
+//   support                              interactive menu
+//   support --batch <file | -> [--quiet] [--stop-on-error] [--no-throttle]
+//                                        run commands from a file or stdin
+//                                        (see CommandLineInterface::runBatch);
+//                                        --no-throttle lifts the per-customer
+//                                        ticket rate limits for the run
+//   support [--http <port>] [--rpc <socket path>] [--workers <n>]
+//                                        serve the JSON API (see SupportHttpApi)
+//                                        and / or the binary protocol (see
+//                                        SupportRpcApi) until SIGINT / SIGTERM
+//   any of the above [--change-feed <dir>]
+//                                        also append every save to a change
+//                                        feed kept in <dir> (see ChangeFeed)
+int main(int argc, char** argv) {
+    std::string batchFile;
+    std::string changeFeedDirectory;
+    client::BatchOptions batchOptions;
+    infrastructure::HttpServerOptions httpOptions;
+    infrastructure::RpcServerOptions rpcOptions;
+    bool http = false;
+    bool rpc = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) batchFile = argv[++i];
+        else if (std::strcmp(argv[i], "--http") == 0 && i + 1 < argc) {
+            http = true;
+            httpOptions.port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--rpc") == 0 && i + 1 < argc) {
+            rpc = true;
+            rpcOptions.path = argv[++i];
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            httpOptions.workers = rpcOptions.workers = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--change-feed") == 0 && i + 1 < argc) {
+            changeFeedDirectory = argv[++i];
+        } else if (std::strcmp(argv[i], "--quiet") == 0) batchOptions.echo = false;
+        else if (std::strcmp(argv[i], "--stop-on-error") == 0) batchOptions.stopOnError = true;
+        else if (std::strcmp(argv[i], "--no-throttle") == 0) batchOptions.throttle = false;
+        else {
+            std::fprintf(stderr,
+                         "usage: %s [--batch <file | -> [--quiet] [--stop-on-error] [--no-throttle]]\n"
+                         "       %s [--http <port>] [--rpc <socket path>] [--workers <n>]\n"
+                         "       either with [--change-feed <dir>]\n",
+                         argv[0], argv[0]);
+            return 2;
+        }
+    }
+    const bool batch = !batchFile.empty();
+    const bool serve = http || rpc;
+    const bool headless = batch || serve;
 
-int main() {
-    // LOGGER (Decorator)
-    auto baseLogger = std::make_shared<infrastructure::ConsoleLogger>();
-    auto logger     = std::make_shared<infrastructure::TimestampLogger>(baseLogger);
+#if !defined(_WIN32)
+    // Blocked before any thread starts, so only the main thread sees them (sigwait below)
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    if (serve) pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+#endif
+
+    // LOGGER (Decorator); without the menu the console is for results only
+    std::shared_ptr<domain::ILogger> baseLogger;
+    if (headless) baseLogger = std::make_shared<infrastructure::FileLogger>("support.log");
+    else baseLogger = std::make_shared<infrastructure::ConsoleLogger>();
+    auto logger = std::make_shared<infrastructure::TimestampLogger>(baseLogger);
 
     // REPOSITORIES
-    auto& customerRepo = infrastructure::InMemoryCustomerRepository::getInstance();
-    auto& ticketRepo   = infrastructure::InMemoryTicketRepository::getInstance();
+    auto& customerStore = infrastructure::InMemoryCustomerRepository::getInstance();
+    auto& ticketStore   = infrastructure::InMemoryTicketRepository::getInstance();
+
+    // CHANGE FEED (Decorator, with --change-feed: every save is also appended
+    // to the feed's segment files)
+    domain::ICustomerRepository* customerRepo = &customerStore;
+    domain::ITicketRepository* ticketRepo = &ticketStore;
+    std::unique_ptr<infrastructure::ChangeCapturingCustomerRepository> capturedCustomers;
+    std::unique_ptr<infrastructure::ChangeCapturingTicketRepository> capturedTickets;
+    if (!changeFeedDirectory.empty()) {
+        domain::ChangeFeedOptions feedOptions;
+        feedOptions.directory = changeFeedDirectory;
+        auto changes = std::make_shared<domain::ChangeFeed>(feedOptions);
+        if (!changes->isFileBacked())
+            std::fprintf(stderr, "Keeping the change feed in memory only (%s)\n", changes->getError().c_str());
+        capturedCustomers = std::make_unique<infrastructure::ChangeCapturingCustomerRepository>(customerStore, changes);
+        capturedTickets = std::make_unique<infrastructure::ChangeCapturingTicketRepository>(ticketStore, changes);
+        customerRepo = capturedCustomers.get();
+        ticketRepo = capturedTickets.get();
+    }
 
     // NOTIFICATION SERVICE (Singleton-ish)
+    // The demo channels print to the console, so batch and HTTP modes leave them out
     auto& notifier = domain::NotificationService::getInstance(logger);
-    notifier.addChannel(std::make_shared<infrastructure::EmailNotification>());
-    notifier.addChannel(std::make_shared<infrastructure::SMSNotification>());
-    notifier.addChannel(std::make_shared<infrastructure::PushNotification>());
-    notifier.addChannel(std::make_shared<infrastructure::ChatNotificationAdapter>()); // Adapter
+    if (!headless) {
+        notifier.addChannel(std::make_shared<infrastructure::EmailNotification>());
+        notifier.addChannel(std::make_shared<infrastructure::SMSNotification>());
+        notifier.addChannel(std::make_shared<infrastructure::PushNotification>());
+        notifier.addChannel(std::make_shared<infrastructure::ChatNotificationAdapter>()); // Adapter
+    }
 
     // SERVICES
     auto customerService = std::make_shared<domain::CustomerService>(
-        customerRepo,
+        *customerRepo,
         logger,
         std::make_unique<domain::CustomerFactory>()
     );
 
     auto ticketService = std::make_shared<domain::TicketService>(
-        ticketRepo,
-        customerRepo,
+        *ticketRepo,
+        *customerRepo,
         notifier,
         logger,
         std::make_unique<domain::TicketFactory>()
     );
+    ticketService->setCustomerFilter(customerService->getIdFilter());
+    ticketService->setHistory(std::make_shared<domain::TicketHistoryService>());
+
+    // SLA TIMERS (escalate tickets that sit too long in OPEN / IN_PROGRESS)
+    auto sla = std::make_shared<domain::SlaScheduler>();
+    sla->setBreachHandler([weakService = std::weak_ptr<domain::TicketService>(ticketService)](
+                              const domain::SlaBreach& breach) {
+        if (auto service = weakService.lock()) service->escalateTicket(breach.ticketId);
+    });
+    ticketService->setSlaScheduler(sla);
+    sla->start();
+
+    // TICKET EVENTS (Observer, delivered asynchronously to the support inbox)
+    auto events = std::make_shared<domain::behaviors::observer::TicketEventBus>();
+    events->subscribe(
+        std::make_shared<domain::behaviors::observer::TicketNotificationObserver>(notifier, *customerRepo),
+        {"support-inbox"});
+    ticketService->setEventBus(events);
+
+    // AGENTS (new tickets go to the least-loaded agent with the skill and level)
+    auto agents = std::make_shared<domain::AgentAssignmentService>();
+    agents->registerAgent({"Senior-Agent-001", domain::AgentLevel::SENIOR, {}});
+    agents->registerAgent({"Senior-Agent-004", domain::AgentLevel::SENIOR,
+                           {domain::TicketCategory::TECHNICAL, domain::TicketCategory::COMPLAINT}});
+    agents->registerAgent({"Agent-002", domain::AgentLevel::REGULAR, {}});
+    agents->registerAgent({"Agent-003", domain::AgentLevel::REGULAR,
+                           {domain::TicketCategory::BILLING, domain::TicketCategory::GENERAL}});
+    agents->registerAgent({"Agent-005", domain::AgentLevel::JUNIOR,
+                           {domain::TicketCategory::GENERAL, domain::TicketCategory::FEATURE_REQUEST}});
+    ticketService->setAssignmentService(agents);
+
+    // WORK QUEUES (OPEN tickets per agent / team, most urgent first)
+    ticketService->setWorkQueues(std::make_shared<domain::WorkQueueService>(sla->getPolicy()));
 
     // FACADE
     domain::SupportFacade facade(customerService, ticketService, notifier);
 
+    // VALIDATION (Chain of Responsibility): one set of rules, rate limits
+    // and metrics for the menu, batch mode and both servers
+    const auto patterns = domain::behaviors::chain::ContentScanner::loadFromFile("config/content_patterns.txt");
+    if (patterns.patternCount == 0)
+        std::fprintf(stderr, "Scanning descriptions for card numbers only (%s)\n", patterns.error.c_str());
+    else if (!patterns.ok)
+        std::fprintf(stderr, "Ignoring invalid content patterns (%s)\n", patterns.error.c_str());
+    domain::behaviors::chain::TicketValidation validation(*customerService, patterns.scanner);
+    const auto rules = validation.getRuleEngine().loadFromFile("config/validation.rules");
+    if (!rules.ok) std::fprintf(stderr, "Using built-in validation rules (%s)\n", rules.error.c_str());
+
+    // NETWORK APIS (JSON over HTTP, binary protocol over a Unix socket)
+    if (serve) {
+        validation.getRuleEngine().startWatching();
+        infrastructure::SupportHttpApi httpApi(customerService, ticketService, facade, validation);
+        infrastructure::HttpServer httpServer(
+            [&httpApi](const infrastructure::HttpRequest& request) { return httpApi.handle(request); },
+            httpOptions);
+        infrastructure::SupportRpcApi rpcApi(customerService, ticketService, validation);
+        infrastructure::RpcServer rpcServer(
+            [&rpcApi](infrastructure::RpcOperation operation, const char* p, const char* end, std::string& out) {
+                return rpcApi.handle(operation, p, end, out);
+            },
+            rpcOptions);
+
+        if (http && !httpServer.start()) {
+            std::fprintf(stderr, "%s\n", httpServer.error().c_str());
+            return 1;
+        }
+        if (rpc && !rpcServer.start()) {
+            std::fprintf(stderr, "%s\n", rpcServer.error().c_str());
+            return 1;
+        }
+        if (http) std::fprintf(stderr, "Serving on http://%s:%u\n", httpOptions.host.c_str(), httpServer.port());
+        if (rpc) std::fprintf(stderr, "Serving on %s\n", rpcServer.path().c_str());
+#if !defined(_WIN32)
+        int signal = 0;
+        sigwait(&stopSignals, &signal);
+#else
+        std::getchar();
+#endif
+        httpServer.stop();
+        rpcServer.stop();
+        for (const auto& [name, stats] : {std::make_pair("http", httpServer.getStats()),
+                                          std::make_pair("rpc", rpcServer.getStats())}) {
+            if (stats.connections == 0) continue;
+            std::fprintf(stderr, "%s: %llu requests on %llu connections\n", name,
+                         static_cast<unsigned long long>(stats.requests),
+                         static_cast<unsigned long long>(stats.connections));
+        }
+        return 0;
+    }
+
     // CLI
-    client::CommandLineInterface cli(customerService, ticketService, facade, notifier);
-    cli.run();
+    client::CommandLineInterface cli(customerService, ticketService, facade, notifier, validation);
+    if (!batch) {
+        cli.run();
+        return 0;
+    }
 
-    return 0;
+    client::BatchSummary summary;
+    if (batchFile == "-") {
+        std::ios::sync_with_stdio(false);
+        summary = cli.runBatch(std::cin, stdout, batchOptions);
+    } else {
+        std::ifstream script(batchFile);
+        if (!script) {
+            std::fprintf(stderr, "Cannot open %s\n", batchFile.c_str());
+            return 2;
+        }
+        summary = cli.runBatch(script, stdout, batchOptions);
+    }
+    return summary.failed == 0 && summary.throttled == 0 ? 0 : 1;
 }